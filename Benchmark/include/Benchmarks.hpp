@@ -0,0 +1,77 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include <xyginext/graphics/RenderHarness.hpp>
+
+#include <cstddef>
+
+/*
+Each benchmark builds a Scene, renders it offscreen with a
+RenderHarness and returns the harness result.
+*/
+namespace Benchmark
+{
+    struct Settings final
+    {
+        std::size_t count = 0; //number of objects
+        std::size_t frameCount = 300;
+        sf::Vector2u size = sf::Vector2u(1280, 720);
+    };
+
+    //quads with a mix of textures and depths, a tenth of which
+    //move each frame. A few are cropped, so have cold data
+    xy::RenderHarness::Result drawables(const Settings&);
+
+    //sprites sharing one set of animations, each playing one of
+    //several animations at different frame rates
+    xy::RenderHarness::Result spriteAnimation(const Settings&);
+
+    //as spriteAnimation but with GPU playback requested, so
+    //the looped animations are played by the instance shader
+    xy::RenderHarness::Result spriteAnimationGPU(const Settings&);
+
+    //HUD style strings of which the last few characters change
+    //every frame, some right aligned and some changing colour
+    xy::RenderHarness::Result text(const Settings&);
+
+    //as text but drawn from a distance field atlas, so
+    //runs of text are merged into a single draw call
+    xy::RenderHarness::Result distanceFieldText(const Settings&);
+
+    //debug overlay style labels drawn with a BitmapFont, a few
+    //of which change every frame while the rest change colour
+    xy::RenderHarness::Result bitmapText(const Settings&);
+
+    //a static tile map on one layer with moving sprites on
+    //the layer above, while the camera pans across the map
+    xy::RenderHarness::Result layers(const Settings&);
+
+    //as layers but with the tile map layer cached
+    xy::RenderHarness::Result cachedLayers(const Settings&);
+}
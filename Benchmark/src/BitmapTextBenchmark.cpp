@@ -0,0 +1,116 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include "Benchmarks.hpp"
+
+#include <xyginext/ecs/Scene.hpp>
+#include <xyginext/ecs/components/Transform.hpp>
+#include <xyginext/ecs/components/Drawable.hpp>
+#include <xyginext/ecs/components/BitmapText.hpp>
+#include <xyginext/ecs/systems/BitmapTextSystem.hpp>
+#include <xyginext/ecs/systems/RenderSystem.hpp>
+#include <xyginext/core/MessageBus.hpp>
+#include <xyginext/graphics/BitmapFont.hpp>
+#include <xyginext/util/Random.hpp>
+
+#include <SFML/Graphics/Image.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr std::uint32_t GlyphSize = 8;
+    constexpr std::size_t UpdateStride = 10;
+}
+
+xy::RenderHarness::Result Benchmark::bitmapText(const Settings& settings)
+{
+    xy::RenderHarness harness(settings.size);
+    if (!harness.isValid())
+    {
+        return {};
+    }
+
+    std::mt19937 rng(1234);
+
+    //10x10 grid of noisy glyphs, as a bitmap font expects
+    sf::Image img;
+    img.create(GlyphSize * 10, GlyphSize * 10, sf::Color::Transparent);
+    for (auto y = 0u; y < img.getSize().y; ++y)
+    {
+        for (auto x = 0u; x < img.getSize().x; ++x)
+        {
+            if (xy::Util::Random::value(0, 1, rng))
+            {
+                img.setPixel(x, y, sf::Color::White);
+            }
+        }
+    }
+    xy::BitmapFont font;
+    font.loadTextureFromImage(img);
+
+    xy::MessageBus mb;
+    xy::Scene scene(mb);
+    scene.addSystem<xy::BitmapTextSystem>(mb);
+    scene.addSystem<xy::RenderSystem>(mb);
+
+    const sf::Vector2f area(settings.size);
+    std::vector<xy::Entity> entities;
+    entities.reserve(settings.count);
+
+    for (auto i = 0u; i < settings.count; ++i)
+    {
+        auto entity = scene.createEntity();
+        entity.addComponent<xy::Transform>().setPosition(
+            xy::Util::Random::value(0.f, area.x - 100.f, rng),
+            xy::Util::Random::value(0.f, area.y - GlyphSize, rng));
+        entity.addComponent<xy::Drawable>();
+        entity.addComponent<xy::BitmapText>(font).setString("Entity " + std::to_string(i));
+        entities.push_back(entity);
+    }
+
+    return harness.run(scene, mb, settings.frameCount,
+        [&](std::size_t frame, xy::Scene&)
+        {
+            //a tenth of the labels show a changing value,
+            //the rest only change colour now and then
+            for (auto i = 0u; i < entities.size(); ++i)
+            {
+                auto& text = entities[i].getComponent<xy::BitmapText>();
+                if (i % UpdateStride == 0)
+                {
+                    text.setString("Position: " + std::to_string(frame) + ", " + std::to_string(i));
+                }
+                else
+                {
+                    text.setColour((frame % 60 < 30) ? sf::Color::White : sf::Color::Green);
+                }
+            }
+        });
+}
@@ -0,0 +1,123 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include "Benchmarks.hpp"
+
+#include <xyginext/ecs/Scene.hpp>
+#include <xyginext/ecs/components/Transform.hpp>
+#include <xyginext/ecs/components/Drawable.hpp>
+#include <xyginext/ecs/systems/RenderSystem.hpp>
+#include <xyginext/core/MessageBus.hpp>
+#include <xyginext/util/Random.hpp>
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+#include <array>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr float QuadSize = 16.f;
+    constexpr std::size_t TextureCount = 4;
+    constexpr std::size_t MovingStride = 10;
+    constexpr std::size_t CroppedStride = 100;
+}
+
+xy::RenderHarness::Result Benchmark::drawables(const Settings& settings)
+{
+    //the harness owns the context so must be created first
+    xy::RenderHarness harness(settings.size);
+    if (!harness.isValid())
+    {
+        return {};
+    }
+
+    //fixed seed so each run draws the same scene
+    std::mt19937 rng(1234);
+
+    const std::array<sf::Color, TextureCount> colours =
+    {
+        sf::Color::Red, sf::Color::Green, sf::Color::Blue, sf::Color::Yellow
+    };
+    std::array<sf::Texture, TextureCount> textures;
+    for (auto i = 0u; i < TextureCount; ++i)
+    {
+        sf::Image img;
+        img.create(static_cast<unsigned>(QuadSize), static_cast<unsigned>(QuadSize), colours[i]);
+        textures[i].loadFromImage(img);
+    }
+
+    xy::MessageBus mb;
+    xy::Scene scene(mb);
+    scene.addSystem<xy::RenderSystem>(mb);
+
+    const auto count = settings.count;
+    const sf::Vector2f area(settings.size);
+
+    std::vector<xy::Entity> movingEntities;
+    movingEntities.reserve(count / MovingStride + 1);
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        auto entity = scene.createEntity();
+        entity.addComponent<xy::Transform>().setPosition(
+            xy::Util::Random::value(0.f, area.x - QuadSize, rng),
+            xy::Util::Random::value(0.f, area.y - QuadSize, rng));
+
+        auto& drawable = entity.addComponent<xy::Drawable>(textures[i % TextureCount]);
+        drawable.setDepth(xy::Util::Random::value(-8, 8, rng));
+
+        auto& verts = drawable.getVertices();
+        verts.emplace_back(sf::Vector2f(), sf::Vector2f());
+        verts.emplace_back(sf::Vector2f(0.f, QuadSize), sf::Vector2f(0.f, QuadSize));
+        verts.emplace_back(sf::Vector2f(QuadSize, QuadSize), sf::Vector2f(QuadSize, QuadSize));
+        verts.emplace_back(sf::Vector2f(QuadSize, 0.f), sf::Vector2f(QuadSize, 0.f));
+        drawable.updateLocalBounds();
+
+        if (i % CroppedStride == 0)
+        {
+            drawable.setCroppingArea({ 0.f, 0.f, QuadSize / 2.f, QuadSize });
+        }
+
+        if (i % MovingStride == 0)
+        {
+            movingEntities.push_back(entity);
+        }
+    }
+
+    return harness.run(scene, mb, settings.frameCount,
+        [&](std::size_t frame, xy::Scene&)
+        {
+            const float direction = (frame / 60) % 2 ? -1.f : 1.f;
+            for (auto entity : movingEntities)
+            {
+                entity.getComponent<xy::Transform>().move(direction, 0.f);
+            }
+        });
+}
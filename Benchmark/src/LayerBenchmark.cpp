@@ -0,0 +1,164 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include "Benchmarks.hpp"
+
+#include <xyginext/ecs/Scene.hpp>
+#include <xyginext/ecs/components/Transform.hpp>
+#include <xyginext/ecs/components/Drawable.hpp>
+#include <xyginext/ecs/systems/RenderSystem.hpp>
+#include <xyginext/ecs/systems/CameraSystem.hpp>
+#include <xyginext/core/MessageBus.hpp>
+#include <xyginext/util/Random.hpp>
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+#include <array>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr float TileSize = 32.f;
+    constexpr std::size_t MapWidth = 200; //in tiles
+    constexpr std::size_t TextureCount = 4;
+    constexpr std::size_t SpriteCount = 500;
+    constexpr float CameraSpeed = 4.f;
+
+    enum Layer
+    {
+        Background, Foreground
+    };
+
+    void addQuad(xy::Drawable& drawable, sf::Color colour = sf::Color::White)
+    {
+        auto& verts = drawable.getVertices();
+        verts.emplace_back(sf::Vector2f(), colour, sf::Vector2f());
+        verts.emplace_back(sf::Vector2f(0.f, TileSize), colour, sf::Vector2f(0.f, TileSize));
+        verts.emplace_back(sf::Vector2f(TileSize, TileSize), colour, sf::Vector2f(TileSize, TileSize));
+        verts.emplace_back(sf::Vector2f(TileSize, 0.f), colour, sf::Vector2f(TileSize, 0.f));
+        drawable.updateLocalBounds();
+    }
+
+    xy::RenderHarness::Result run(const Benchmark::Settings& settings, bool cached)
+    {
+        xy::RenderHarness harness(settings.size);
+        if (!harness.isValid())
+        {
+            return {};
+        }
+
+        std::mt19937 rng(1234);
+
+        const std::array<sf::Color, TextureCount> colours =
+        {
+            sf::Color(40, 120, 40), sf::Color(60, 140, 60), sf::Color(120, 100, 60), sf::Color(40, 80, 160)
+        };
+        std::array<sf::Texture, TextureCount> textures;
+        for (auto i = 0u; i < TextureCount; ++i)
+        {
+            sf::Image img;
+            img.create(static_cast<unsigned>(TileSize), static_cast<unsigned>(TileSize), colours[i]);
+            textures[i].loadFromImage(img);
+        }
+
+        xy::MessageBus mb;
+        xy::Scene scene(mb);
+        scene.addSystem<xy::CameraSystem>(mb);
+        auto& renderSystem = scene.addSystem<xy::RenderSystem>(mb);
+        renderSystem.setLayerCached(Background, cached);
+
+        //a tile map with a few decorations on top of the ground
+        //tiles, all of which are static
+        for (auto i = 0u; i < settings.count; ++i)
+        {
+            auto entity = scene.createEntity();
+            entity.addComponent<xy::Transform>().setPosition(
+                static_cast<float>(i % MapWidth) * TileSize,
+                static_cast<float>(i / MapWidth) * TileSize);
+
+            auto& drawable = entity.addComponent<xy::Drawable>(textures[xy::Util::Random::value(0, 2, rng)]);
+            drawable.setLayer(Background);
+            drawable.setStatic(true);
+            addQuad(drawable);
+
+            if (i % 7 == 0)
+            {
+                auto decoration = scene.createEntity();
+                decoration.addComponent<xy::Transform>().setPosition(entity.getComponent<xy::Transform>().getPosition());
+                decoration.getComponent<xy::Transform>().setScale(0.5f, 0.5f);
+
+                auto& decorationDrawable = decoration.addComponent<xy::Drawable>(textures[3]);
+                decorationDrawable.setLayer(Background);
+                decorationDrawable.setDepth(1);
+                decorationDrawable.setStatic(true);
+                addQuad(decorationDrawable);
+            }
+        }
+
+        const sf::Vector2f mapSize(MapWidth * TileSize, static_cast<float>(settings.count / MapWidth + 1) * TileSize);
+
+        std::vector<xy::Entity> sprites;
+        for (auto i = 0u; i < SpriteCount; ++i)
+        {
+            auto entity = scene.createEntity();
+            entity.addComponent<xy::Transform>().setPosition(
+                xy::Util::Random::value(0.f, mapSize.x, rng),
+                xy::Util::Random::value(0.f, mapSize.y, rng));
+
+            auto& drawable = entity.addComponent<xy::Drawable>(textures[3]);
+            drawable.setLayer(Foreground);
+            addQuad(drawable, sf::Color::Red);
+            sprites.push_back(entity);
+        }
+
+        return harness.run(scene, mb, settings.frameCount,
+            [&](std::size_t frame, xy::Scene& s)
+            {
+                //pans back and forth, crossing a tile of the layer
+                //cache every 128 frames, while the sprites move
+                const float direction = (frame / 240) % 2 ? -1.f : 1.f;
+                s.getActiveCamera().getComponent<xy::Transform>().move(direction * CameraSpeed, 0.f);
+
+                for (auto entity : sprites)
+                {
+                    entity.getComponent<xy::Transform>().move(0.f, direction);
+                }
+            });
+    }
+}
+
+xy::RenderHarness::Result Benchmark::layers(const Settings& settings)
+{
+    return run(settings, false);
+}
+
+xy::RenderHarness::Result Benchmark::cachedLayers(const Settings& settings)
+{
+    return run(settings, true);
+}
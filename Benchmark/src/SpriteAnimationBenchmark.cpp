@@ -0,0 +1,137 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include "Benchmarks.hpp"
+
+#include <xyginext/ecs/Scene.hpp>
+#include <xyginext/ecs/components/Transform.hpp>
+#include <xyginext/ecs/components/Drawable.hpp>
+#include <xyginext/ecs/components/Sprite.hpp>
+#include <xyginext/ecs/components/SpriteAnimation.hpp>
+#include <xyginext/ecs/systems/SpriteAnimator.hpp>
+#include <xyginext/ecs/systems/SpriteSystem.hpp>
+#include <xyginext/ecs/systems/RenderSystem.hpp>
+#include <xyginext/core/MessageBus.hpp>
+#include <xyginext/util/Random.hpp>
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr float FrameSize = 16.f;
+    constexpr std::size_t FrameCount = 8;
+    constexpr std::size_t AnimationCount = 4;
+
+    xy::RenderHarness::Result run(const Benchmark::Settings& settings, xy::SpriteAnimation::Playback playback)
+    {
+        xy::RenderHarness harness(settings.size);
+        if (!harness.isValid())
+        {
+            return {};
+        }
+
+        std::mt19937 rng(1234);
+
+        //one row of frames per animation
+        sf::Image img;
+        img.create(static_cast<unsigned>(FrameSize * FrameCount), static_cast<unsigned>(FrameSize * AnimationCount), sf::Color::White);
+        sf::Texture texture;
+        texture.loadFromImage(img);
+
+        //every sprite shares the same animation data, as if loaded from a SpriteSheet
+        xy::Sprite sprite(texture);
+        sprite.setTextureRect({ 0.f, 0.f, FrameSize, FrameSize });
+
+        std::vector<xy::Sprite::Animation> animations(AnimationCount);
+        for (auto i = 0u; i < AnimationCount; ++i)
+        {
+            auto& anim = animations[i];
+            for (auto j = 0u; j < FrameCount; ++j)
+            {
+                anim.frames.emplace_back(j * FrameSize, i * FrameSize, FrameSize, FrameSize);
+            }
+            anim.framerate = 8.f + (4.f * i);
+            anim.looped = (i % 2) == 0;
+        }
+        sprite.setAnimations(std::move(animations));
+
+        xy::MessageBus mb;
+        xy::Scene scene(mb);
+        scene.addSystem<xy::SpriteAnimator>(mb);
+        scene.addSystem<xy::SpriteSystem>(mb);
+        scene.addSystem<xy::RenderSystem>(mb);
+
+        const sf::Vector2f area(settings.size);
+        std::vector<xy::Entity> entities;
+        entities.reserve(settings.count);
+
+        for (auto i = 0u; i < settings.count; ++i)
+        {
+            auto entity = scene.createEntity();
+            entity.addComponent<xy::Transform>().setPosition(
+                xy::Util::Random::value(0.f, area.x - FrameSize, rng),
+                xy::Util::Random::value(0.f, area.y - FrameSize, rng));
+            entity.addComponent<xy::Drawable>();
+            entity.addComponent<xy::Sprite>() = sprite;
+            auto& animation = entity.addComponent<xy::SpriteAnimation>();
+            animation.setPlayback(playback);
+            animation.play(i % AnimationCount);
+            entities.push_back(entity);
+        }
+
+        return harness.run(scene, mb, settings.frameCount,
+            [&](std::size_t frame, xy::Scene&)
+            {
+                //restart the animations which don't loop
+                if (frame % 60 == 0)
+                {
+                    for (auto entity : entities)
+                    {
+                        auto& animation = entity.getComponent<xy::SpriteAnimation>();
+                        if (animation.stopped())
+                        {
+                            animation.play(animation.getAnimationIndex(), true);
+                        }
+                    }
+                }
+            });
+    }
+}
+
+xy::RenderHarness::Result Benchmark::spriteAnimation(const Settings& settings)
+{
+    return run(settings, xy::SpriteAnimation::Playback::CPU);
+}
+
+xy::RenderHarness::Result Benchmark::spriteAnimationGPU(const Settings& settings)
+{
+    return run(settings, xy::SpriteAnimation::Playback::GPU);
+}
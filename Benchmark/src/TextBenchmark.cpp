@@ -0,0 +1,121 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include "Benchmarks.hpp"
+
+#include <xyginext/ecs/Scene.hpp>
+#include <xyginext/ecs/components/Transform.hpp>
+#include <xyginext/ecs/components/Drawable.hpp>
+#include <xyginext/ecs/components/Text.hpp>
+#include <xyginext/ecs/systems/TextSystem.hpp>
+#include <xyginext/ecs/systems/RenderSystem.hpp>
+#include <xyginext/core/MessageBus.hpp>
+#include <xyginext/resources/Resource.hpp>
+#include <xyginext/util/Random.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t ColourStride = 4;
+
+    xy::RenderHarness::Result run(const Benchmark::Settings& settings, xy::Text::Mode mode)
+    {
+        xy::RenderHarness harness(settings.size);
+        if (!harness.isValid())
+        {
+            return {};
+        }
+
+        std::mt19937 rng(1234);
+
+        //falls back to the system font
+        xy::FontResource fonts;
+        const auto& font = fonts.get("");
+
+        xy::MessageBus mb;
+        xy::Scene scene(mb);
+        scene.addSystem<xy::TextSystem>(mb);
+        scene.addSystem<xy::RenderSystem>(mb);
+
+        const sf::Vector2f area(settings.size);
+        std::vector<xy::Entity> entities;
+        entities.reserve(settings.count);
+
+        for (auto i = 0u; i < settings.count; ++i)
+        {
+            auto entity = scene.createEntity();
+            entity.addComponent<xy::Transform>().setPosition(
+                xy::Util::Random::value(0.f, area.x - 100.f, rng),
+                xy::Util::Random::value(0.f, area.y - 20.f, rng));
+            entity.addComponent<xy::Drawable>();
+
+            auto& text = entity.addComponent<xy::Text>(font);
+            text.setCharacterSize(16);
+            text.setMode(mode);
+            if (i % 2)
+            {
+                text.setAlignment(xy::Text::Alignment::Right);
+            }
+            entities.push_back(entity);
+        }
+
+        return harness.run(scene, mb, settings.frameCount,
+            [&](std::size_t frame, xy::Scene&)
+            {
+                for (auto i = 0u; i < entities.size(); ++i)
+                {
+                    auto& text = entities[i].getComponent<xy::Text>();
+                    if (i % 2)
+                    {
+                        text.setString("Time: " + std::to_string(frame / 60) + ":" + std::to_string(frame % 60));
+                    }
+                    else
+                    {
+                        text.setString("Score: " + std::to_string((frame * 10) + i));
+                    }
+
+                    if (i % ColourStride == 0)
+                    {
+                        text.setFillColour((frame % 30 < 15) ? sf::Color::White : sf::Color::Yellow);
+                    }
+                }
+            });
+    }
+}
+
+xy::RenderHarness::Result Benchmark::text(const Settings& settings)
+{
+    return run(settings, xy::Text::Mode::Bitmap);
+}
+
+xy::RenderHarness::Result Benchmark::distanceFieldText(const Settings& settings)
+{
+    return run(settings, xy::Text::Mode::DistanceField);
+}
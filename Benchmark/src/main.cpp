@@ -0,0 +1,131 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include "Benchmarks.hpp"
+
+#include <xyginext/ecs/components/Drawable.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+/*
+Usage: xy_benchmark [name] [count] [frames]
+
+Runs the named benchmark, or all of them if no name is given, and
+prints the average frame times. The GPU times require GL_ARB_timer_query.
+Results are only comparable between runs on the same machine and build.
+*/
+
+namespace
+{
+    struct Entry final
+    {
+        const char* name = nullptr;
+        xy::RenderHarness::Result(*func)(const Benchmark::Settings&) = nullptr;
+        std::size_t defaultCount = 0;
+    };
+
+    const Entry benchmarks[] =
+    {
+        { "drawables", &Benchmark::drawables, 50000 },
+        { "sprite_animation", &Benchmark::spriteAnimation, 20000 },
+        { "sprite_animation_gpu", &Benchmark::spriteAnimationGPU, 20000 },
+        { "text", &Benchmark::text, 2000 },
+        { "text_sdf", &Benchmark::distanceFieldText, 2000 },
+        { "bitmap_text", &Benchmark::bitmapText, 500 },
+        { "layers", &Benchmark::layers, 20000 },
+        { "layers_cached", &Benchmark::cachedLayers, 20000 }
+    };
+
+    void printResult(const char* name, const Benchmark::Settings& settings, const xy::RenderHarness::Result& result)
+    {
+        std::cout << name << " (" << settings.count << " objects, " << result.frameCount << " frames)\n";
+        if (result.frameCount == 0)
+        {
+            std::cout << "    failed to run\n";
+            return;
+        }
+
+        std::cout << "    CPU: " << result.cpuFrameTime << "ms/frame\n";
+        if (result.gpuFrameTime < 0.f)
+        {
+            std::cout << "    GPU: unavailable\n";
+        }
+        else
+        {
+            std::cout << "    GPU: " << result.gpuFrameTime << "ms/frame\n";
+            for (const auto& pass : result.passTimes)
+            {
+                std::cout << "        " << pass.name << ": " << pass.gpuTime << "ms\n";
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const char* name = argc > 1 ? argv[1] : nullptr;
+
+    std::size_t count = 0;
+    Benchmark::Settings settings;
+    if (argc > 2)
+    {
+        count = std::strtoul(argv[2], nullptr, 10);
+    }
+
+    if (argc > 3)
+    {
+        settings.frameCount = std::strtoul(argv[3], nullptr, 10);
+    }
+
+    std::cout << "sizeof(xy::Drawable): " << sizeof(xy::Drawable) << " bytes\n";
+
+    bool found = false;
+    for (const auto& benchmark : benchmarks)
+    {
+        if (!name || std::strcmp(name, benchmark.name) == 0)
+        {
+            settings.count = count ? count : benchmark.defaultCount;
+            printResult(benchmark.name, settings, benchmark.func(settings));
+            found = true;
+        }
+    }
+
+    if (!found)
+    {
+        std::cout << "Unknown benchmark " << name << ", available benchmarks are:\n";
+        for (const auto& benchmark : benchmarks)
+        {
+            std::cout << "    " << benchmark.name << "\n";
+        }
+        return EXIT_FAILURE;
+    }
+
+    return 0;
+}
@@ -0,0 +1,160 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include <xyginext/ecs/Scene.hpp>
+#include <xyginext/ecs/components/Transform.hpp>
+#include <xyginext/ecs/components/Drawable.hpp>
+#include <xyginext/ecs/systems/RenderSystem.hpp>
+#include <xyginext/graphics/RenderHarness.hpp>
+#include <xyginext/core/MessageBus.hpp>
+#include <xyginext/Config.hpp>
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+/*
+Usage: xy_render_test <golden directory> [--update]
+
+Renders a reference scene with a RenderHarness and compares frames
+against the golden images in the given directory. Returns SkipCode if
+no GL context could be created, eg when running without a display.
+Pass --update to overwrite the golden images with the current output.
+
+The scene is drawn with the default camera onto a target a tenth of
+DefaultSceneSize, and every quad edge lies on a pixel boundary, so the
+expected output does not depend on the driver's rasterisation rules.
+*/
+
+namespace
+{
+    constexpr int SkipCode = 77;
+    const sf::Vector2u TargetSize(192, 108);
+
+    enum Layer
+    {
+        Background, Foreground
+    };
+
+    void addQuad(xy::Drawable& drawable, sf::Vector2f size, sf::Color colour, sf::Vector2f textureSize = {})
+    {
+        auto& verts = drawable.getVertices();
+        verts.emplace_back(sf::Vector2f(), colour, sf::Vector2f());
+        verts.emplace_back(sf::Vector2f(0.f, size.y), colour, sf::Vector2f(0.f, textureSize.y));
+        verts.emplace_back(size, colour, textureSize);
+        verts.emplace_back(sf::Vector2f(size.x, 0.f), colour, sf::Vector2f(textureSize.x, 0.f));
+        drawable.updateLocalBounds();
+    }
+
+    xy::Entity addEntity(xy::Scene& scene, sf::Vector2f position, Layer layer, std::int32_t depth)
+    {
+        auto entity = scene.createEntity();
+        entity.addComponent<xy::Transform>().setPosition(position);
+        auto& drawable = entity.addComponent<xy::Drawable>();
+        drawable.setLayer(layer);
+        drawable.setDepth(depth);
+        return entity;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "Usage: xy_render_test <golden directory> [--update]\n";
+        return EXIT_FAILURE;
+    }
+    const std::string goldenDir = std::string(argv[1]) + "/";
+
+    xy::RenderHarness harness(TargetSize);
+    if (!harness.isValid())
+    {
+        std::cout << "No GL context available, skipping render tests\n";
+        return SkipCode;
+    }
+    harness.setUpdateGoldenImages(argc > 2 && std::strcmp(argv[2], "--update") == 0);
+
+    //the first frame, then after the moving quad has been
+    //re-sorted above another drawable on the same layer
+    harness.addGoldenImage(0, goldenDir + "quads_0.png");
+    harness.addGoldenImage(9, goldenDir + "quads_9.png");
+
+    //a 2x2 checker, drawn with nearest filtering so each texel
+    //covers a whole number of pixels
+    sf::Image checker;
+    checker.create(2, 2, sf::Color::Yellow);
+    checker.setPixel(1, 0, sf::Color::Magenta);
+    checker.setPixel(0, 1, sf::Color::Magenta);
+    sf::Texture texture;
+    texture.loadFromImage(checker);
+
+    xy::MessageBus mb;
+    xy::Scene scene(mb);
+    scene.addSystem<xy::RenderSystem>(mb);
+
+    //depth orders the drawables within a layer...
+    auto entity = addEntity(scene, { 0.f, 0.f }, Background, -10);
+    addQuad(entity.getComponent<xy::Drawable>(), xy::DefaultSceneSize, sf::Color(32, 32, 48));
+
+    entity = addEntity(scene, { 200.f, 200.f }, Background, 0);
+    addQuad(entity.getComponent<xy::Drawable>(), { 600.f, 400.f }, sf::Color::Red);
+
+    entity = addEntity(scene, { 600.f, 400.f }, Background, 1);
+    addQuad(entity.getComponent<xy::Drawable>(), { 600.f, 400.f }, sf::Color::Green);
+
+    //...but a higher layer is always on top
+    entity = addEntity(scene, { 1000.f, 200.f }, Foreground, -5);
+    addQuad(entity.getComponent<xy::Drawable>(), { 400.f, 600.f }, sf::Color::Blue);
+
+    entity = addEntity(scene, { 1400.f, 600.f }, Background, 0);
+    entity.getComponent<xy::Drawable>().setTexture(&texture);
+    addQuad(entity.getComponent<xy::Drawable>(), { 400.f, 400.f }, sf::Color::White, { 2.f, 2.f });
+
+    auto mover = addEntity(scene, { 200.f, 700.f }, Background, 2);
+    addQuad(mover.getComponent<xy::Drawable>(), { 200.f, 200.f }, sf::Color::White);
+
+    auto result = harness.run(scene, mb, 10,
+        [mover](std::size_t frame, xy::Scene&) mutable
+        {
+            if (frame == 5)
+            {
+                mover.getComponent<xy::Transform>().setPosition(600.f, 700.f);
+            }
+        });
+
+    for (auto frame : result.failedFrames)
+    {
+        std::cout << "Frame " << frame << " does not match its golden image\n";
+    }
+
+    std::cout << "Render tests " << (result.passed ? "passed" : "failed") << "\n";
+    return result.passed ? 0 : EXIT_FAILURE;
+}
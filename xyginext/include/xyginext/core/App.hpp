@@ -44,10 +44,14 @@ The older revision of xygine can be found <a href="https://github.com/fallahn/xy
 #include "xyginext/core/MessageBus.hpp"
 #include "xyginext/Config.hpp"
 #include "xyginext/audio/Mixer.hpp"
+#include "xyginext/graphics/FrameCapture.hpp"
 
 #include <SFML/Graphics/RenderWindow.hpp>
 
 #include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #ifdef XY_DEBUG
 #define DPRINT(x, y) xy::App::printStat(x,y)
@@ -280,6 +284,91 @@ namespace xy
         */
         static const sf::Cursor& getDefaultCursor();
 
+        /*!
+        \brief Enables or disables pipelined rendering.
+        When enabled draw() is called on a dedicated render thread, drawing
+        frame N while the next update is performed on the main thread.
+        Systems which support this, such as the RenderSystem and ParticleSystem,
+        write a snapshot of their render data at the end of each update which
+        is double buffered so that it can be safely read by the render thread.
+        This means that anything drawn in draw() or State::draw() must only read
+        data from these snapshots - drawing any objects which are modified
+        during update, such as sf::Sprites or sf::Text owned by a State, is
+        undefined behaviour. ImGui windows are still built on the main thread.
+        The change is applied at the beginning of the next frame, and by default
+        pipelined rendering is disabled.
+        */
+        static void setRenderThreadEnabled(bool);
+
+        /*!
+        \brief Returns true if pipelined rendering is currently active
+        \see setRenderThreadEnabled()
+        */
+        static bool isRenderThreadEnabled();
+
+        /*!
+        \brief Returns the index (0 or 1) of the render snapshot which
+        systems should write to during update.
+        \see setRenderThreadEnabled()
+        */
+        static std::size_t getSnapshotWriteIndex();
+
+        /*!
+        \brief Returns the index (0 or 1) of the render snapshot which
+        should be read when drawing. This is the same as the write
+        index when pipelined rendering is disabled.
+        \see setRenderThreadEnabled()
+        */
+        static std::size_t getSnapshotReadIndex();
+
+        /*!
+        \brief Blocks until the render thread has finished drawing the
+        current frame, if pipelined rendering is active.
+        Anything read by draw() which isn't double buffered must only be
+        modified after calling this, for example when adding systems or
+        post processes to a Scene. States are pushed and popped only once
+        the render thread is idle, and the Scene functions which modify
+        its draw data call this themselves. Returns immediately when
+        pipelined rendering is disabled.
+        \see setRenderThreadEnabled()
+        */
+        static void syncRenderThread();
+
+        /*!
+        \brief OpenGL code paths available to xygine's built in renderers
+        */
+        enum class RenderBackend
+        {
+            Legacy, //!< fixed function vertex arrays and GLSL 120
+            Core    //!< VAOs, streamed VBOs, uniform buffers and GLSL 330
+        };
+
+        /*!
+        \brief Requests the OpenGL path used by the ParticleSystem and the
+        built in post process effects.
+        The Core backend uses only OpenGL 3.3 core profile functionality, and
+        requires that the App is created with ContextSettings requesting at
+        least version 3.3. As SFML itself requires a compatibility context,
+        the ContextSettings attribute flags should remain Default. If the
+        context doesn't support it the Legacy path is used instead.
+        Defaults to Legacy.
+        */
+        static void setRenderBackend(RenderBackend);
+
+        /*!
+        \brief Returns the backend currently in use. This may differ
+        from the requested backend if it is unsupported by the context.
+        */
+        static RenderBackend getRenderBackend();
+
+        /*!
+        \brief Returns the FrameCapture instance which captures the window.
+        Use this to start or stop recording frame sequences, or to save
+        screenshots to a specific path. Pressing F5 saves a screenshot
+        to the working directory.
+        */
+        static FrameCapture& getFrameCapture();
+
     protected:
         /*!
         \brief Function for despatching all window events
@@ -358,8 +447,20 @@ namespace xy
         static bool m_mouseCursorVisible;
         sf::Cursor m_defaultCursor;
 
+        FrameCapture m_frameCapture;
         void saveScreenshot();
 
+        std::thread m_renderThread;
+        std::mutex m_renderMutex;
+        std::condition_variable m_renderCondition;
+        bool m_renderPending;
+        bool m_renderThreadQuit;
+
+        void updateRenderThread(bool);
+        void waitForRenderThread();
+        void renderLoop();
+        void renderFrame();
+
         void handleEvents();
         void handleMessages();
 
@@ -0,0 +1,145 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace xy
+{
+    /*!
+    \brief Contiguous array which stores up to N elements inline, only
+    allocating memory on the heap when more than N elements are added.
+    The interface is a subset of std::vector's, so that small arrays such
+    as the vertices of a sprite can be created without any allocations.
+    Once memory has been allocated it is kept until shrink_to_fit() is
+    called, so arrays which regularly change size, such as those of Text
+    components, don't repeatedly reallocate.
+    Only trivially copyable types, such as sf::Vertex, are supported.
+    */
+    template <typename T, std::size_t N>
+    class SmallVector final
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+        static_assert(N > 0, "Inline capacity must be at least 1");
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        SmallVector() = default;
+        SmallVector(std::initializer_list<T>);
+        ~SmallVector() = default;
+
+        SmallVector(const SmallVector&);
+        SmallVector& operator = (const SmallVector&);
+
+        SmallVector(SmallVector&&) noexcept;
+        SmallVector& operator = (SmallVector&&) noexcept;
+
+        SmallVector& operator = (std::initializer_list<T>);
+
+        T* data() { return m_heap ? m_heap.get() : m_local.data(); }
+        const T* data() const { return m_heap ? m_heap.get() : m_local.data(); }
+
+        size_type size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        /*!
+        \brief Returns the number of elements which can be stored without reallocating
+        */
+        size_type capacity() const { return m_heap ? m_capacity : N; }
+
+        /*!
+        \brief Returns true if the elements are stored inline, rather than on the heap
+        */
+        bool isInline() const { return !m_heap; }
+
+        static constexpr size_type inlineCapacity() { return N; }
+
+        iterator begin() { return data(); }
+        iterator end() { return data() + m_size; }
+        const_iterator begin() const { return data(); }
+        const_iterator end() const { return data() + m_size; }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+
+        T& operator [] (size_type i) { return data()[i]; }
+        const T& operator [] (size_type i) const { return data()[i]; }
+
+        T& front() { return data()[0]; }
+        const T& front() const { return data()[0]; }
+        T& back() { return data()[m_size - 1]; }
+        const T& back() const { return data()[m_size - 1]; }
+
+        void reserve(size_type);
+        void resize(size_type);
+        void resize(size_type, const T&);
+        void clear() { m_size = 0; }
+
+        void push_back(const T&);
+
+        template <typename... Args>
+        T& emplace_back(Args&&...);
+
+        void pop_back() { m_size--; }
+
+        /*!
+        \brief Appends the elements in the range [first, last)
+        */
+        template <typename Itr>
+        void append(Itr first, Itr last);
+
+        /*!
+        \brief Releases any heap memory not required by the current
+        size, returning the elements to inline storage if they fit
+        */
+        void shrink_to_fit();
+
+    private:
+        std::unique_ptr<T[]> m_heap;
+        std::uint32_t m_size = 0;
+        std::uint32_t m_capacity = 0; //of m_heap
+        std::array<T, N> m_local = {};
+
+        void grow(size_type minCapacity);
+        void reallocate(size_type capacity);
+    };
+
+#include "SmallVector.inl"
+}
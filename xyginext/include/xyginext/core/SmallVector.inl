@@ -0,0 +1,181 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+template <typename T, std::size_t N>
+SmallVector<T, N>::SmallVector(std::initializer_list<T> values)
+{
+    append(values.begin(), values.end());
+}
+
+template <typename T, std::size_t N>
+SmallVector<T, N>::SmallVector(const SmallVector& other)
+{
+    append(other.begin(), other.end());
+}
+
+template <typename T, std::size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(const SmallVector& other)
+{
+    if (&other != this)
+    {
+        clear();
+        append(other.begin(), other.end());
+    }
+    return *this;
+}
+
+template <typename T, std::size_t N>
+SmallVector<T, N>::SmallVector(SmallVector&& other) noexcept
+    : m_heap    (std::move(other.m_heap)),
+    m_size      (other.m_size),
+    m_capacity  (other.m_capacity),
+    m_local     (other.m_local)
+{
+    other.m_size = 0;
+    other.m_capacity = 0;
+}
+
+template <typename T, std::size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(SmallVector&& other) noexcept
+{
+    if (&other != this)
+    {
+        m_heap = std::move(other.m_heap);
+        m_size = other.m_size;
+        m_capacity = other.m_capacity;
+        m_local = other.m_local;
+
+        other.m_size = 0;
+        other.m_capacity = 0;
+    }
+    return *this;
+}
+
+template <typename T, std::size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(std::initializer_list<T> values)
+{
+    clear();
+    append(values.begin(), values.end());
+    return *this;
+}
+
+template <typename T, std::size_t N>
+void SmallVector<T, N>::reserve(size_type count)
+{
+    if (count > capacity())
+    {
+        reallocate(count);
+    }
+}
+
+template <typename T, std::size_t N>
+void SmallVector<T, N>::resize(size_type count)
+{
+    resize(count, T());
+}
+
+template <typename T, std::size_t N>
+void SmallVector<T, N>::resize(size_type count, const T& value)
+{
+    if (count > m_size)
+    {
+        //copied in case value is one of our own elements
+        const T v = value;
+        grow(count);
+        std::fill(data() + m_size, data() + count, v);
+    }
+    m_size = static_cast<std::uint32_t>(count);
+}
+
+template <typename T, std::size_t N>
+void SmallVector<T, N>::push_back(const T& value)
+{
+    const T v = value;
+    grow(m_size + 1);
+    data()[m_size++] = v;
+}
+
+template <typename T, std::size_t N>
+template <typename... Args>
+T& SmallVector<T, N>::emplace_back(Args&&... args)
+{
+    const T v(std::forward<Args>(args)...);
+    grow(m_size + 1);
+    auto& element = data()[m_size++];
+    element = v;
+    return element;
+}
+
+template <typename T, std::size_t N>
+template <typename Itr>
+void SmallVector<T, N>::append(Itr first, Itr last)
+{
+    const auto count = static_cast<size_type>(std::distance(first, last));
+    grow(m_size + count);
+    std::copy(first, last, data() + m_size);
+    m_size += static_cast<std::uint32_t>(count);
+}
+
+template <typename T, std::size_t N>
+void SmallVector<T, N>::shrink_to_fit()
+{
+    if (!m_heap)
+    {
+        return;
+    }
+
+    if (m_size <= N)
+    {
+        std::copy(m_heap.get(), m_heap.get() + m_size, m_local.data());
+        m_heap.reset();
+        m_capacity = 0;
+    }
+    else if (m_size < m_capacity)
+    {
+        reallocate(m_size);
+    }
+}
+
+//private
+template <typename T, std::size_t N>
+void SmallVector<T, N>::grow(size_type minCapacity)
+{
+    const auto current = capacity();
+    if (minCapacity > current)
+    {
+        reallocate(std::max(minCapacity, current * 2));
+    }
+}
+
+template <typename T, std::size_t N>
+void SmallVector<T, N>::reallocate(size_type newCapacity)
+{
+    auto heap = std::make_unique<T[]>(newCapacity);
+    std::copy(begin(), end(), heap.get());
+    m_heap = std::move(heap);
+    m_capacity = static_cast<std::uint32_t>(newCapacity);
+}
@@ -0,0 +1,73 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace xy
+{
+    class SpriteAnimator;
+}
+
+namespace xy::Detail
+{
+    /*!
+    \brief Used by the Sprite and SpriteAnimation components to queue
+    their entity with the SpriteAnimator when they are modified, so that
+    the animator only reads back the components which have changed.
+    The hook belongs to the entity, rather than the component's value,
+    so assigning one component to another keeps the hook of the
+    destination and queues that entity instead.
+    */
+    class AnimatorHook final
+    {
+    public:
+        AnimatorHook() = default;
+        AnimatorHook(const AnimatorHook&) = default;
+        AnimatorHook& operator = (const AnimatorHook&) { markDirty(); return *this; }
+
+        void markDirty()
+        {
+            if (m_dirtyList && !m_queued)
+            {
+                m_dirtyList->push_back(m_entityIndex);
+                m_queued = true;
+            }
+        }
+
+    private:
+        //shared so that components outliving the animator never write to freed memory
+        std::shared_ptr<std::vector<std::uint32_t>> m_dirtyList;
+        std::uint32_t m_entityIndex = 0;
+        bool m_queued = false;
+
+        friend class xy::SpriteAnimator;
+    };
+}
@@ -0,0 +1,211 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include "xyginext/Config.hpp"
+#include "xyginext/ecs/Entity.hpp"
+#include "xyginext/core/Assert.hpp"
+
+#include <SFML/Graphics/Rect.hpp>
+
+#include <vector>
+#include <cstdint>
+#include <array>
+
+namespace xy
+{
+    //node struct used by the tree
+    struct TreeNode final
+    {
+        static constexpr std::int32_t Null = -1;
+        bool isLeaf() const
+        {
+            return childA == Null;
+        }
+
+        //this is in world coordinates
+        sf::FloatRect fatBounds;
+        xy::Entity entity;
+
+        union
+        {
+            std::int32_t parent;
+            std::int32_t next;
+        };
+
+        std::int32_t childA = Null;
+        std::int32_t childB = Null;
+
+        //leaf == 0, else Null if free
+        std::int32_t height = Null;
+    };
+
+    namespace Detail
+    {
+        //growable stack using preallocated memory
+        template <typename T, std::size_t SIZE>
+        class FixedStack final
+        {
+        public:
+
+            T pop()
+            {
+                XY_ASSERT(m_size != 0, "Stack is empty!");
+                m_size--;
+                return m_data[m_size];
+            }
+
+            void push(T data)
+            {
+                XY_ASSERT(m_size < m_data.size(), "Stack is full!");
+
+                m_data[m_size++] = data;
+            }
+
+            std::size_t size() const
+            {
+                return m_size;
+            }
+
+        private:
+            std::array<T, SIZE> m_data;
+            std::size_t m_size = 0; //current size / next free index
+        };
+
+        /*!
+        \brief The AABB tree used by the DynamicTreeSystem.
+        This is exposed so that other systems, such as the RenderSystem,
+        can maintain their own broadphase without requiring a
+        BroadphaseComponent on each entity.
+        */
+        class XY_API DynamicTree final
+        {
+        public:
+            /*!
+            \brief Constructor.
+            \param fattenAmount Amount to expand each proxy by so that
+            small movements don't require the proxy to be reinserted.
+            */
+            explicit DynamicTree(float fattenAmount = 10.f);
+
+            /*!
+            \brief Inserts a proxy with the given world bounds for the given entity.
+            \returns ID of the proxy used to move or remove it
+            */
+            std::int32_t addToTree(sf::FloatRect worldBounds, xy::Entity);
+
+            /*!
+            \brief Removes the proxy with the given ID
+            */
+            void removeFromTree(std::int32_t);
+
+            /*!
+            \brief Moves a proxy with the specified treeID. If the entity
+            has moved outside of the node's fattened AABB then it
+            is removed from the tree and reinserted.
+            \returns true if the proxy was reinserted
+            */
+            bool moveNode(std::int32_t, sf::FloatRect, sf::Vector2f);
+
+            /*!
+            \brief Calls the given function for each entity whose fattened
+            bounds intersect the given area, with the signature void(xy::Entity)
+            */
+            template <typename Func>
+            void query(sf::FloatRect area, Func&& func) const
+            {
+                FixedStack<std::int32_t, 256> stack;
+                stack.push(m_root);
+
+                while (stack.size() > 0)
+                {
+                    auto treeID = stack.pop();
+                    if (treeID == TreeNode::Null)
+                    {
+                        continue;
+                    }
+
+                    const auto& node = m_nodes[treeID];
+                    if (area.intersects(node.fatBounds))
+                    {
+                        if (node.isLeaf())
+                        {
+                            if (node.entity.isValid())
+                            {
+                                func(node.entity);
+                            }
+                        }
+                        else
+                        {
+                            stack.push(node.childA);
+                            stack.push(node.childB);
+                        }
+                    }
+                }
+            }
+
+            /*!
+            \brief Removes all proxies from the tree
+            */
+            void clear();
+
+            sf::FloatRect getFatAABB(std::int32_t) const;
+            std::int32_t getMaxBalance() const;
+            float getAreaRatio() const;
+
+        private:
+            float m_fattenAmount;
+
+            std::int32_t allocateNode();
+            void freeNode(std::int32_t);
+
+            void insertLeaf(std::int32_t);
+            void removeLeaf(std::int32_t);
+
+            std::int32_t balance(std::int32_t);
+
+            std::int32_t computeHeight() const;
+            std::int32_t computeHeight(std::int32_t) const;
+
+            void validateStructure(std::int32_t) const;
+            void validateMetrics(std::int32_t) const;
+
+            std::int32_t m_root;
+
+            std::size_t m_nodeCount;
+            std::size_t m_nodeCapacity;
+            std::vector<TreeNode> m_nodes;
+
+            std::int32_t m_freeList; //must be signed!
+
+            std::size_t m_path;
+
+            std::size_t m_insertionCount;
+        };
+    }
+}
@@ -35,9 +35,12 @@ source distribution.
 #include "xyginext/ecs/systems/CommandSystem.hpp"
 #include "xyginext/ecs/Director.hpp"
 #include "xyginext/graphics/postprocess/PostProcess.hpp"
+#include "xyginext/graphics/postprocess/RenderTargetPool.hpp"
+#include "xyginext/graphics/DynamicResolution.hpp"
 
 #include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Graphics/Drawable.hpp>
+#include <SFML/System/Clock.hpp>
 
 #include <functional>
 #include <array>
@@ -46,6 +49,7 @@ source distribution.
 namespace xy
 {
     class MessageBus;
+    class RenderSystem;
 
     /*!
     \brief Encapsulates a single scene.
@@ -74,7 +78,7 @@ namespace xy
         explicit Scene(MessageBus& messageBus, std::size_t initialPoolSize = 256);
 
 
-        ~Scene() = default;
+        ~Scene();
         Scene(const Scene&) = delete;
         Scene(Scene&&) = delete;
         Scene& operator = (const Scene&) = delete;
@@ -158,6 +162,41 @@ namespace xy
         */
         void setPostEnabled(bool);
 
+        /*!
+        \brief Sets the resolution at which the scene is rendered when
+        post processes are enabled, relative to the size of the window.
+        The scene is rendered to a smaller buffer which is upscaled when
+        it is drawn to the window, reducing the fill rate cost of the scene
+        and of any post processes. The resolution of individual effects
+        can also be set with PostProcess::setResolutionScale().
+        This has no effect if no post processes have been added, and is
+        overridden while dynamic resolution is enabled.
+        \param scale A value between 0.1 and 1. Defaults to 1
+        */
+        void setResolutionScale(float scale);
+
+        /*!
+        \brief Returns the current resolution scale of the scene buffer
+        */
+        float getResolutionScale() const { return m_resolutionScale; }
+
+        /*!
+        \brief Enables or disables dynamic resolution.
+        When enabled the resolution scale of the scene is adjusted each
+        frame, within the limits of the given settings, to try to maintain
+        the target frame time. The GPU frame time reported by RenderStats
+        is used where timer queries are supported, else the interval
+        between frames. Requires post processing to be enabled.
+        Disabling dynamic resolution resets the resolution scale to 1.
+        \see DynamicResolution
+        */
+        void setDynamicResolution(bool enabled, const DynamicResolution::Settings& settings = DynamicResolution::Settings());
+
+        /*!
+        \brief Returns true if dynamic resolution is enabled
+        */
+        bool getDynamicResolution() const { return m_dynamicResolutionEnabled; }
+
         /*!
         \brief Returns a copy of the entity containing the default camera
         */
@@ -177,6 +216,27 @@ namespace xy
         */
         Entity getActiveCamera() const;
 
+        /*!
+        \brief Sets an ordered list of cameras with which to render the scene.
+        When this list is not empty the scene is drawn once for each camera
+        in the order given, rather than with only the active camera. Each
+        camera uses its own viewport, filter flags and, optionally, render
+        target, making this suitable for split screen or mini-maps. The active
+        camera is set to each camera in turn while it is being rendered, and
+        restored afterwards. Systems such as the RenderSystem use this list to
+        cull and sort drawables for each camera once per frame, rather than
+        once per draw. Pass an empty vector to return to rendering with only
+        the active camera.
+        \see Camera::setRenderTarget()
+        */
+        void setRenderCameras(const std::vector<Entity>&);
+
+        /*!
+        \brief Returns the list of cameras used to render the scene.
+        \see setRenderCameras()
+        */
+        const std::vector<Entity>& getRenderCameras() const { return m_renderCameras; }
+
         /*!
         \brief Sets the active listener when processing audio.
         Usually this will be on the same entity as the active camera,
@@ -223,6 +283,7 @@ namespace xy
         Entity m_defaultCamera;
         Entity m_activeCamera;
         Entity m_activeListener;
+        std::vector<Entity> m_renderCameras;
 
         std::vector<Entity> m_pendingEntities;
         std::vector<Entity> m_destroyedEntities;
@@ -237,11 +298,35 @@ namespace xy
         bool directorExists() const;
 
         std::vector<sf::Drawable*> m_drawables;
+        std::vector<RenderSystem*> m_renderSystems; //updated after all other systems
 
         sf::RenderTexture m_sceneBuffer;
-        std::array<sf::RenderTexture, 2u> m_postBuffers;
+        RenderTargetPool m_postTargets;
         std::vector<std::unique_ptr<PostProcess>> m_postEffects;
-
+        std::vector<PostProcess*> m_activePostEffects;
+
+        sf::Vector2u m_outputSize;
+        float m_resolutionScale;
+        bool m_dynamicResolutionEnabled;
+        DynamicResolution m_dynamicResolution;
+        sf::Clock m_frameClock;
+        bool createSceneBuffer(sf::Vector2u);
+        static sf::Vector2u getScaledSize(sf::Vector2u, float);
+        static sf::Vector2u getPostOutputSize();
+
+        //camera views copied at the end of update for the render thread
+        struct RenderSnapshot final
+        {
+            sf::View activeView;
+            std::vector<std::pair<sf::View, sf::RenderTexture*>> cameras;
+            float postUpdateTime = 0.f; //not yet passed to the post effects
+            sf::Vector2u bufferSize; //non-zero if the window was resized
+        };
+        std::array<RenderSnapshot, 2u> m_renderSnapshots;
+        sf::Vector2u m_pendingBufferSize; //until the next snapshot is written
+        void writeRenderSnapshot();
+
+        void drawCameras(sf::RenderTarget&, sf::RenderStates);
         void postRenderPath(sf::RenderTarget&, sf::RenderStates);
         std::function<void(sf::RenderTarget&, sf::RenderStates)> currentRenderPath;
 
@@ -29,11 +29,17 @@ source distribution.
 template <typename T, typename... Args>
 T& Scene::addSystem(Args&&... args)
 {
+    App::syncRenderThread();
     auto& system = m_systemManager.addSystem<T>(std::forward<Args>(args)...);
     if constexpr (std::is_base_of<sf::Drawable, T>::value)
     {
         m_drawables.push_back(dynamic_cast<sf::Drawable*>(&system));
     }
+
+    if constexpr (std::is_base_of<RenderSystem, T>::value)
+    {
+        m_renderSystems.push_back(&system);
+    }
     return system;
 }
 
@@ -91,10 +97,12 @@ template <typename T, typename... Args>
 T& Scene::addPostProcess(Args&&... args)
 {
     static_assert(std::is_base_of<PostProcess, T>::value, "Must be a post process type");
-    auto size = App::getRenderWindow()->getSize();
+    App::syncRenderThread();
+
+    auto size = getPostOutputSize();
     if (m_postEffects.empty())
     {
-        if (m_sceneBuffer.create(size.x, size.y, sf::ContextSettings(24)))
+        if (createSceneBuffer(size))
         {
             //set render path
             currentRenderPath = std::bind(&Scene::postRenderPath, this, std::placeholders::_1, std::placeholders::_2);
@@ -107,17 +115,8 @@ T& Scene::addPostProcess(Args&&... args)
     m_postEffects.emplace_back(std::make_unique<T>(std::forward<Args>(args)...));
     m_postEffects.back()->resizeBuffer(size.x, size.y);
 
-    //create intermediate buffers if needed
-    switch (m_postEffects.size())
-    {
-    case 2:
-        m_postBuffers[0].create(size.x, size.y);
-        break;
-    case 3:
-        m_postBuffers[1].create(size.x, size.y);
-        break;
-    default: break;
-    }
+    //intermediate buffers are acquired from the pool as they're needed
+    m_postEffects.back()->m_targetPool = &m_postTargets;
 
     return *dynamic_cast<T*>(m_postEffects.back().get());
 }
@@ -152,6 +152,7 @@ namespace xy
         \brief Returns a pointer to the scene to which this system belongs
         */
         Scene* getScene();
+        const Scene* getScene() const;
 
     private:
 
@@ -111,12 +111,14 @@ namespace xy
     private:
 
         void updateVertices(Drawable&);
+        void updateColour(Drawable&);
 
         std::string m_string;
         const BitmapFont* m_font;
         sf::Color m_colour;
 
         bool m_dirty;
+        bool m_colourDirty; //only the vertex colours need updating
 
         friend class BitmapTextSystem;
     };
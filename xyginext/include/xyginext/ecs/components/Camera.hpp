@@ -32,6 +32,14 @@ source distribution.
 #include <SFML/Graphics/View.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 
+#include <cstdint>
+#include <limits>
+
+namespace sf
+{
+    class RenderTexture;
+}
+
 namespace xy
 {
     /*!
@@ -140,6 +148,34 @@ namespace xy
         */
         void applyView(sf::RenderTarget& rt) { rt.setView(m_view); }
 
+        /*!
+        \brief Sets the filter flags used when rendering with this camera.
+        These are combined with the RenderSystem's filter flags, so that
+        only drawables with matching flags are rendered by this camera.
+        \see RenderSystem::setFilterFlags()
+        */
+        void setFilterFlags(std::uint64_t flags) { m_filterFlags = flags; }
+
+        /*!
+        \brief Returns the current filter flags of this camera
+        */
+        std::uint64_t getFilterFlags() const { return m_filterFlags; }
+
+        /*!
+        \brief Sets a render texture to which this camera renders when
+        it is part of the Scene's list of render cameras, for example
+        when creating a mini-map. The texture is cleared and displayed
+        each frame by the Scene. Set this to nullptr (the default) to
+        render to the Scene's output.
+        \see Scene::setRenderCameras()
+        */
+        void setRenderTarget(sf::RenderTexture* target) { m_renderTarget = target; }
+
+        /*!
+        \brief Returns a pointer to the camera's render target, if it has one
+        */
+        sf::RenderTexture* getRenderTarget() const { return m_renderTarget; }
+
     private:
 
         sf::Vector2f m_viewSize;
@@ -151,7 +187,12 @@ namespace xy
         sf::FloatRect m_bounds;
         float m_zoom;
 
+        std::uint64_t m_filterFlags;
+        sf::RenderTexture* m_renderTarget;
+
         friend class Scene;
         friend class CameraSystem;
+        friend class RenderSystem;
+        friend class TileMapSystem;
     };
 }
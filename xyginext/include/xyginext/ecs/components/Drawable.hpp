@@ -28,17 +28,21 @@ source distribution.
 #pragma once
 
 #include "xyginext/Config.hpp"
+#include "xyginext/core/SmallVector.hpp"
 
 #include <SFML/Graphics/RenderStates.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Glsl.hpp>
 #include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Color.hpp>
 #include <SFML/System/Vector3.hpp>
 
 #include <vector>
 #include <string>
 #include <array>
+#include <memory>
 
 namespace xy
 {
@@ -53,8 +57,47 @@ namespace xy
     class XY_API Drawable final : public sf::Drawable
     {
     public:
+        /*!
+        \brief Describes a single textured quad drawn by instancing.
+        \see setInstanceData()
+        */
+        struct InstanceData final
+        {
+            sf::FloatRect textureRect; //!< in pixels. Also the size of the quad
+            sf::Color colour = sf::Color::White;
+
+            /*!
+            \brief A looped animation played by the instancing shader, which
+            replaces the texture rect. Set by the SpriteSystem for sprites
+            whose animation is played on the GPU.
+            \see SpriteAnimation::setPlayback()
+            */
+            struct Animation final
+            {
+                std::uint16_t firstFrame = 0; //!< index into the shared frame table
+                std::uint8_t frameCount = 0; //!< zero if not animated
+                std::uint8_t loopStart = 0;
+                float framerate = 0.f;
+                float startTime = 0.f; //!< in seconds, on the frame table clock
+            }animation;
+        };
+
+        /*!
+        \brief Number of vertices stored inside the Drawable itself.
+        Larger vertex arrays are allocated on the heap.
+        */
+        static constexpr std::size_t InlineVertexCount = 4;
+        using VertexList = SmallVector<sf::Vertex, InlineVertexCount>;
+
         Drawable();
         explicit Drawable(const sf::Texture&);
+        ~Drawable();
+
+        Drawable(const Drawable&);
+        Drawable& operator = (const Drawable&);
+
+        Drawable(Drawable&&) noexcept;
+        Drawable& operator = (Drawable&&) noexcept;
 
         /*!
         \brief Sets the texture with which to render this drawable.
@@ -78,7 +121,10 @@ namespace xy
         instance, desirable to the apply a different texture for each drawble.
         This function allows mapping a uniform name (assuming it is available
         in the current shader) to a texture or other value.
-        Bindings are limited to 6 per type.
+        When drawn by the RenderSystem uniform locations are looked up once
+        per shader each time the system is drawn, and values are only
+        uploaded when they differ from those uploaded by the previous
+        Drawable using the same shader.
         */
         void bindUniform(const std::string& name, const sf::Texture& texture);
 
@@ -99,7 +145,6 @@ namespace xy
 
         /*!
         \brief Binds the given uniform to the value of sf::Shader::CurrentTexture.
-        Up to 6 uniforms may be bound to this value.
         */
         void bindUniformToCurrentTexture(const std::string& name);
 
@@ -145,7 +190,7 @@ namespace xy
         /*!
         \brief Returns the current blend mode
         */
-        sf::BlendMode getBlendMode() const { return m_states.blendMode; }
+        sf::BlendMode getBlendMode() const { return m_blendMode; }
 
         /*!
         \brief Sets the z-depth of a drawable.
@@ -161,6 +206,22 @@ namespace xy
         */
         std::int32_t getDepth() const { return m_zDepth; }
 
+        /*!
+        \brief Sets the render layer of this drawable.
+        Layers are drawn in ascending order, and drawables are only sorted
+        by depth within their layer. Layers can be cached by the RenderSystem
+        so that static content, such as a tile map, is drawn with a single
+        textured quad. Must be less than MaxLayers, default value is 0.
+        \see RenderSystem::setLayerCached()
+        */
+        void setLayer(std::uint8_t layer);
+
+        /*!
+        \brief Returns the render layer of this drawable
+        \see setLayer()
+        */
+        std::uint8_t getLayer() const { return m_layer; }
+
         /*!
         \brief Set an area to which to crop the drawable.
         The given rectangle should be in local coordinates, relative to
@@ -171,19 +232,23 @@ namespace xy
         /*!
         \brief Returns the current cropping area
         */
-        sf::FloatRect getCroppingArea() const { return m_croppingArea; }
+        sf::FloatRect getCroppingArea() const;
 
         /*!
         \brief Returns a reference to the vertex array used when drawing.
+        Up to InlineVertexCount vertices, enough for a single quad, are
+        stored without allocating any memory.
+        Modifying the vertices doesn't redraw a cached layer containing the
+        drawable until updateLocalBounds() or markContentChanged() is called.
         */
-        std::vector<sf::Vertex>& getVertices() { return m_vertices; }
-        const std::vector<sf::Vertex>& getVertices() const { return m_vertices; }
+        VertexList& getVertices() { return m_vertices; }
+        const VertexList& getVertices() const { return m_vertices; }
 
         /*!
         \brief Sets the PrimitiveType used by the drawable.
         Uses sf::Quads by default.
         */
-        void setPrimitiveType(sf::PrimitiveType type) { m_primitiveType = type; }
+        void setPrimitiveType(sf::PrimitiveType type) { m_primitiveType = type; m_contentChanged = true; }
 
         /*!
         \brief Returns the current PrimitiveType used to draw the vertices
@@ -201,11 +266,21 @@ namespace xy
         \brief Updates the local bounds.
         This should be called once by a system when it updates the vertex array.
         As this is used by the render system for culling, Drawable components
-        will not be drawn if the bounds have not been updated.
+        will not be drawn if the bounds have not been updated. This also marks
+        the content as changed.
+        \see markContentChanged()
         */
         void updateLocalBounds();
         void updateLocalBounds(sf::FloatRect);
 
+        /*!
+        \brief Marks the vertices as modified, so that any cached layer
+        containing the drawable is redrawn. Only required when the vertices
+        are modified without calling updateLocalBounds(), for example when
+        updating their colour or texture coordinates.
+        */
+        void markContentChanged() { m_contentChanged = true; }
+
         /*!
         \brief Enables or disables viewport culling.
         By default Drawables are culled from rendering when not in the
@@ -217,6 +292,53 @@ namespace xy
         */
         void setCulled(bool cull) { m_cull = cull; }
 
+        /*!
+        \brief Marks this drawable as static.
+        When the RenderSystem has broadphase culling enabled static
+        drawables are inserted into the broadphase once when they are
+        added to the system, and then skipped entirely during updates.
+        Static drawables should therefore not be moved, resized or have
+        their culling or cropping changed once the entity has been added
+        to the scene. This flag has no effect when broadphase culling
+        is disabled.
+        \see RenderSystem::setBroadphaseCulling()
+        */
+        void setStatic(bool isStatic) { m_static = isStatic; }
+
+        /*!
+        \brief Returns true if this drawable is marked as static
+        */
+        bool isStatic() const { return m_static; }
+
+        /*!
+        \brief Draws this drawable as a single textured quad rather than
+        with its vertex array, which is cleared.
+        When the core render backend is active the RenderSystem draws runs of
+        instanced drawables which share a texture, blend mode and GL flags, and
+        which have no shader or cropping, with a single instanced draw call.
+        Otherwise the quad is expanded to vertices when it is drawn. The
+        SpriteSystem uses this when sprite instancing is enabled.
+        \see SpriteSystem::setInstancingEnabled()
+        */
+        void setInstanceData(const InstanceData&);
+
+        /*!
+        \brief Stops drawing this drawable as an instanced quad.
+        The vertex array needs to be rebuilt by whichever system owns it.
+        */
+        void clearInstanceData();
+
+        /*!
+        \brief Returns true if this drawable is drawn as an instanced quad
+        */
+        bool isInstanced() const { return m_instanced; }
+
+        /*!
+        \brief Returns the current instance data
+        \see setInstanceData()
+        */
+        const InstanceData& getInstanceData() const { return m_instanceData; }
+
         /*!
         \brief Returns the RenderStates containing the current blend mode,
         PrimitiveType and Shader of the drawable.
@@ -251,81 +373,124 @@ namespace xy
         */
         bool getDepthWriteEnabled() const { return m_depthWriteEnabled; }
 
+        /*!
+        \brief Allows the RenderSystem to merge this drawable with others
+        drawn immediately before or after it into a single draw call.
+        Drawables are merged when they share a texture, shader, blend mode,
+        primitive type and uniform values, and have no cropping area or GL
+        flags. Their vertices are transformed on the CPU, so this should only
+        be used with small vertex arrays, and with shaders which do not rely
+        on the untransformed vertex position. Default is false, Text enables
+        it.
+        */
+        void setBatchingEnabled(bool enabled) { m_batchingEnabled = enabled; }
+
+        /*!
+        \brief Returns true if this drawable may be merged with others
+        \see setBatchingEnabled()
+        */
+        bool getBatchingEnabled() const { return m_batchingEnabled; }
+
         /*!
         \brief default flag value for drawables 
         0b1000000000000000000000000000000000000000000000000000000000000000
         */
         static constexpr std::uint64_t DefaultFilterFlag = (1ull << 63);
 
-    private:
-        sf::PrimitiveType m_primitiveType = sf::Quads;
-        sf::RenderStates m_states;
-        std::vector<sf::Vertex> m_vertices;
+        /*!
+        \brief The number of render layers available
+        \see setLayer()
+        */
+        static constexpr std::uint8_t MaxLayers = 16;
 
+    private:
+        //hot data, read by the RenderSystem for every drawable each frame.
+        //Ordered roughly by the order in which it is accessed when culling,
+        //sorting and drawing
+        std::uint64_t m_filterFlags;
+        sf::FloatRect m_worldBounds; //updated by the RenderSystem for culling
+        sf::FloatRect m_localBounds;
+        //affine part of the world transform with which the world bounds and
+        //cropping area were last updated, so they're only updated on change
+        std::array<float, 6u> m_boundsTransform = {};
+        std::uint64_t m_sortKey;
         std::int32_t m_zDepth = 0;
-        bool m_wantsSorting = true;
+        std::int32_t m_treeID;
+        std::uint8_t m_layer;
 
-        std::uint64_t m_filterFlags;
+        const sf::Texture* m_texture = nullptr;
+        const sf::Shader* m_shader = nullptr;
+        sf::BlendMode m_blendMode;
 
-        sf::FloatRect m_localBounds;
+        VertexList m_vertices;
+        sf::PrimitiveType m_primitiveType = sf::Quads;
 
-        static constexpr std::size_t MaxBindings = 6;
-        std::vector<std::pair<std::string, const sf::Texture*>> m_textureBindings;
-        std::vector<std::pair<std::string, float>> m_floatBindings;
-        std::vector<std::pair<std::string, sf::Vector2f>> m_vec2Bindings;
-        std::vector<std::pair<std::string, sf::Vector3f>> m_vec3Bindings;
-        std::vector<std::pair<std::string, bool>> m_boolBindings;
-        std::vector<std::pair<std::string, sf::Glsl::Vec4>> m_colourBindings;
-        std::vector<std::pair<std::string, const float*>> m_matBindings;
-        std::vector<std::string> m_currentTexBindings;
-
-        template <typename T>
-        void bindUniform(const std::string& name, T value, std::vector<std::pair<std::string, T>>& dest)
+        bool m_wantsSorting = true; //depth, texture, shader or blend mode changed
+        bool m_cull;
+        bool m_static;
+        bool m_cropped;
+        bool m_depthWriteEnabled;
+        bool m_instanced;
+        bool m_batchingEnabled;
+        bool m_boundsDirty; //local bounds or cropping area changed
+        bool m_contentChanged; //anything drawn changed, invalidates a cached layer
+        std::uint8_t m_glFlagCount;
+
+        InstanceData m_instanceData;
+
+        //grouped so the RenderSystem can copy them into a render snapshot.
+        //Values are stored in a single block and uniform locations are
+        //looked up once per shader program rather than by name each draw
+        struct UniformBindings final
         {
-            auto result = std::find_if(dest.begin(), dest.end(),
-                [&name](const std::pair<std::string, T>& pair)
-                {
-                    return pair.first == name;
-                });
-
-            if (result == dest.end())
-            {
-               dest.emplace_back(std::make_pair(name, value));
-            }
-            else
+            enum class Type : std::uint8_t
             {
-                result->second = value;
-            }
-        }
+                Float, Vec2, Vec3, Vec4, Bool,
+                Matrix, Texture, CurrentTexture
+            };
 
-        template <typename T>
-        void bindUniform(const std::string& name, const T* value, std::vector<std::pair<std::string, T>>& dest)
+            struct Binding final
+            {
+                std::string name;
+                Type type = Type::Float;
+                std::uint32_t offset = 0; //into values
+                const void* pointer = nullptr; //textures and matrices
+                mutable std::int32_t location = -1;
+            };
+
+            std::vector<Binding> bindings;
+            std::vector<float> values;
+            //locations were resolved for this program during this pass
+            mutable std::uint32_t program = 0;
+            mutable std::uint64_t pass = 0;
+
+            void set(const std::string&, Type, const float*, std::size_t, const void* = nullptr);
+            void apply(sf::Shader&) const;
+            bool matches(const UniformBindings&) const;
+            static std::size_t valueCount(Type);
+        };
+
+        //cold data, only allocated once a drawable has uniform
+        //bindings, GL flags or a cropping area
+        struct ColdData final
         {
-            auto result = std::find_if(dest.begin(), dest.end(),
-                [&name](const std::pair<std::string, T>& pair)
-                {
-                    return pair.first == name;
-                });
+            UniformBindings uniformBindings;
+            std::array<std::int32_t, 4u> glFlags = {};
+            sf::FloatRect croppingArea;
+            sf::FloatRect croppingWorldArea;
 
-            if (result == dest.end())
-            {
-                dest.emplace_back(std::make_pair(name, value));
-            }
-            else
-            {
-                result->second = value;
-            }
-        }
+            ColdData();
+        };
+        std::unique_ptr<ColdData> m_coldData;
 
-        bool m_cull;
+        ColdData& getColdData();
 
-        sf::FloatRect m_croppingArea;
-        sf::FloatRect m_croppingWorldArea;
-        bool m_cropped;
+        static std::array<sf::Vertex, 4u> getInstanceQuad(const InstanceData&);
 
-        std::array<std::int32_t, 4u> m_glFlags = {};
-        std::size_t m_glFlagIndex;
-        bool m_depthWriteEnabled;
+        //uniform locations and uploaded values are only cached between
+        //these calls, as shaders may be modified or destroyed in between
+        static void beginUniformPass();
+        static void endUniformPass();
 
         friend class RenderSystem;
 
@@ -29,10 +29,13 @@ source distribution.
 
 #include "xyginext/Config.hpp"
 #include "xyginext/resources/ResourceHandler.hpp"
+#include "xyginext/ecs/components/Drawable.hpp"
+#include "xyginext/detail/AnimatorHook.hpp"
 
 #include <SFML/Graphics/RenderStates.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 
+#include <memory>
 #include <vector>
 
 namespace sf
@@ -46,6 +49,10 @@ namespace xy
     \brief Sprite component optimised to work with the ECS.
     Sprite components require their entity to also have a Drawable component
     and a Transform component.
+    Animation data is immutable and shared between copies of a Sprite, such
+    as those returned by SpriteSheet::getSprite(), so spawning many animated
+    sprites does not copy their animations. A Sprite makes its own copy of
+    the animations only when they are modified via getAnimations().
     */
     class XY_API Sprite final
     {
@@ -137,16 +144,24 @@ namespace xy
 
 
         /*!
-        /brief Returns a reference to the sprites animation array.
+        \brief Returns a reference to the sprites animation array.
+        If the animations are shared with other sprites they are first
+        copied, so that modifying them only affects this sprite. Prefer
+        the const overload when only reading the animations.
         */
-        std::vector<Animation>& getAnimations() { return m_animations; }
+        std::vector<Animation>& getAnimations();
 
         /*!
-        /brief Returns a const reference to the sprites animation array.
+        \brief Returns a const reference to the sprites animation array.
         */
-        const std::vector<Animation>& getAnimations() const { return m_animations; }
+        const std::vector<Animation>& getAnimations() const { return *m_animations; }
 
-        std::size_t getAnimationCount() const { return m_animations.size(); }
+        /*!
+        \brief Replaces the animation array of this sprite
+        */
+        void setAnimations(std::vector<Animation> animations);
+
+        std::size_t getAnimationCount() const { return m_animations->size(); }
 
     private:
 
@@ -160,8 +175,15 @@ namespace xy
         sf::BlendMode m_blendMode;
         bool m_blendOverride;
         bool m_dirty;
+        bool m_texCoordsDirty; //only the texture rect position changed
+        bool m_instanced; //set by the SpriteSystem, GPU animation requires instancing
+        Drawable::InstanceData::Animation m_gpuAnimation; //set by the SpriteAnimator
+
 
-        std::vector<Animation> m_animations;
+        //never null, sprites without animations share an empty array
+        std::shared_ptr<const std::vector<Animation>> m_animations;
+        std::uint32_t m_animationRevision; //incremented when the animations may have been modified
+        Detail::AnimatorHook m_animatorHook;
 
         friend class SpriteSystem;
         friend class SpriteSheet;
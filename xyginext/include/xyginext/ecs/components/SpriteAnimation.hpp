@@ -28,6 +28,8 @@ source distribution.
 #pragma once
 
 #include "xyginext/Config.hpp"
+#include "xyginext/detail/AnimatorHook.hpp"
+
 #include <SFML/Config.hpp>
 
 namespace xy
@@ -38,6 +40,16 @@ namespace xy
     */
     struct XY_API SpriteAnimation final
     {
+        /*!
+        \brief How the animation frames are advanced
+        \see setPlayback()
+        */
+        enum class Playback
+        {
+            CPU, //!< by the SpriteAnimator each frame
+            GPU  //!< by the sprite instancing shader
+        };
+
         /*!
         \brief Play the animation at the given index if it exists
         \param index The animation index to play. This can be read from xy::SpriteSheet::getAnimationIndex()
@@ -51,7 +63,9 @@ namespace xy
             if (rewind)
             {
                 m_frameID = 0;
+                m_rewound = true;
             }
+            m_hook.markDirty();
         }
 
         /*!
@@ -63,13 +77,13 @@ namespace xy
         /*!
         \brief Pause the playing animation, if there is one
         */
-        void pause() { m_playing = false; }
+        void pause() { m_playing = false; m_hook.markDirty(); }
 
         /*!
         \brief Stops the current animation if it is playing and
         rewinds it to the first frame if it is playing or paused
         */
-        void stop() { m_playing = false; m_frameID = 0; }
+        void stop() { m_playing = false; m_frameID = 0; m_rewound = true; m_hook.markDirty(); }
 
         /*!
         \brief Returns true if the current animation has stopped playing
@@ -84,14 +98,52 @@ namespace xy
         /*!
         \brief Set the current frame ID
         */
-        void setFrameID(std::uint32_t frameID) { m_frameID = frameID; }
+        void setFrameID(std::uint32_t frameID) { m_frameID = frameID; m_rewound = true; m_hook.markDirty(); }
+
+        /*!
+        \brief Sets how the animation is played. Defaults to Playback::CPU.
+        With Playback::GPU looped animations, such as water or torches,
+        are played by the vertex shader used for instanced sprites, from
+        a table of frames shared by all sprites. Once playing they cost no
+        CPU time at all, and continue to play even when the Scene is not
+        updated. GPU playback requires the core render backend, a
+        SpriteSystem with instancing enabled and a Drawable without a
+        shader; otherwise, or if the animation is not looped, the
+        animation is played on the CPU as normal.
+        While an animation plays on the GPU getFrameID() is not updated.
+        When it is paused the current frame is read back so that it
+        resumes from the same place.
+        \see App::setRenderBackend(), SpriteSystem::setInstancingEnabled()
+        */
+        void setPlayback(Playback playback) { m_playback = playback; m_hook.markDirty(); }
+
+        /*!
+        \brief Returns the current playback mode
+        */
+        Playback getPlayback() const { return m_playback; }
+
+        /*!
+        \brief Sets a time offset in seconds for animations played on
+        the GPU, so that sprites playing the same animation can be out
+        of step with each other
+        */
+        void setPhase(float phase) { m_phase = phase; m_hook.markDirty(); }
+
+        /*!
+        \brief Returns the current GPU playback phase
+        */
+        float getPhase() const { return m_phase; }
 
     private:
         std::size_t m_id = 0;
         bool m_playing = false;
-        float m_currentFrameTime = 0.f;
         std::uint32_t m_frameID = 0;
 
+        Playback m_playback = Playback::CPU;
+        float m_phase = 0.f;
+        bool m_rewound = false; //frame ID was set explicitly since the SpriteAnimator last ran
+        Detail::AnimatorHook m_hook;
+
         friend class SpriteAnimator;
     };
 }
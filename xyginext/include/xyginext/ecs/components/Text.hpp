@@ -29,6 +29,7 @@ source distribution.
 
 #include "xyginext/Config.hpp"
 #include "xyginext/ecs/Entity.hpp"
+#include "xyginext/ecs/components/Drawable.hpp"
 
 #include <SFML/System/String.hpp>
 #include <SFML/Graphics/Glyph.hpp>
@@ -46,8 +47,6 @@ namespace sf
 
 namespace xy
 {
-    class Drawable;
-
     /*!
     \brief ECS friendly implementation of Text.
     Text components should appear on entities which
@@ -175,6 +174,15 @@ namespace xy
         */
         static sf::FloatRect getLocalBounds(xy::Entity);
 
+        /*!
+        \brief Releases the glyph metrics and distance field atlas cached
+        for the given font. These are shared by every Text and looked up by
+        the font's address, so this must be called before a font used by
+        Text is destroyed or reloaded. Fonts owned by a ResourceHandler or
+        FontResource are released when it is destroyed.
+        */
+        static void releaseFont(const sf::Font&);
+
         /*!
         \brief Set an area to which to crop the text.
         The given rectangle should be in local coordinates, relative to
@@ -206,10 +214,36 @@ namespace xy
         */
         Alignment getAlignment() const { return m_alignment; }
 
+        enum class Mode
+        {
+            Bitmap, DistanceField
+        };
+
+        /*!
+        \brief Sets how the glyphs of the text are rendered.
+        Bitmap text uses the font's glyph page for the current character
+        size, so every size used creates and uploads a new page. DistanceField
+        text uses a signed distance field of each glyph, rasterised once, so
+        stays sharp at any character size or scale and draws any outline in
+        the same pass as the fill. All distance field text with the same font
+        shares one texture and shader, so can be drawn with a single draw call.
+        Distance field text replaces any shader set on its drawable, and
+        outlines are limited to a few pixels at a character size of 48.
+        Defaults to Bitmap.
+        */
+        void setMode(Mode);
+
+        /*!
+        \brief Returns the current render mode
+        */
+        Mode getMode() const { return m_mode; }
+
     private:
         
         void updateVertices(Drawable&);
-        void addQuad(std::vector<sf::Vertex>&, sf::Vector2f position, sf::Color, const sf::Glyph& glyph, float = 0.f);
+        void updateColours(Drawable::VertexList&, std::size_t);
+        void addQuad(Drawable::VertexList&, sf::Vector2f position, sf::Color, const sf::Glyph& glyph, float = 0.f);
+        void invalidateLayout();
 
         sf::String m_string;
         const sf::Font* m_font;
@@ -219,7 +253,27 @@ namespace xy
         sf::Color m_outlineColour;
         float m_outlineThickness;
         bool m_dirty;
+        bool m_colourDirty;
         Alignment m_alignment;
+        Mode m_mode;
+
+        //pen position and bounds after each character, so that when
+        //the string changes only the characters from the first one
+        //which differs are laid out again
+        struct LayoutState final
+        {
+            float x = 0.f;
+            float y = 0.f;
+            float minX = 0.f;
+            float minY = 0.f;
+            float maxX = 0.f;
+            float maxY = 0.f;
+            std::uint32_t prevChar = 0;
+            std::uint32_t vertexCount = 0;
+        };
+        std::vector<LayoutState> m_layout;
+        std::size_t m_layoutStart;
+        float m_alignmentOffset;
 
         friend class TextSystem;
     };
@@ -0,0 +1,266 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include "xyginext/Config.hpp"
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/Glsl.hpp>
+
+#include <vector>
+#include <memory>
+#include <functional>
+#include <cstdint>
+
+namespace sf
+{
+    class Texture;
+}
+
+namespace xy
+{
+    /*!
+    \brief Tile map component.
+    A TileMap component draws a single layer of tiles, split into fixed size
+    chunks. Each chunk has its own vertex buffer and bounding box so that the
+    TileMapSystem only draws chunks which are visible to the camera. Only the
+    chunks within the streaming area around the camera have their geometry
+    created, and chunks which leave this area are released again. For maps
+    which are too large to keep in memory a chunk loader can be used to supply
+    tiles as chunks are streamed in, rather than setting all tiles up front.
+    Animated tiles are animated in the vertex shader with a time value for
+    each map, so vertices are never rebuilt to animate a tile.
+    TileMap components require a Transform component, and a Scene with a
+    TileMapSystem. Tile layers can be loaded from tmx files with
+    xy::Util::Tmx::loadTileLayer()
+    \see TileMapSystem
+    */
+    class XY_API TileMap final
+    {
+    public:
+        /*!
+        \brief Maximum number of animated tiles in each tileset
+        */
+        static constexpr std::size_t MaxAnimations = 16;
+
+        /*!
+        \brief Maximum number of frames in a tile animation
+        */
+        static constexpr std::size_t MaxAnimationFrames = 6;
+
+        /*!
+        \brief Describes a tileset texture and the tiles within it.
+        Tile IDs are global across all tilesets used by a map, with 0 meaning
+        an empty tile, in the same way as tmx files.
+        */
+        struct Tileset final
+        {
+            const sf::Texture* texture = nullptr;
+            std::uint32_t firstID = 1;
+            std::uint32_t tileCount = 0;
+            std::uint32_t columnCount = 1;
+            sf::Vector2u tileSize;
+            std::uint32_t spacing = 0;
+            std::uint32_t margin = 0;
+
+            struct Animation final
+            {
+                struct Frame final
+                {
+                    std::uint32_t tileID = 0; //!< global tile ID
+                    float duration = 0.f; //!< seconds
+                };
+                std::uint32_t tileID = 0; //!< global ID of the tile to animate
+                std::vector<Frame> frames;
+            };
+            std::vector<Animation> animations;
+        };
+
+        /*!
+        \brief A single tile in the map
+        */
+        struct Tile final
+        {
+            std::uint32_t ID = 0; //!< global tile ID, or 0 for no tile
+            std::uint8_t flipFlags = 0; //!< combination of the FlipFlag values
+        };
+
+        enum FlipFlag
+        {
+            Horizontal = 0x8,
+            Vertical = 0x4,
+            Diagonal = 0x2
+        };
+
+        /*!
+        \brief Function used to stream tiles.
+        Called with the position of the chunk, in chunks, and a vector
+        which should be filled with the chunk's tiles in row order. The
+        vector is already sized to the chunk size. Tiles which fall outside
+        the map should be left empty.
+        */
+        using ChunkLoader = std::function<void(sf::Vector2u, std::vector<Tile>&)>;
+
+        TileMap();
+
+        /*!
+        \brief Sets the size of the map in tiles, and the size of each tile
+        in world units. Setting the size clears any existing tiles.
+        */
+        void setSize(sf::Vector2u tileCount, sf::Vector2f tileSize);
+
+        /*!
+        \brief Returns the size of the map in tiles
+        */
+        sf::Vector2u getTileCount() const { return m_tileCount; }
+
+        /*!
+        \brief Returns the size of a single tile in world units
+        */
+        sf::Vector2f getTileSize() const { return m_tileSize; }
+
+        /*!
+        \brief Sets the size of each chunk in tiles. Defaults to 16x16.
+        Smaller chunks cull more accurately at the cost of more draw calls.
+        */
+        void setChunkSize(sf::Vector2u);
+
+        /*!
+        \brief Returns the chunk size, in tiles
+        */
+        sf::Vector2u getChunkSize() const { return m_chunkSize; }
+
+        /*!
+        \brief Adds a tileset to the map. Tilesets must be added before
+        any tiles which use them. Animations beyond MaxAnimations, and
+        frames beyond MaxAnimationFrames, are ignored.
+        */
+        void addTileset(const Tileset&);
+
+        /*!
+        \brief Sets the tiles of the entire map, in row order.
+        The vector must contain one tile for each tile in the map.
+        This removes any chunk loader.
+        */
+        void setTiles(std::vector<Tile>);
+
+        /*!
+        \brief Sets a single tile. Only has an effect when the tiles
+        were set with setTiles()
+        */
+        void setTile(sf::Vector2u position, Tile);
+
+        /*!
+        \brief Sets a function used to load the tiles of each chunk as it
+        is streamed in, instead of storing the entire map. This clears any
+        tiles set with setTiles()
+        \see ChunkLoader
+        */
+        void setChunkLoader(const ChunkLoader&);
+
+        /*!
+        \brief Sets the distance in world units around the viewable area
+        of the camera in which chunks are streamed in. Chunks are released
+        again once they are a further chunk outside this area. Defaults to 0
+        */
+        void setStreamingBorder(float border) { m_streamingBorder = border; }
+
+        /*!
+        \brief Returns the streaming border
+        */
+        float getStreamingBorder() const { return m_streamingBorder; }
+
+        /*!
+        \brief Sets the opacity of the map in the range 0 - 1
+        */
+        void setOpacity(float);
+
+        /*!
+        \brief Returns the opacity of the map
+        */
+        float getOpacity() const { return m_opacity; }
+
+        /*!
+        \brief Returns the local bounds of the map
+        */
+        sf::FloatRect getLocalBounds() const;
+
+        /*!
+        \brief Returns the number of chunks which currently have geometry
+        */
+        std::size_t getLoadedChunkCount() const { return m_chunks.size(); }
+
+    private:
+        sf::Vector2u m_tileCount;
+        sf::Vector2f m_tileSize;
+        sf::Vector2u m_chunkSize;
+        float m_streamingBorder;
+        float m_opacity;
+        float m_time;
+
+        //tilesets are shared with the render snapshot so that they
+        //stay valid while the render thread is drawing
+        struct TilesetData final
+        {
+            Tileset tileset;
+            //xy offset in pixels to the frame, z end time of the frame and
+            //w duration of the animation, both in milliseconds
+            std::vector<sf::Glsl::Vec4> frames;
+        };
+        std::vector<std::shared_ptr<const TilesetData>> m_tilesets;
+
+        std::vector<Tile> m_tiles;
+        ChunkLoader m_chunkLoader;
+
+        //chunks are never modified once built, a changed chunk is
+        //replaced so that any snapshot still drawing it is unaffected
+        struct Chunk final
+        {
+            sf::Vector2u position;
+            sf::FloatRect bounds;
+
+            struct Geometry final
+            {
+                std::shared_ptr<const TilesetData> tileset;
+                std::vector<sf::Vertex> vertices;
+                mutable sf::VertexBuffer buffer;
+                mutable bool uploaded = false;
+            };
+            std::vector<Geometry> geometry;
+        };
+        std::vector<std::shared_ptr<Chunk>> m_chunks;
+        std::vector<sf::Vector2u> m_dirtyChunks;
+
+        std::shared_ptr<Chunk> buildChunk(sf::Vector2u) const;
+        void clearChunks();
+
+        friend class TileMapSystem;
+    };
+}
@@ -36,6 +36,7 @@ source distribution.
 
 #include <vector>
 #include <array>
+#include <memory>
 
 namespace xy
 {
@@ -115,12 +116,22 @@ namespace xy
             std::uint32_t frameCount = 1;
         };
 
-        std::vector<EmitterArray> m_emitterArrays;
+        //double buffered so the render thread can draw
+        //the previous frame while the next is updated
+        std::array<std::vector<EmitterArray>, 2u> m_emitterArrays;
         std::size_t m_arrayCount;
-        std::size_t m_activeArrayCount;
+        std::array<std::size_t, 2u> m_activeArrayCount;
+        std::array<bool, 2u> m_visibleSnapshot;
 
         sf::Texture m_fallbackTexture;
 
+        //shader and buffers used with App::RenderBackend::Core
+        struct CoreResources;
+        mutable std::unique_ptr<CoreResources> m_coreResources;
+        bool loadCoreResources() const;
+
         void draw(sf::RenderTarget&, sf::RenderStates) const override;
+        void drawLegacy(const sf::View&, sf::FloatRect, float) const;
+        void drawCore(const sf::View&, sf::FloatRect, float) const;
     };
 }
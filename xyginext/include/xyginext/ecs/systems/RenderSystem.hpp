@@ -28,15 +28,47 @@ source distribution.
 #pragma once
 
 #include "xyginext/ecs/System.hpp"
+#include "xyginext/ecs/components/Drawable.hpp"
+#include "xyginext/detail/DynamicTree.hpp"
 
 #include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/Rect.hpp>
+
+#include <vector>
+#include <array>
+#include <memory>
+
+namespace sf
+{
+    class View;
+    class RenderTexture;
+}
 
 namespace xy
 {
+    namespace Detail
+    {
+        class WorkerPool;
+    }
+
     /*!
     \brief Used to draw all entities which have a Drawable and Transform component.
     The RenderSystem is used to depth sort and draw all entities which have a 
     Drawable and Transform component attached, and optionally a Sprite component.
+    Drawables are sorted first by layer, then by depth, then by shader, texture
+    and blend mode so that drawables at the same depth are grouped to minimise
+    state changes. Layers may be cached, in which case they are drawn into a
+    texture only when their content changes, and composited with a single quad.
+    Sorting and culling are performed once per frame, after every other system
+    in the Scene has been processed, for each camera in the Scene's render
+    camera list (or the active camera if the list is empty), in parallel when
+    there are multiple cameras. When pipelined rendering is enabled the visible
+    drawables are copied into a render snapshot at the end of each update, which
+    is drawn by the render thread. With the core render backend consecutive
+    instanced drawables, such as sprites, are drawn with a single instanced
+    draw call per texture and blend mode.
+    \see App::setRenderThreadEnabled()
     NOTE multiple components which rely on a Drawable component cannot exist on the same entity,
     as only one set of vertices will be available.
     */
@@ -44,8 +76,13 @@ namespace xy
     {
     public:
         explicit RenderSystem(xy::MessageBus&);
+        ~RenderSystem();
 
-        void process(float) override;
+        RenderSystem(const RenderSystem&) = delete;
+        RenderSystem(RenderSystem&&) = delete;
+
+        RenderSystem& operator = (const RenderSystem&) = delete;
+        RenderSystem& operator = (RenderSystem&&) = delete;
 
         /*!
         \brief Adds a border around the current view when culling.
@@ -84,15 +121,267 @@ namespace xy
         */
         std::size_t getDrawCount() const { return m_lastDrawCount; }
 
+        /*!
+        \brief Enables or disables broadphase culling.
+        By default every drawable is tested against the current view each
+        time the system is drawn. When broadphase culling is enabled drawables
+        are stored in an AABB tree so that only those near the viewable area
+        are visited, which is considerably faster in large scenes where most
+        drawables are off screen. Drawables marked as static are not updated
+        once they have been inserted into the tree.
+        Note that in this mode a drawable's culling flag is only read when
+        it is added to the system.
+        \see Drawable::setStatic()
+        */
+        void setBroadphaseCulling(bool enabled);
+
+        /*!
+        \brief Returns true if broadphase culling is enabled
+        */
+        bool getBroadphaseCulling() const { return m_useBroadphase; }
+
+        /*!
+        \brief Enables or disables caching of a render layer.
+        The drawables in a cached layer are drawn into a texture covering
+        the tiles of the world around the active camera (or the first render
+        camera) which is then drawn with a single quad. The texture is only
+        redrawn when a drawable in the layer is added, removed or modified,
+        or when the camera moves into a different tile. This suits layers
+        of static content such as tile maps and backgrounds. Drawables in a
+        cached layer are composited with premultiplied alpha, so those which
+        use blend modes other than alpha blending may not appear exactly as
+        they would when drawn directly. Other cameras, whose view doesn't
+        fit in the cached area, draw the layer's drawables directly.
+        \param layer The layer to cache
+        \param cached True to enable caching
+        \param tileSize Size of the tiles, in world units, with which the
+        cached area is aligned. Larger tiles mean the cache is redrawn
+        less often as the camera moves, but use a larger texture.
+        \param resolution Number of texels per world unit in the cache
+        \see Drawable::setLayer()
+        */
+        void setLayerCached(std::uint8_t layer, bool cached, float tileSize = 512.f, float resolution = 1.f);
+
+        /*!
+        \brief Returns true if the given layer is cached
+        */
+        bool isLayerCached(std::uint8_t layer) const;
+
+        /*!
+        \brief Forces a cached layer to be redrawn.
+        Changes which the RenderSystem can't see, such as modifying a
+        texture or shader used by a drawable in the layer, require the
+        cache to be invalidated manually.
+        */
+        void invalidateLayer(std::uint8_t layer);
+
     private:
+        //called by the Scene once all systems have been processed, so that
+        //anything moved by a later system is in the same frame
+        void updateFrame();
+        friend class Scene;
+
         bool m_wantsSorting;
+
+        //key layout from most to least significant: 4 bits layer,
+        //32 bits depth, 10 bits shader, 10 bits texture, 8 bits blend mode
+        struct QueueItem final
+        {
+            std::uint64_t key = 0;
+            Entity entity;
+        };
+        std::vector<QueueItem> m_renderQueue;
+        std::vector<QueueItem> m_sortBuffer;
+        std::size_t m_changedKeys;
+
+        mutable std::vector<sf::BlendMode> m_blendModes;
+        mutable bool m_blendModesExhausted;
+        std::uint64_t getSortKey(const xy::Drawable&) const;
+        //updates the key if the drawable wants sorting, invalidating
+        //the layer caches it was in before and after. Returns the key
+        std::uint64_t refreshSortKey(xy::Drawable&) const;
+
+        static void radixSort(std::vector<QueueItem>&, std::vector<QueueItem>&);
+        static void insertionSort(std::vector<QueueItem>&);
+
+        bool m_useBroadphase;
+        Detail::DynamicTree m_tree;
+        std::vector<Entity> m_dynamicEntities;
+        std::vector<Entity> m_unculledEntities;
+
+        void addToBroadphase(xy::Entity);
+        void removeFromBroadphase(xy::Entity);
+        //updates the world bounds and cropping area if the drawable's
+        //world transform, local bounds or cropping area changed.
+        //Returns true if they were updated. Any change invalidates
+        //the cache of the drawable's layer
+        bool updateBounds(xy::Entity);
+
+        //updated with the scene, the textures are only touched
+        //by the thread which draws
+        struct CachedLayer final
+        {
+            bool enabled = false;
+            float tileSize = 512.f;
+            float resolution = 1.f;
+            bool dirty = true; //a member was added, removed or changed
+            sf::FloatRect region; //the cached area of the world, aligned to tiles
+            std::uint64_t revision = 0; //incremented each time the cache needs redrawing
+        };
+        mutable std::array<CachedLayer, xy::Drawable::MaxLayers> m_cachedLayers;
+
+        struct LayerTexture;
+        mutable std::array<std::unique_ptr<LayerTexture>, xy::Drawable::MaxLayers> m_layerTextures;
+        mutable std::vector<QueueItem> m_layerItems;
+        mutable std::vector<QueueItem> m_layerSortBuffer;
+
+        void updateLayerRegions();
+        //sorted drawables of a cached layer which are in the cached region
+        void collectLayer(std::uint8_t, std::vector<QueueItem>&) const;
+        //returns true if the layer cache covers the given viewable area
+        static bool canComposite(const CachedLayer&, sf::FloatRect);
+        //returns the layer's texture if it needs to be redrawn with the given
+        //revision and filter flags, cleared and ready to be drawn to
+        sf::RenderTexture* beginLayer(std::uint8_t, const CachedLayer&, std::uint64_t) const;
+        bool hasLayerTexture(std::uint8_t) const;
+        void compositeLayer(std::uint8_t, sf::RenderTarget&, std::array<std::int32_t, 4u>&, std::size_t&) const;
+
+        //culled and sorted drawables for each camera,
+        //reused by every draw with that camera in a frame
+        struct VisibilityList final
+        {
+            Entity camera;
+            sf::FloatRect viewableArea;
+            std::uint64_t frame = 0;
+            std::vector<QueueItem> items;
+            std::vector<QueueItem> sortBuffer;
+        };
+        mutable std::vector<VisibilityList> m_visibilityLists;
+        mutable VisibilityList m_fallbackList;
+        std::uint64_t m_frameCount;
+
+        //culls one camera each when there are several, created with the first such frame
+        std::unique_ptr<Detail::WorkerPool> m_cullingWorkers;
+
+        void updateVisibility();
+        static sf::FloatRect getViewableArea(const sf::View&, sf::Vector2f);
+        void collectVisible(VisibilityList&) const;
+        void refreshSortKeys(VisibilityList&) const;
+        void sortVisible(VisibilityList&) const;
+
+        //copy of everything needed to draw a visible drawable
+        //so that the render thread never reads the components
+        struct SnapshotItem final
+        {
+            sf::RenderStates states;
+            sf::PrimitiveType primitiveType = sf::Quads;
+            std::size_t firstVertex = 0;
+            std::size_t vertexCount = 0;
+            std::uint64_t filterFlags = 0;
+            sf::FloatRect croppingWorldArea;
+            bool cropped = false;
+            bool depthWriteEnabled = true;
+            std::array<std::int32_t, 4u> glFlags = {};
+            std::size_t glFlagCount = 0;
+            std::int32_t uniformIndex = -1;
+            bool instanced = false;
+            bool batchingEnabled = false;
+            xy::Drawable::InstanceData instanceData;
+            std::int32_t cachedLayer = -1; //composites this layer instead
+        };
+
+        //drawables copied into a snapshot, with their vertices and uniforms
+        struct SnapshotBuffer final
+        {
+            std::vector<SnapshotItem> items;
+            std::vector<sf::Vertex> vertices;
+            std::vector<xy::Drawable::UniformBindings> uniforms;
+            std::size_t uniformCount = 0;
+
+            void clear();
+            std::uint32_t add(xy::Entity);
+        };
+
+        struct Snapshot final
+        {
+            struct View final
+            {
+                sf::FloatRect viewableArea;
+                std::uint64_t filterFlags = 0;
+                std::vector<std::uint32_t> items;
+                std::uint32_t cachedLayers = 0; //bit mask of the layers composited
+            };
+            std::vector<View> views;
+            sf::Vector2f cullingBorder; //settings may change while the snapshot is drawn
+            SnapshotBuffer drawables;
+            std::shared_ptr<const std::vector<sf::FloatRect>> frameTable;
+            float frameTime = 0.f; //of GPU animations, when the snapshot was written
+
+            //members of the cached layers, only copied again
+            //when the revision of the layer changes
+            struct Layer final
+            {
+                CachedLayer cache;
+                SnapshotBuffer drawables;
+                std::vector<std::uint32_t> items;
+            };
+            std::array<Layer, xy::Drawable::MaxLayers> layers;
+        };
+        std::array<Snapshot, 2u> m_snapshots;
+
+        //indexed by entity, so drawables visible to more
+        //than one camera are only copied once per snapshot
+        std::vector<std::uint64_t> m_snapshotFrames;
+        std::vector<std::uint32_t> m_snapshotItems;
+
+        void writeSnapshot();
+        void drawSnapshot(sf::RenderTarget&) const;
+        void drawSnapshotItems(const SnapshotBuffer&, const std::vector<std::uint32_t>&, sf::RenderTarget&, std::uint64_t) const;
+
         sf::Vector2f m_cullingBorder;
         std::uint64_t m_filterFlags;
 
         mutable std::size_t m_lastDrawCount;
-        mutable bool m_depthWriteEnabled;
 
         void onEntityAdded(xy::Entity) override;
+        void onEntityRemoved(xy::Entity) override;
         void draw(sf::RenderTarget&, sf::RenderStates) const override;
+        //layers with their bit set in the mask are composited from their cache
+        void drawItems(const std::vector<QueueItem>&, sf::RenderTarget&, std::uint64_t, std::uint32_t = 0) const;
+        void applyScissor(sf::RenderTarget&, bool, sf::FloatRect) const;
+        //draws with SFML, recording the state it leaves applied to the target
+        void drawVertices(sf::RenderTarget&, const sf::Vertex*, std::size_t, sf::PrimitiveType, const sf::RenderStates&) const;
+
+        //the texture and blend mode SFML last applied during the current
+        //pass, restored after drawing instances so its state cache stays valid
+        struct TargetState final
+        {
+            const sf::Texture* texture = nullptr;
+            sf::BlendMode blendMode;
+            bool known = false;
+        };
+        mutable TargetState m_targetState;
+
+        //pending instances which share a texture, blend mode and
+        //depth write state, drawn with the core render backend
+        struct InstanceBatch;
+        mutable std::unique_ptr<InstanceBatch> m_instanceBatch;
+
+        //frames of the animations played on the GPU, held for the duration of a draw
+        mutable std::shared_ptr<const std::vector<sf::FloatRect>> m_frameTable;
+        mutable float m_frameTime;
+
+        bool canInstance(const sf::RenderStates&) const;
+        void addInstance(sf::RenderTarget&, const sf::RenderStates&, const xy::Drawable::InstanceData&, bool, std::array<std::int32_t, 4u>&, std::size_t&) const;
+        void flushInstances(sf::RenderTarget&) const;
+
+        //runs of drawables with batching enabled which share their
+        //render states, merged into a single draw call
+        struct MeshBatch;
+        mutable std::unique_ptr<MeshBatch> m_meshBatch;
+
+        void addMesh(sf::RenderTarget&, const sf::RenderStates&, const sf::Vertex*, std::size_t, sf::PrimitiveType,
+            const xy::Drawable::UniformBindings*, bool, std::array<std::int32_t, 4u>&, std::size_t&) const;
+        void flushMeshes(sf::RenderTarget&) const;
     };
 }
@@ -29,12 +29,29 @@ source distribution.
 
 #include "xyginext/ecs/System.hpp"
 
+#include <SFML/Graphics/Rect.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 namespace xy
 {
+    class Sprite;
+    struct SpriteAnimation;
+
     /*!
     \brief Sprite Animation system.
     Updates all active animations on entities which have Sprite and
     SpriteAnimation components.
+    Animation timers are stored in contiguous arrays and advanced in bulk
+    each frame, and only sprites whose frame changes are then visited.
+    Components are only read back when they have been modified, eg by
+    SpriteAnimation::play() or Sprite::setAnimations().
+    When a new frame is the same size as the previous one only the
+    texture coordinates of the sprite are updated. Looped animations
+    can also be played entirely on the GPU.
+    \see SpriteAnimation::setPlayback()
     */
     class XY_API SpriteAnimator final : public System
     {
@@ -44,6 +61,52 @@ namespace xy
         void process(float) override;
 
     private:
+        //precomputed from a Sprite::Animation when it starts playing
+        struct Timeline final
+        {
+            const sf::FloatRect* frames = nullptr;
+            std::uint32_t frameCount = 0;
+            std::uint32_t loopStart = 0;
+            bool looped = false;
+        };
+
+        //the last state read from the entity's components
+        struct Slot final
+        {
+            Entity entity;
+            const void* animations = nullptr;
+            std::uint32_t revision = 0;
+            std::size_t id = 0;
+            std::uint32_t frameID = 0;
+            bool playing = false;
+            bool gpuRequested = false;
+            float phase = 0.f;
+            bool instanced = false;
+            bool gpu = false; //currently playing on the GPU
+            Timeline timeline;
+        };
+
+        //indexed by slot
+        std::vector<Slot> m_slots;
+        std::vector<float> m_timers;
+        std::vector<float> m_frameTimes;
+        std::vector<float> m_active; //1 or 0 so timers can be updated without branching
+
+        std::vector<std::uint32_t> m_slotIndices; //indexed by entity
+        std::vector<std::uint32_t> m_expired;
+
+        //entity indices queued by the components' hooks. Swapped
+        //with m_syncList while being processed
+        std::shared_ptr<std::vector<std::uint32_t>> m_dirtyList;
+        std::vector<std::uint32_t> m_syncList;
+
+        void syncSlot(std::uint32_t);
+        void advanceFrame(std::uint32_t);
+
+        bool startGPUPlayback(Slot&, SpriteAnimation&, Sprite&);
+        void stopGPUPlayback(Slot&, SpriteAnimation&, Sprite&);
 
+        void onEntityAdded(Entity) override;
+        void onEntityRemoved(Entity) override;
     };
 }
@@ -43,7 +43,26 @@ namespace xy
 
         void process(float) override;
 
+        /*!
+        \brief Enables or disables sprite instancing.
+        When enabled, and the core render backend is active, sprites
+        are written to their Drawable as compact instance data rather
+        than four vertices, and are drawn by the RenderSystem with
+        instanced draw calls. Sprites whose Drawable has a shader are
+        never instanced. Enabled by default, has no effect with the
+        legacy render backend.
+        \see App::setRenderBackend()
+        */
+        void setInstancingEnabled(bool enabled) { m_instancingEnabled = enabled; }
+
+        /*!
+        \brief Returns true if sprite instancing is enabled
+        */
+        bool getInstancingEnabled() const { return m_instancingEnabled; }
+
     private:
+        bool m_instancingEnabled;
+
         void onEntityAdded(xy::Entity) override;
     };
 }
@@ -0,0 +1,84 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include "xyginext/ecs/System.hpp"
+#include "xyginext/ecs/components/TileMap.hpp"
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Transform.hpp>
+
+#include <vector>
+#include <array>
+
+namespace xy
+{
+    /*!
+    \brief Draws all entities with a TileMap and Transform component.
+    Each frame the chunks of every map are streamed in or out around the
+    viewable area of the Scene's render cameras (or the active camera if
+    there are none), and visible chunks are drawn with one draw call per
+    tileset. Tile maps are drawn by this system rather than the RenderSystem
+    so add the TileMapSystem to the Scene before the RenderSystem to draw
+    maps behind other drawables.
+    */
+    class XY_API TileMapSystem final : public xy::System, public sf::Drawable
+    {
+    public:
+        explicit TileMapSystem(xy::MessageBus&);
+
+        void process(float) override;
+
+        /*!
+        \brief Returns the number of chunk draw calls made the last time
+        this system was drawn
+        */
+        std::size_t getDrawCount() const { return m_lastDrawCount; }
+
+    private:
+        mutable sf::Shader m_shader;
+        mutable bool m_shaderLoaded;
+        mutable bool m_shaderFailed;
+
+        //double buffered for pipelined rendering, see App::setRenderThreadEnabled()
+        struct DrawItem final
+        {
+            std::shared_ptr<const TileMap::Chunk> chunk;
+            sf::Transform transform;
+            float time = 0.f;
+        };
+        std::array<std::vector<DrawItem>, 2u> m_drawItems;
+        std::vector<sf::FloatRect> m_streamingAreas;
+
+        mutable std::size_t m_lastDrawCount;
+
+        void streamChunks(TileMap&, const sf::Transform&) const;
+        void draw(sf::RenderTarget&, sf::RenderStates) const override;
+    };
+}
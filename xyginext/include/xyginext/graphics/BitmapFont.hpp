@@ -31,6 +31,13 @@ source distribution.
 
 #include <SFML/Graphics/Texture.hpp>
 
+#include <array>
+
+namespace sf
+{
+    class Image;
+}
+
 namespace xy
 {
     /*!
@@ -67,11 +74,18 @@ namespace xy
         */
         bool loadTextureFromFile(const std::string&);
 
+        /*!
+        \brief Creates the font texture from the given image.
+        \returns True on success else false on failure
+        */
+        bool loadTextureFromImage(const sf::Image&);
+
         /*!
         \brief returns the texture rect for the requested
-        character
+        character. Characters outside the supported range
+        return the rect of the space character.
         */
-        sf::FloatRect getGlyph(char) const;
+        const sf::FloatRect& getGlyph(char) const;
 
         /*!
         \brief Returns a pointer to the loaded texture
@@ -87,5 +101,10 @@ namespace xy
         sf::Texture m_texture;
         sf::Vector2f m_textureSize;
         sf::Vector2f m_charSize;
+
+        //ASCII 32 - 126, built when the texture is loaded
+        std::array<sf::FloatRect, 95> m_glyphs = {};
+
+        void updateGlyphs();
     };
 }
\ No newline at end of file
@@ -0,0 +1,107 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include "xyginext/Config.hpp"
+
+#include <cstdint>
+
+namespace xy
+{
+    /*!
+    \brief Adjusts a resolution scale in response to frame times.
+
+    Each frame the controller is given the time taken to render the
+    previous frame. When the average frame time exceeds the target
+    the scale is reduced, and when there is headroom it is increased
+    again, within the given limits. As a scene's fill rate cost is
+    proportional to the square of the scale, changes are made in
+    proportion to how far the frame time is from the target.
+
+    When frames are limited by vertical sync the frame time never drops
+    below the target, so after a period of stable frames the controller
+    will also probe a step higher, backing off again should that cause
+    frames to be missed.
+
+    A Scene with post processes uses this to scale its scene buffer
+    when dynamic resolution is enabled, but the controller can be used
+    on its own, for example to drive the resolution of a render texture.
+    */
+    class XY_API DynamicResolution final
+    {
+    public:
+        struct Settings final
+        {
+            float minScale = 0.5f; //!< Smallest scale which may be used
+            float maxScale = 1.f; //!< Largest scale which may be used
+            float targetFrameTime = 1.f / 60.f; //!< Frame time, in seconds, to try to maintain
+            float step = 0.05f; //!< The scale is always a multiple of this
+        };
+
+        DynamicResolution();
+        explicit DynamicResolution(const Settings&);
+
+        /*!
+        \brief Sets new limits for the controller.
+        The current scale is clamped to the new limits
+        */
+        void setSettings(const Settings&);
+
+        /*!
+        \brief Returns the current settings
+        */
+        const Settings& getSettings() const { return m_settings; }
+
+        /*!
+        \brief Adds a frame time sample
+        \param frameTime Time taken, in seconds, to render the last frame
+        \returns The resolution scale to use for the next frame
+        */
+        float update(float frameTime);
+
+        /*!
+        \brief Returns the current scale
+        */
+        float getScale() const { return m_scale; }
+
+        /*!
+        \brief Discards the frame time history and resets the scale
+        to the maximum allowed by the current settings
+        */
+        void reset();
+
+    private:
+        Settings m_settings;
+        float m_scale;
+        float m_averageFrameTime;
+        std::uint32_t m_cooldown;
+        std::uint32_t m_stableFrames;
+
+        void setScale(float);
+    };
+}
@@ -0,0 +1,182 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include "xyginext/Config.hpp"
+
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Window/GlResource.hpp>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sf
+{
+    class RenderTarget;
+}
+
+namespace xy
+{
+    /*!
+    \brief Captures frames without stalling the renderer.
+
+    Rather than reading pixels back immediately, which waits for the GPU
+    to finish drawing, the contents of a render target are copied into
+    one of a small ring of pixel buffer objects. The buffers are mapped
+    a frame or two later once the copy has completed, and the pixels are
+    handed to a background thread which encodes and writes them to disk.
+
+    The App owns an instance which captures the window each frame, after
+    the App's draw() function and before the Console and other ImGui
+    windows are drawn. This is used for screenshots (F5) and for
+    recording frame sequences. Other instances may be created to capture
+    any RenderTexture, for example a scene buffer.
+
+    If the ring is full, or the writer thread falls too far behind,
+    frames are dropped rather than waited for. If pixel buffer objects
+    are unsupported frames are read synchronously, so capturing will
+    affect the frame rate.
+    */
+    class XY_API FrameCapture final : private sf::GlResource
+    {
+    public:
+        enum class Format
+        {
+            PNG, //!< Each frame is saved as a PNG image
+            Raw  //!< Each frame is written as raw, top-down RGBA8 pixels
+        };
+
+        FrameCapture();
+        ~FrameCapture();
+
+        FrameCapture(const FrameCapture&) = delete;
+        FrameCapture(FrameCapture&&) = delete;
+        FrameCapture& operator = (const FrameCapture&) = delete;
+        FrameCapture& operator = (FrameCapture&&) = delete;
+
+        /*!
+        \brief Requests that the next captured frame be saved as a PNG
+        \param path Path of the file to write
+        */
+        void saveScreenshot(const std::string& path);
+
+        /*!
+        \brief Starts recording a sequence of frames
+        \param directory Path to an existing directory in which to write the frames.
+        Frames are named frame_000000.png or, for raw frames, frame_000000_WxH.rgba
+        where W and H are the frame size
+        \param format The format in which to write each frame
+        \param interval Only every nth frame is recorded
+        */
+        void startRecording(const std::string& directory, Format format = Format::PNG, std::uint32_t interval = 1);
+
+        /*!
+        \brief Stops recording. Any frames already captured are still written
+        */
+        void stopRecording();
+
+        /*!
+        \brief Returns true if currently recording
+        */
+        bool isRecording() const { return m_recording; }
+
+        /*!
+        \brief Captures the current contents of the given render target if
+        a screenshot has been requested or recording is active, and passes
+        on any earlier captures which have completed. This should be called
+        once per frame, from the thread which is rendering, after drawing
+        to the target has finished.
+        */
+        void capture(sf::RenderTarget&);
+
+        /*!
+        \brief Completes any pending captures, waiting for them if necessary,
+        and waits for all frames to be written. Must be called from the thread
+        which is rendering, with the context used for capturing available.
+        */
+        void flush();
+
+        /*!
+        \brief Returns the number of frames which have been dropped since
+        recording was started
+        */
+        std::uint32_t getDroppedFrameCount() const { return m_droppedFrames; }
+
+    private:
+        struct Job final
+        {
+            std::vector<std::uint8_t> pixels;
+            sf::Vector2u size;
+            std::string path;
+            Format format = Format::PNG;
+        };
+
+        struct Slot final
+        {
+            std::uint32_t buffer = 0;
+            std::size_t bufferSize = 0;
+            void* fence = nullptr;
+            std::uint32_t age = 0;
+            bool pending = false;
+            Job job;
+        };
+        static constexpr std::size_t SlotCount = 3;
+        std::array<Slot, SlotCount> m_slots = {};
+        std::size_t m_nextSlot;
+
+        std::mutex m_settingsMutex;
+        std::string m_screenshotPath;
+        std::string m_recordingDirectory;
+        Format m_recordingFormat;
+        std::uint32_t m_recordingInterval;
+        std::uint32_t m_frameCount;
+        std::uint32_t m_recordedCount;
+        std::atomic<bool> m_recording;
+        std::atomic<std::uint32_t> m_droppedFrames;
+
+        std::thread m_writerThread;
+        std::mutex m_writerMutex;
+        std::condition_variable m_writerCondition;
+        std::deque<Job> m_jobs;
+        std::size_t m_activeJobs;
+        bool m_writerQuit;
+
+        bool nextCapture(Job&);
+        void readPixels(Job&&);
+        void resolve(bool wait);
+        void submit(Job&&);
+        void writerLoop();
+    };
+}
@@ -0,0 +1,181 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include "xyginext/Config.hpp"
+
+#include <SFML/Graphics/RenderTexture.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace sf
+{
+    class Image;
+}
+
+namespace xy
+{
+    class Scene;
+    class MessageBus;
+
+    /*!
+    \brief Renders a Scene offscreen for automated image comparisons and benchmarks.
+
+    The harness draws a Scene into a RenderTexture without requiring an App
+    or a window, so it can be used from a command line tool or test runner.
+    On machines without a GPU a software implementation such as Mesa's
+    llvmpipe can provide the context, for example by running under Xvfb
+    with LIBGL_ALWAYS_SOFTWARE set.
+
+    Each frame the scene is optionally updated by a script function, then
+    updated with a fixed timestep and drawn. Selected frames can be compared
+    against golden images stored on disk, and the CPU and GPU times of each
+    frame are measured along with the GPU time of each pass reported by
+    RenderStats, such as the RenderSystem, ParticleSystem and post processes.
+
+    Note that as there is no App, the Scene is always rendered with the
+    Legacy backend, and systems which rely on the window, such as the
+    UISystem, should not be used.
+    \code
+    xy::MessageBus mb;
+    xy::RenderHarness harness({ 1280, 720 });
+    xy::Scene scene(mb);
+    //add systems and entities...
+
+    harness.addGoldenImage(59, "golden/particles.png");
+    auto result = harness.run(scene, mb, 60);
+    \endcode
+    */
+    class XY_API RenderHarness final
+    {
+    public:
+        /*!
+        \brief Image comparison for a single frame
+        */
+        struct Golden final
+        {
+            std::size_t frame = 0;
+            std::string path;
+            std::uint8_t threshold = 8; //!< Channel difference above which a pixel is considered different
+            float maxDifference = 0.001f; //!< Largest fraction of pixels which may differ
+        };
+
+        /*!
+        \brief Average GPU time of a named pass, in milliseconds.
+        Passes with the same name drawn more than once in a frame,
+        such as each post process, are summed.
+        */
+        struct PassTime final
+        {
+            std::string name;
+            float gpuTime = 0.f;
+        };
+
+        struct Result final
+        {
+            std::size_t frameCount = 0;
+            float cpuFrameTime = 0.f; //!< Average CPU time per frame, including waiting for the GPU, in ms
+            float gpuFrameTime = -1.f; //!< Average GPU time per frame in ms, or -1 if unavailable
+            std::vector<PassTime> passTimes;
+            std::vector<std::size_t> failedFrames; //!< Frames which didn't match their golden image
+            bool passed = true; //!< True if all golden image comparisons passed
+        };
+
+        /*!
+        \brief Constructor.
+        \param size Size of the render texture to which the Scene is drawn
+        */
+        explicit RenderHarness(sf::Vector2u size);
+        ~RenderHarness();
+
+        /*!
+        \brief Returns false if the render texture could not be created
+        */
+        bool isValid() const { return m_valid; }
+
+        /*!
+        \brief Adds a golden image with which to compare a frame
+        */
+        void addGoldenImage(const Golden&);
+
+        /*!
+        \brief Adds a golden image with which to compare a frame, using
+        the default tolerance
+        */
+        void addGoldenImage(std::size_t frame, const std::string& path);
+
+        /*!
+        \brief When enabled the golden images are overwritten with the
+        output of the frames, rather than compared
+        */
+        void setUpdateGoldenImages(bool update) { m_updateGolden = update; }
+
+        /*!
+        \brief Sets the fixed time step used to update the scene each frame.
+        Defaults to 1/60 second
+        */
+        void setTimestep(float dt) { m_timestep = dt; }
+
+        /*!
+        \brief Runs the given number of frames
+        \param scene The Scene to render
+        \param messageBus The MessageBus used by the Scene. Messages are
+        forwarded to the Scene each frame as the App would
+        \param frameCount Number of frames to render
+        \param script Optional function called with the frame number before
+        each frame is updated, used to manipulate the scene
+        */
+        Result run(Scene& scene, MessageBus& messageBus, std::size_t frameCount,
+            const std::function<void(std::size_t, Scene&)>& script = {});
+
+        /*!
+        \brief Returns the output of the last rendered frame
+        */
+        const sf::Texture& getTexture() const { return m_target.getTexture(); }
+
+        /*!
+        \brief Compares two images
+        \param threshold Channel difference above which a pixel is considered different
+        \returns The fraction of pixels which differ, or 1 if the images are
+        different sizes
+        */
+        static float compareImages(const sf::Image&, const sf::Image&, std::uint8_t threshold);
+
+    private:
+        sf::RenderTexture m_target;
+        bool m_valid;
+        bool m_updateGolden;
+        float m_timestep;
+        std::vector<Golden> m_goldenImages;
+
+        bool checkGolden(const Golden&);
+    };
+}
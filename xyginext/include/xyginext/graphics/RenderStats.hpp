@@ -0,0 +1,159 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include "xyginext/Config.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace xy
+{
+    /*!
+    \brief Collects per-frame and per-pass rendering statistics.
+
+    Each frame the number of draw calls, vertices and GL state changes
+    are counted, and where GL_ARB_timer_query is supported the GPU time
+    taken to render the frame is measured. When pass timing is enabled
+    the time taken by each render system, particle system and post
+    process, as well as the ImGui pass, is also measured individually.
+
+    To avoid stalling the pipeline results are not read until several
+    frames after they were recorded, so the statistics returned are
+    always a few frames old. Results which are still not available by
+    then are dropped rather than waited for.
+
+    The statistics are displayed in the Render tab of the Console.
+    */
+    class XY_API RenderStats final
+    {
+    public:
+        /*!
+        \brief Statistics for a single pass
+        */
+        struct Pass final
+        {
+            std::string name;
+            std::uint32_t depth = 0; //!< Nesting depth of the pass
+            float gpuTime = -1.f; //!< GPU time in milliseconds, or -1 if unavailable
+            std::uint32_t drawCalls = 0; //!< Includes draw calls of nested passes
+            std::uint32_t vertexCount = 0; //!< Includes vertices of nested passes
+        };
+
+        /*!
+        \brief Statistics for a complete frame
+        */
+        struct Frame final
+        {
+            float gpuTime = -1.f; //!< GPU time in milliseconds, or -1 if unavailable
+            std::uint32_t drawCalls = 0;
+            std::uint32_t vertexCount = 0;
+            std::uint32_t stateChanges = 0;
+            std::uint32_t skippedStateChanges = 0;
+            std::vector<Pass> passes;
+        };
+
+        /*!
+        \brief Measures a named pass for the lifetime of the scope.
+        Scopes may be nested, and are ignored unless pass timing is
+        enabled. The name must remain valid until the results are
+        read back, so should usually be a string literal.
+        */
+        class XY_API Scope final
+        {
+        public:
+            explicit Scope(const char* name);
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            Scope(Scope&&) = delete;
+            Scope& operator = (const Scope&) = delete;
+            Scope& operator = (Scope&&) = delete;
+
+        private:
+            bool m_active;
+        };
+
+        /*!
+        \brief Enables or disables timing of individual passes.
+        The frame time is always measured when timer queries are
+        available. Disabled by default.
+        */
+        static void setPassTimingEnabled(bool);
+
+        /*!
+        \brief Returns true if pass timing is enabled
+        */
+        static bool getPassTimingEnabled();
+
+        /*!
+        \brief Returns true if the current GL context supports timer queries.
+        If this returns false GPU times are reported as -1, but the draw call,
+        vertex and state change counts are still available.
+        */
+        static bool isTimerAvailable();
+
+        /*!
+        \brief Returns a copy of the statistics of the most recently
+        resolved frame.
+        */
+        static Frame getLastFrame();
+
+        /*!
+        \brief Returns the GPU time of the most recently resolved frame
+        in seconds, or a negative value if unavailable.
+        */
+        static float getGPUFrameTime();
+
+        /*!
+        \brief Records a draw call with the given number of vertices.
+        This is used by xygine's renderers, custom renderers can call
+        this so that their draw calls are included in the statistics.
+        Must be called from the thread which is rendering.
+        */
+        static void addDrawCall(std::uint32_t vertexCount);
+
+    private:
+        friend class App;
+        friend class RenderHarness;
+        static void beginFrame();
+        static void endFrame();
+
+        //waits for and resolves any frames still pending
+        static void flush();
+
+        //resolves any pending frames and deletes the queries
+        //of the active context, before it is destroyed
+        static void shutdown();
+
+        //called with each frame as it is resolved
+        static void setFrameCallback(const std::function<void(const Frame&)>&);
+    };
+}
@@ -0,0 +1,231 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include "xyginext/Config.hpp"
+
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/String.hpp>
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <map>
+#include <tuple>
+
+namespace sf
+{
+    class Image;
+    class Font;
+}
+
+namespace xy
+{
+    class Sprite;
+    class SpriteSheet;
+
+    /*!
+    \brief Packs multiple images into a small number of large texture pages.
+    Drawables which share a texture can be drawn without a texture switch, so
+    packing many small textures such as individual sprite sheets or glyph pages
+    into a few larger textures can greatly reduce the number of state changes
+    made when rendering a scene.
+
+    Regions are added incrementally, and are packed into the first page with
+    enough space available. When all pages are full and the maximum page count
+    has been reached the least recently used page is evicted, and any regions
+    it contained are invalidated. Regions may also be explicitly released, and
+    a page is cleared for reuse once all of its regions are released.
+
+    Sprite components created from a texture or SpriteSheet which has been added
+    to the atlas can be remapped with remap(), which updates the texture, texture
+    rectangle and all animation frames of the sprite. Sprites are not remapped
+    automatically, remap() should be called on each sprite once it is created.
+
+    Glyph pages can be packed for use with custom vertex arrays, but Text components
+    continue to draw from their font's own texture. Particle emitters always sample
+    their whole texture so are not supported.
+
+    The atlas must live at least as long as any Sprite or Drawable using its pages.
+    Source textures are identified by their address, so releaseTexture() should be
+    called before a texture which was added is destroyed.
+    */
+    class XY_API TextureAtlas final
+    {
+    public:
+        /*!
+        \brief Describes the location of a packed image within the atlas
+        */
+        struct Region final
+        {
+            const sf::Texture* texture = nullptr; //!< the page texture containing the region
+            sf::FloatRect textureRect; //!< the area of the page containing the image
+            std::size_t page = 0;
+            std::uint32_t generation = 0; //!< the page generation when the region was packed
+        };
+
+        /*!
+        \brief Constructor.
+        \param pageSize Width and height of each page in pixels. This is clamped
+        to sf::Texture::getMaximumSize()
+        \param maxPages Maximum number of pages to create before the least recently
+        used page is evicted to make room for new images.
+        */
+        explicit TextureAtlas(std::uint32_t pageSize = 2048, std::size_t maxPages = 4);
+
+        ~TextureAtlas();
+        TextureAtlas(const TextureAtlas&) = delete;
+        TextureAtlas(TextureAtlas&&) = delete;
+        TextureAtlas& operator = (const TextureAtlas&) = delete;
+        TextureAtlas& operator = (TextureAtlas&&) = delete;
+
+        /*!
+        \brief Adds an image to the atlas with the given name.
+        If an image with this name already exists the existing region is returned.
+        \param name Unique name used to look up the region later
+        \param image Image containing the pixel data to pack
+        \param subRect Optional area of the image to pack. Defaults to the entire image
+        \returns The region containing the image. If the image could not be packed
+        the returned region will have a nullptr texture.
+        */
+        Region addImage(const std::string& name, const sf::Image& image, sf::IntRect subRect = {});
+
+        /*!
+        \brief Adds the given texture to the atlas.
+        Note that this reads the texture back from the GPU so should
+        be done during loading, not at run time. Sprites which use
+        this texture can then be remapped to the atlas with remap()
+        */
+        Region addTexture(const std::string& name, const sf::Texture& texture);
+
+        /*!
+        \brief Packs all sprite bounds and animation frames found in the
+        given SpriteSheet.
+        The area of the sheet's texture covering every frame is packed as a
+        single region, so the sheet is never split between pages and is
+        always evicted as a whole. If it has been evicted calling this again
+        packs it again. Sprites returned from the sheet can then be remapped
+        with remap().
+        \returns true if all frames were successfully packed.
+        */
+        bool addSpriteSheet(const SpriteSheet& sheet);
+
+        /*!
+        \brief Rasterises the given characters with the font at the given
+        character size and packs the resulting glyph page.
+        Glyph texture rectangles returned by sf::Font::getGlyph() are relative
+        to the font page, so should be offset by the top left corner of the
+        returned region when building custom vertex arrays.
+        */
+        Region addGlyphPage(const std::string& name, const sf::Font& font, std::uint32_t charSize, const sf::String& characters);
+
+        /*!
+        \brief Returns the region with the given name, if it exists.
+        The returned region has a nullptr texture if it was not found
+        or has since been evicted.
+        */
+        Region getRegion(const std::string& name);
+
+        /*!
+        \brief Returns true if the given region still refers to valid
+        data in the atlas, ie its page has not been evicted since it
+        was packed.
+        */
+        bool isValid(const Region& region) const;
+
+        /*!
+        \brief Updates the given sprite to use the texture page and texture rectangle
+        of its packed source, along with any animation frames.
+        The sprite's current texture must have been previously added with addTexture()
+        or addSpriteSheet()
+        \returns false if any part of the sprite could not be found in the atlas,
+        in which case the sprite is left unmodified.
+        */
+        bool remap(Sprite& sprite);
+
+        /*!
+        \brief Releases all regions packed from the given texture by addTexture()
+        or addSpriteSheet(). This should be called before the texture is destroyed,
+        else a new texture created at the same address may be remapped to its regions.
+        */
+        void releaseTexture(const sf::Texture& texture);
+
+        /*!
+        \brief Releases the region with the given name.
+        When all regions on a page are released the page is cleared
+        and its space becomes available for new images.
+        */
+        void release(const std::string& name);
+
+        /*!
+        \brief Returns the number of pages currently in use
+        */
+        std::size_t getPageCount() const { return m_pages.size(); }
+
+        /*!
+        \brief Returns a pointer to the texture of the given page, or
+        nullptr if the page doesn't exist.
+        */
+        const sf::Texture* getPageTexture(std::size_t page) const;
+
+        /*!
+        \brief Sets all page textures smooth or not.
+        */
+        void setSmooth(bool smooth);
+
+    private:
+
+        struct Page;
+        std::vector<std::unique_ptr<Page>> m_pages;
+
+        std::uint32_t m_pageSize;
+        std::size_t m_maxPages;
+        std::uint64_t m_useCounter;
+        bool m_smooth;
+
+        struct Entry final
+        {
+            std::size_t page = 0;
+            std::uint32_t generation = 0;
+            sf::IntRect rect;
+        };
+        std::unordered_map<std::string, Entry> m_entries;
+
+        //maps a source texture and sub-rect to the name of
+        //its packed region, so sprites can be remapped
+        using FrameKey = std::tuple<const sf::Texture*, std::int32_t, std::int32_t, std::int32_t, std::int32_t>;
+        std::map<FrameKey, std::string> m_frames;
+
+        bool pack(const std::string& name, const sf::Image& image, sf::IntRect subRect, Region& dst);
+        void evict(std::size_t page);
+        Region toRegion(const Entry&);
+        std::string addFrame(const sf::Texture*, sf::IntRect);
+    };
+}
@@ -32,7 +32,6 @@ source distribution.
 #include "xyginext/graphics/postprocess/PostProcess.hpp"
 #include "xyginext/resources/ShaderResource.hpp"
 
-#include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Graphics/Shader.hpp>
 
 #include <array>
@@ -56,14 +55,12 @@ namespace xy
         void apply(const sf::RenderTexture&, sf::RenderTarget&) override;
 
     private:
-        using RenderTextureArray = std::array<sf::RenderTexture, 2>;
+        using RenderTextureArray = std::array<sf::RenderTexture*, 2>;
 
         ShaderResource m_shaderResource;
-        sf::RenderTexture m_brightnessTexture;
-        RenderTextureArray m_firstPassTextures;
-        RenderTextureArray m_secondPassTextures;
 
-        void initTextures(const sf::Vector2u&);
+        RenderTextureArray acquireTargets(sf::Vector2u);
+        void releaseTargets(const RenderTextureArray&);
         void filterBright(const sf::RenderTexture&, sf::RenderTexture&);
         void blurMultipass(RenderTextureArray&);
         void blur(const sf::RenderTexture&, sf::RenderTexture&, const sf::Vector2f&);
@@ -30,8 +30,6 @@ source distribution.
 #include "xyginext/graphics/postprocess/PostProcess.hpp"
 
 #include <SFML/Graphics/Shader.hpp>
-#include <SFML/Graphics/RenderTexture.hpp>
-#include <SFML/System/Clock.hpp>
 
 #include <array>
 
@@ -52,6 +50,18 @@ namespace xy
         \brief Applies the effect to the screen
         */
         void apply(const sf::RenderTexture&, sf::RenderTarget&) override;
+
+        /*!
+        \brief Animates the blur amount when enabling or disabling the effect
+        */
+        void update(float) override;
+
+        /*!
+        \brief Returns true once the effect has been disabled and
+        faded out completely, so that the Scene can skip it.
+        */
+        bool isBypassed() const override;
+
         /*!
         \brief Enables or disables the blur effect.
         By default this is disabled, so call this at least once
@@ -68,7 +78,6 @@ namespace xy
     private:
 
         float m_amount;
-        sf::Clock m_clock;
 
         bool m_enabled;
         float m_fadeSpeed;
@@ -76,11 +85,10 @@ namespace xy
         sf::Shader m_downsampleShader;
         sf::Shader m_outShader;
 
-        using TexturePair = std::array<sf::RenderTexture, 2u>;
-        TexturePair m_firstPassTextures;
-        TexturePair m_secondPassTextures;
+        using TexturePair = std::array<sf::RenderTexture*, 2u>;
+        TexturePair acquireTargets(sf::Vector2u);
+        void releaseTargets(const TexturePair&);
 
-        void initTextures(sf::Vector2u);
         void blurMultipass(TexturePair&);
         void blur(const sf::RenderTexture&, sf::RenderTexture&, const sf::Vector2f&);
         void downSample(const sf::RenderTexture&, sf::RenderTexture&);
@@ -30,7 +30,6 @@ source distribution.
 #include "xyginext/graphics/postprocess/PostProcess.hpp"
 
 #include <SFML/Graphics/Shader.hpp>
-#include <SFML/Graphics/RenderTexture.hpp>
 
 namespace xy
 {
@@ -48,7 +47,5 @@ namespace xy
     private:
         sf::Shader m_fxShader;
         sf::Shader m_passThroughShader;
-
-        sf::RenderTexture m_buffer;
     };
 }
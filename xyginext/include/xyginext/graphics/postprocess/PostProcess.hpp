@@ -44,6 +44,16 @@ namespace sf
     class Shader;
 }
 
+namespace xy
+{
+    class RenderTargetPool;
+
+    namespace Detail
+    {
+        class VertexArray;
+    }
+}
+
 namespace xy
 {
     /*!
@@ -59,8 +69,8 @@ namespace xy
 
         using Ptr = std::unique_ptr<PostProcess>;
 
-        PostProcess() = default;
-        virtual ~PostProcess() = default;
+        PostProcess();
+        virtual ~PostProcess();
         PostProcess(const PostProcess&) = delete;
         PostProcess(PostProcess&&) = delete;
         PostProcess& operator = (const PostProcess&) = delete;
@@ -86,10 +96,39 @@ namespace xy
         This optionally overridable function passes in the current frame time
         and allows updating those parameters. This is called automatically
         when the effect is added to a Scene, but will need to be called manually
-        when using the effect on its own.
+        when using the effect on its own. When pipelined rendering is active
+        the Scene calls this from the render thread just before the effect
+        is drawn, with the time elapsed since it was last called.
+        \see App::setRenderThreadEnabled()
         */
         virtual void update(float) {}
 
+        /*!
+        \brief Returns true if applying the effect in its current state
+        would leave the scene unchanged.
+        Effects which can be disabled, such as a blur with zero strength,
+        should override this so that the Scene can skip them entirely
+        rather than spend a full screen pass copying the image.
+        */
+        virtual bool isBypassed() const { return false; }
+
+        /*!
+        \brief Sets the resolution at which this effect is processed,
+        relative to the size of the source texture.
+        This scales any intermediate targets used by the effect and,
+        when the effect is added to a Scene, the target it is output to,
+        which is then upscaled by the following pass. Reducing this trades
+        quality for fill rate, which can be worthwhile on high resolution
+        displays.
+        \param scale A value between 0.1 and 1. Defaults to 1
+        */
+        void setResolutionScale(float scale);
+
+        /*!
+        \brief Returns the current resolution scale of the effect
+        */
+        float getResolutionScale() const { return m_resolutionScale; }
+
         /*
         \brief Used by xygine to update the post process should the buffer be resized.
         This should not be called by the user.
@@ -97,7 +136,28 @@ namespace xy
         void resizeBuffer(std::int32_t w, std::int32_t h);
 
     protected:
-        static void applyShader(const sf::Shader&, sf::RenderTarget&);
+        /*!
+        \brief Draws a full screen quad to the given target using the given shader.
+        If the effect has been marked as using core profile shaders the quad
+        is drawn with a vertex array object, else it is drawn with SFML.
+        */
+        void applyShader(const sf::Shader&, sf::RenderTarget&);
+
+        /*!
+        \brief Marks the shaders used by this effect as GLSL 330 core shaders.
+        This should only be set when App::getRenderBackend() returns
+        RenderBackend::Core, in which case the vertex shader must output
+        the texture coordinates as 'out vec2 v_texCoord' from a triangle
+        strip of four vertices built from gl_VertexID. Effects which
+        provide only legacy shaders are still drawn correctly with the
+        core backend.
+        */
+        void setCoreProfile(bool core) { m_coreProfile = core; }
+
+        /*!
+        \brief Returns true if this effect has been marked as using core shaders
+        */
+        bool isCoreProfile() const { return m_coreProfile; }
 
         /*!
         \brief Called when the main output buffer resized.
@@ -111,7 +171,37 @@ namespace xy
         */
         sf::Vector2i getBufferSize() const { return m_bufferSize; }
 
+        /*!
+        \brief Acquires a transient render target for an intermediate pass.
+        \param size The size of the target before the effect's resolution
+        scale is applied, usually a fraction of the source texture size.
+        \param smooth Whether the target texture should be smoothed.
+        Targets are shared with other passes and effects in the Scene so
+        they are cleared to transparent when acquired, and each target must
+        be returned with releaseTarget() as soon as the pass which reads
+        from it has completed.
+        */
+        sf::RenderTexture& acquireTarget(sf::Vector2u size, bool smooth = true);
+
+        /*!
+        \brief Returns a target acquired with acquireTarget() so that it
+        can be reused by subsequent passes.
+        */
+        void releaseTarget(const sf::RenderTexture&);
+
     private:
+        friend class Scene;
+
         sf::Vector2i m_bufferSize;
+        bool m_coreProfile;
+        float m_resolutionScale;
+
+        //points to the owning Scene's pool, else the
+        //effect creates its own when used stand-alone
+        RenderTargetPool* m_targetPool;
+        std::unique_ptr<RenderTargetPool> m_ownTargetPool;
+        std::unique_ptr<Detail::VertexArray> m_vertexArray;
+
+        void applyCoreShader(const sf::Shader&, sf::RenderTarget&);
     };
 }
@@ -0,0 +1,120 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include "xyginext/Config.hpp"
+
+#include <SFML/System/Vector2.hpp>
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+namespace sf
+{
+    class RenderTexture;
+}
+
+namespace xy
+{
+    /*!
+    \brief Pool of transient render textures shared by post process effects.
+
+    Rather than each post process owning its own intermediate buffers,
+    targets are acquired from the pool for the duration of a pass and
+    then released so that they can be handed out again. This way a
+    target used by one pass (or effect) is aliased by the next pass
+    which requests a target of the same size, keeping the number of
+    buffers in memory to the minimum needed at any one time.
+
+    A Scene owns a pool which is shared by all of its post process
+    effects. Targets which have not been acquired for a number of frames,
+    for example after the window has been resized, are destroyed when
+    endFrame() is called.
+    */
+    class XY_API RenderTargetPool final
+    {
+    public:
+        RenderTargetPool() = default;
+        ~RenderTargetPool();
+
+        RenderTargetPool(const RenderTargetPool&) = delete;
+        RenderTargetPool(RenderTargetPool&&) = delete;
+        RenderTargetPool& operator = (const RenderTargetPool&) = delete;
+        RenderTargetPool& operator = (RenderTargetPool&&) = delete;
+
+        /*!
+        \brief Returns a render texture of the given size which is not
+        currently in use, creating a new one if none are available.
+        \param size Size of the target in pixels
+        \param smooth Whether or not the target texture should be smoothed
+        The contents of the returned texture are undefined. The target
+        remains in use until it is passed to release()
+        */
+        sf::RenderTexture& acquire(sf::Vector2u size, bool smooth = true);
+
+        /*!
+        \brief Returns a target acquired with acquire() to the pool
+        */
+        void release(const sf::RenderTexture&);
+
+        /*!
+        \brief Destroys any targets which have not been acquired for
+        a number of frames. This is called by the Scene once all
+        post processes have been applied.
+        */
+        void endFrame();
+
+        /*!
+        \brief Destroys all targets which are not currently in use
+        */
+        void clear();
+
+        /*!
+        \brief Returns the number of targets currently allocated by the pool
+        */
+        std::size_t getTargetCount() const { return m_targets.size(); }
+
+        /*!
+        \brief Returns the approximate video memory, in bytes, used
+        by the targets currently allocated by the pool
+        */
+        std::size_t getMemoryUsage() const;
+
+    private:
+        struct Target final
+        {
+            std::unique_ptr<sf::RenderTexture> texture;
+            sf::Vector2u size;
+            bool smooth = true;
+            bool inUse = false;
+            std::uint32_t unusedFrames = 0;
+        };
+        std::vector<Target> m_targets;
+    };
+}
@@ -34,6 +34,9 @@ namespace SFML
     void Update(const sf::Vector2i& mousePos, const sf::Vector2f& displaySize, sf::Time dt);
 
     void Render(sf::RenderTarget& target);
+    // renders the draw data from a previous call to ImGui::Render(), which
+    // allows the draw data to be created and rendered on different threads
+    void RenderDrawData(sf::RenderTarget& target);
 
     void Shutdown();
 
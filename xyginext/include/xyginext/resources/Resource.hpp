@@ -104,6 +104,11 @@ namespace xy
         requested resource fail for some reason.
         */
         virtual std::unique_ptr<T> errorHandle() = 0;
+
+        /*!
+        \brief Returns all the loaded resources, mapped by path
+        */
+        const std::unordered_map<std::string, std::unique_ptr<T>>& getResources() const { return m_resources; }
     private:
         std::unordered_map<std::string, std::unique_ptr<T>> m_resources;
     };
@@ -153,6 +158,7 @@ namespace xy
     {
     public:
         FontResource();
+        ~FontResource();
     private:
         sf::Font m_font;
         std::unique_ptr<sf::Font> errorHandle() override;
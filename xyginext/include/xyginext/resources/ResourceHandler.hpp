@@ -66,6 +66,9 @@ namespace xy
         
         //Constructor
         ResourceHandler();
+
+        //Releases any text data cached for the loaded fonts
+        ~ResourceHandler();
         
         /*!
         \brief Load a resource
@@ -0,0 +1,109 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include "xyginext/ecs/components/TileMap.hpp"
+#include "xyginext/resources/Resource.hpp"
+
+#include <tmxlite/Map.hpp>
+#include <tmxlite/TileLayer.hpp>
+
+//NOTE xyginext does not link against tmxlite, these functions are
+//compiled as part of the project which includes this header, which
+//should therefore link tmxlite itself.
+
+namespace xy
+{
+    namespace Util
+    {
+        /*!
+        \brief Functions for loading tmx map data with tmxlite
+        */
+        namespace Tmx
+        {
+            /*!
+            \brief Loads a tile layer of a tmx map into a TileMap component.
+            Tileset textures are loaded through the given TextureResource so
+            they are shared between layers using the same tileset. Infinite
+            maps are not supported, their tiles can be supplied with a
+            TileMap::ChunkLoader instead.
+            \returns false if the layer contains no tiles, else true
+            */
+            inline bool loadTileLayer(TileMap& tileMap, const tmx::Map& map, const tmx::TileLayer& layer, TextureResource& textures)
+            {
+                const auto& tiles = layer.getTiles();
+                if (tiles.empty())
+                {
+                    return false;
+                }
+
+                const auto tileCount = map.getTileCount();
+                const auto tileSize = map.getTileSize();
+                tileMap.setSize({ tileCount.x, tileCount.y }, { static_cast<float>(tileSize.x), static_cast<float>(tileSize.y) });
+                tileMap.setOpacity(layer.getOpacity());
+
+                for (const auto& tileset : map.getTilesets())
+                {
+                    TileMap::Tileset ts;
+                    ts.texture = &textures.get(tileset.getImagePath());
+                    ts.firstID = tileset.getFirstGID();
+                    ts.tileCount = tileset.getTileCount();
+                    ts.columnCount = tileset.getColumnCount();
+                    ts.tileSize = { tileset.getTileSize().x, tileset.getTileSize().y };
+                    ts.spacing = tileset.getSpacing();
+                    ts.margin = tileset.getMargin();
+
+                    //tile IDs are local to the tileset, animation frames are global
+                    for (const auto& tile : tileset.getTiles())
+                    {
+                        if (!tile.animation.frames.empty())
+                        {
+                            auto& animation = ts.animations.emplace_back();
+                            animation.tileID = tile.ID + tileset.getFirstGID();
+                            for (const auto& frame : tile.animation.frames)
+                            {
+                                animation.frames.push_back({ frame.tileID, static_cast<float>(frame.duration) / 1000.f });
+                            }
+                        }
+                    }
+                    tileMap.addTileset(ts);
+                }
+
+                std::vector<TileMap::Tile> mapTiles(tiles.size());
+                for (auto i = 0u; i < tiles.size(); ++i)
+                {
+                    mapTiles[i].ID = tiles[i].ID;
+                    mapTiles[i].flipFlags = tiles[i].flipFlags;
+                }
+                tileMap.setTiles(std::move(mapTiles));
+
+                return true;
+            }
+        }
+    }
+}
@@ -30,6 +30,7 @@ source distribution.
 #include "xyginext/core/Console.hpp"
 #include "xyginext/core/ConfigFile.hpp"
 #include "xyginext/core/FileSystem.hpp"
+#include "xyginext/graphics/RenderStats.hpp"
 #include "xyginext/detail/Operators.hpp"
 #include "xyginext/gui/GuiClient.hpp"
 
@@ -38,6 +39,8 @@ source distribution.
 #include "../imgui/imgui_internal.h"
 
 #include "../detail/GLCheck.hpp"
+#include "../detail/DistanceField.hpp"
+#include "../detail/GLStateCache.hpp"
 #ifdef _MSC_VER
 #ifdef XY_DEBUG
 //prints callstack
@@ -86,6 +89,23 @@ namespace
 
     sf::Color clearColour(0, 0, 0, 255);
 
+    //pipelined rendering state. These are only modified
+    //at the beginning of a frame while the render thread is idle
+    bool renderThreadRequested = false;
+    bool renderThreadEnabled = false;
+
+    App::RenderBackend requestedBackend = App::RenderBackend::Legacy;
+    bool coreBackendAvailable = false;
+    void updateBackendAvailability(const sf::ContextSettings& settings)
+    {
+        coreBackendAvailable = (settings.majorVersion > 3 || (settings.majorVersion == 3 && settings.minorVersion >= 3))
+            && GLAD_GL_ARB_shader_objects && GLAD_GL_ARB_vertex_program && GLAD_GL_ARB_vertex_buffer_object
+            && GLAD_GL_ARB_vertex_array_object && GLAD_GL_ARB_uniform_buffer_object
+            && GLAD_GL_ARB_draw_instanced && GLAD_GL_ARB_instanced_arrays;
+    }
+    bool snapshotReady = false;
+    std::size_t snapshotIndex = 0;
+
     App* appInstance = nullptr;
 
     const std::string settingsFile("settings.cfg");
@@ -167,7 +187,9 @@ bool App::m_mouseCursorVisible = true;
 App::App(sf::ContextSettings contextSettings)
     : m_videoSettings   (contextSettings),
     m_renderWindow      (m_videoSettings.VideoMode, windowTitle, m_videoSettings.WindowStyle, m_videoSettings.ContextSettings),
-    m_applicationName   (APP_NAME)
+    m_applicationName   (APP_NAME),
+    m_renderPending     (false),
+    m_renderThreadQuit  (false)
 {
     renderWindow = &m_renderWindow;
 
@@ -202,6 +224,7 @@ App::App(sf::ContextSettings contextSettings)
     {
         Logger::log("Something went wrong loading OpenGL. Particles may be unavailable", Logger::Type::Error, Logger::Output::All);
     }
+    updateBackendAvailability(m_renderWindow.getSettings());
 
     m_defaultCursor.loadFromSystem(sf::Cursor::Arrow);
 
@@ -236,7 +259,8 @@ void App::run()
     {
         float elapsedTime = frameClock.restart().asSeconds();
         timeSinceLastUpdate += elapsedTime;
-        
+        bool updated = false;
+
         while (timeSinceLastUpdate > timePerFrame)
         {
             timeSinceLastUpdate -= timePerFrame;
@@ -245,9 +269,15 @@ void App::run()
             handleMessages();
 
             updateApp(timePerFrame);
+            updated = true;
             
             appInstance->m_renderWindow.setMouseCursorVisible(m_mouseCursorVisible || Console::isVisible());
         }
+
+        //everything from here until the render thread is
+        //signalled is safe to touch data which is being drawn
+        waitForRenderThread();
+        updateRenderThread(updated);
         
         ImGui::SFML::Update(m_renderWindow, sf::seconds(elapsedTime));
         
@@ -255,23 +285,45 @@ void App::run()
         Console::draw();
         for (auto& f : m_guiWindows) f.first();
         
-        //m_renderWindow.clear(clearColour);
-        if (m_renderWindow.setActive(true))
+        if (renderThreadEnabled)
         {
-            glCheck(glClearColor(clearColour.r / 255.f, clearColour.g / 255.f, clearColour.b / 255.f, clearColour.a / 255.f));
-            glCheck(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+            //finalise the ImGui draw list here, it's
+            //rendered along with the rest of the frame
+            ImGui::Render();
+
+            //nothing to draw until the first snapshot is published
+            if (snapshotReady)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_renderMutex);
+                    m_renderPending = true;
+                }
+                m_renderCondition.notify_one();
+            }
+        }
+        else
+        {
+            renderFrame();
         }
-        draw();       
-        ImGui::SFML::Render(m_renderWindow);
-        m_renderWindow.display();
     }
 
+    waitForRenderThread();
+    renderThreadRequested = false;
+    updateRenderThread(false);
+
+    //make sure any frames being captured are written
+    m_frameCapture.flush();
+
     m_messageBus.disable(); //prevents spamming with loads of entity quit messages
     
     finalise();
     Console::finalise();  
     ImGui::SFML::Shutdown();
 
+    //these hold GL resources so must go before the context
+    Detail::DistanceFieldCache::get().clear();
+    RenderStats::shutdown();
+
     saveSettings();
     m_renderWindow.close();
 }
@@ -300,6 +352,8 @@ void App::applyVideoSettings(const VideoSettings& settings)
 {
     if (m_videoSettings == settings) return;
 
+    waitForRenderThread();
+
     auto availableModes = m_videoSettings.AvailableVideoModes;
 
     auto oldAA = settings.ContextSettings.antialiasingLevel;
@@ -308,6 +362,7 @@ void App::applyVideoSettings(const VideoSettings& settings)
         || settings.VideoMode != m_videoSettings.VideoMode)
     {
         m_renderWindow.create(settings.VideoMode, settings.Title, settings.WindowStyle, settings.ContextSettings);
+        updateBackendAvailability(m_renderWindow.getSettings());
     /*}
     else
     {*/
@@ -353,6 +408,11 @@ void App::applyVideoSettings(const VideoSettings& settings)
         auto size = m_windowIcon.getSize();
         m_renderWindow.setIcon(size.x, size.y, m_windowIcon.getPixelsPtr());
     }
+
+    if (renderThreadEnabled)
+    {
+        m_renderWindow.setActive(false);
+    }
 }
 
 MessageBus& App::getMessageBus()
@@ -462,6 +522,53 @@ void App::resetFrametime()
     frameClock.restart();
 }
 
+void App::setRenderThreadEnabled(bool enabled)
+{
+    renderThreadRequested = enabled;
+}
+
+bool App::isRenderThreadEnabled()
+{
+    return renderThreadEnabled;
+}
+
+std::size_t App::getSnapshotWriteIndex()
+{
+    return snapshotIndex;
+}
+
+std::size_t App::getSnapshotReadIndex()
+{
+    return renderThreadEnabled ? snapshotIndex ^ 1 : snapshotIndex;
+}
+
+void App::syncRenderThread()
+{
+    //the render thread would wait on itself
+    if (appInstance
+        && std::this_thread::get_id() != appInstance->m_renderThread.get_id())
+    {
+        appInstance->waitForRenderThread();
+    }
+}
+
+void App::setRenderBackend(RenderBackend backend)
+{
+    requestedBackend = backend;
+}
+
+App::RenderBackend App::getRenderBackend()
+{
+    return (requestedBackend == RenderBackend::Core && coreBackendAvailable) ?
+        RenderBackend::Core : RenderBackend::Legacy;
+}
+
+FrameCapture& App::getFrameCapture()
+{
+    XY_ASSERT(appInstance, "No valid app instance");
+    return appInstance->m_frameCapture;
+}
+
 const sf::Cursor& App::getDefaultCursor()
 {
     XY_ASSERT(appInstance, "App not running");
@@ -487,11 +594,121 @@ void App::saveScreenshot()
 
     fileName.assign(buffer.data());
 
-    sf::Texture t;
-    t.create(m_renderWindow.getSize().x, m_renderWindow.getSize().y);
-    t.update(m_renderWindow);
-    sf::Image screenCap = t.copyToImage();
-    if (!screenCap.saveToFile(fileName)) Logger::log("failed to save " + fileName, Logger::Type::Error, Logger::Output::File);
+    //the window is read back asynchronously when the next frame is drawn
+    m_frameCapture.saveScreenshot(fileName);
+}
+
+void App::updateRenderThread(bool updated)
+{
+    if (renderThreadRequested != renderThreadEnabled)
+    {
+        renderThreadEnabled = renderThreadRequested;
+        snapshotReady = false;
+
+        if (renderThreadEnabled)
+        {
+            //the window context can only be active on one thread
+            m_renderWindow.setActive(false);
+            m_renderThreadQuit = false;
+            m_renderThread = std::thread(&App::renderLoop, this);
+        }
+        else
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_renderMutex);
+                m_renderThreadQuit = true;
+            }
+            m_renderCondition.notify_one();
+            m_renderThread.join();
+
+            m_renderWindow.setActive(true);
+        }
+        return;
+    }
+
+    //publish the snapshot written by the last update. If no update
+    //happened the render thread draws the previous snapshot again
+    if (renderThreadEnabled && updated)
+    {
+        snapshotIndex ^= 1;
+        snapshotReady = true;
+    }
+}
+
+void App::waitForRenderThread()
+{
+    if (m_renderThread.joinable())
+    {
+        std::unique_lock<std::mutex> lock(m_renderMutex);
+        m_renderCondition.wait(lock, [this]() { return !m_renderPending; });
+    }
+}
+
+void App::renderLoop()
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_renderMutex);
+            m_renderCondition.wait(lock, [this]() { return m_renderPending || m_renderThreadQuit; });
+
+            if (m_renderThreadQuit)
+            {
+                break;
+            }
+        }
+
+        renderFrame();
+
+        {
+            std::lock_guard<std::mutex> lock(m_renderMutex);
+            m_renderPending = false;
+        }
+        m_renderCondition.notify_one();
+    }
+}
+
+void App::renderFrame()
+{
+    //m_renderWindow.clear(clearColour);
+    if (m_renderWindow.setActive(true))
+    {
+        glCheck(glClearColor(clearColour.r / 255.f, clearColour.g / 255.f, clearColour.b / 255.f, clearColour.a / 255.f));
+        glCheck(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+    }
+    RenderStats::beginFrame();
+
+    draw();
+    Detail::GLStateCache::get().endFrame();
+
+    //captured before the Console and other windows are drawn
+    {
+        RenderStats::Scope scope("FrameCapture");
+        m_frameCapture.capture(m_renderWindow);
+    }
+
+    if (renderThreadEnabled)
+    {
+        //draw data was created by ImGui::Render() on the main thread
+        {
+            RenderStats::Scope scope("ImGui");
+            ImGui::SFML::RenderDrawData(m_renderWindow);
+        }
+        RenderStats::endFrame();
+        m_renderWindow.display();
+
+        //release the context so the main thread can use it between frames
+        m_renderWindow.setActive(false);
+    }
+    else
+    {
+        {
+            RenderStats::Scope scope("ImGui");
+            ImGui::SFML::Render(m_renderWindow);
+        }
+        RenderStats::endFrame();
+        m_renderWindow.display();
+    }
 }
 
 void App::handleEvents()
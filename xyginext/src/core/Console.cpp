@@ -32,10 +32,13 @@ source distribution.
 #include "xyginext/core/SysTime.hpp"
 #include "xyginext/core/Assert.hpp"
 #include "xyginext/audio/Mixer.hpp"
+#include "xyginext/graphics/RenderStats.hpp"
 #include "xyginext/gui/GuiClient.hpp"
 
 #include "xyginext/gui/imgui.h"
 
+#include "../detail/GLStateCache.hpp"
+
 #include <SFML/System/Err.hpp>
 
 #include <list>
@@ -386,6 +389,8 @@ void Console::draw()
                 if (ui::BeginTabItem("Stats", nullptr, flags))
                 {
                     ui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+                    const auto& glState = Detail::GLStateCache::get();
+                    ui::Text("GL state changes: %u issued, %u skipped", glState.getIssuedCount(), glState.getSkippedCount());
                     ui::NewLine();
                     for (auto& line : m_debugLines)
                     {
@@ -396,6 +401,71 @@ void Console::draw()
                 m_debugLines.clear();
                 m_debugLines.reserve(10);
 
+                currentTab++;
+                flags = (currentTab == TabIndex && FirstOpen) ? ImGuiTabItemFlags_SetSelected : 0;
+
+                //render statistics
+                if (ui::BeginTabItem("Render", nullptr, flags))
+                {
+                    bool passTiming = RenderStats::getPassTimingEnabled();
+                    if (ui::Checkbox("Time Individual Passes", &passTiming))
+                    {
+                        RenderStats::setPassTimingEnabled(passTiming);
+                    }
+
+                    const auto frame = RenderStats::getLastFrame();
+                    if (!RenderStats::isTimerAvailable())
+                    {
+                        ui::Text("GPU timer queries are not supported");
+                    }
+                    else if (frame.gpuTime < 0.f)
+                    {
+                        ui::Text("GPU frame time: waiting for results");
+                    }
+                    else
+                    {
+                        ui::Text("GPU frame time: %.3f ms", frame.gpuTime);
+                    }
+                    ui::Text("Draw calls: %u, Vertices: %u", frame.drawCalls, frame.vertexCount);
+                    ui::Text("GL state changes: %u issued, %u skipped", frame.stateChanges, frame.skippedStateChanges);
+
+                    if (!frame.passes.empty())
+                    {
+                        ui::NewLine();
+                        ui::Columns(4, "passes");
+                        ui::Text("Pass");
+                        ui::NextColumn();
+                        ui::Text("GPU ms");
+                        ui::NextColumn();
+                        ui::Text("Draw calls");
+                        ui::NextColumn();
+                        ui::Text("Vertices");
+                        ui::NextColumn();
+                        ui::Separator();
+
+                        for (const auto& pass : frame.passes)
+                        {
+                            ui::Text("%*s%s", static_cast<int>(pass.depth * 2), "", pass.name.c_str());
+                            ui::NextColumn();
+                            if (pass.gpuTime < 0.f)
+                            {
+                                ui::Text("-");
+                            }
+                            else
+                            {
+                                ui::Text("%.3f", pass.gpuTime);
+                            }
+                            ui::NextColumn();
+                            ui::Text("%u", pass.drawCalls);
+                            ui::NextColumn();
+                            ui::Text("%u", pass.vertexCount);
+                            ui::NextColumn();
+                        }
+                        ui::Columns(1);
+                    }
+                    ui::EndTabItem();
+                }
+
                 //display any registered controls
                 int count(0);
                 for (const auto& func : m_statusControls)
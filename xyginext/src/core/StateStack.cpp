@@ -52,6 +52,11 @@ void StateStack::unregisterState(StateID id)
 
 void StateStack::update(float dt)
 {
+    //states own the scenes being drawn by any render thread
+    if (!m_pendingChanges.empty())
+    {
+        App::syncRenderThread();
+    }
     applyPendingChanges();
     for (auto i = m_stack.rbegin(); i != m_stack.rend(); ++i)
     {
@@ -0,0 +1,181 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include "CoreProfile.hpp"
+
+#include <SFML/Window/Context.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+using namespace xy::Detail;
+
+namespace
+{
+    //VAOs released while their context was not active, by context ID.
+    //Resources may be destroyed on any thread, so this is guarded.
+    //IDs are never reused, and the VAOs of a context which is destroyed
+    //first are released with it, leaving only a stale entry here
+    std::mutex pendingMutex;
+    std::vector<std::pair<std::uint64_t, GLuint>> pendingArrays;
+    std::atomic<std::size_t> pendingCount = 0;
+}
+
+VertexArray::~VertexArray()
+{
+    //read before anything else might activate a context, as a
+    //VAO can only be deleted by the context which created it
+    const auto id = sf::Context::getActiveContextId();
+    if (m_arrays.empty())
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    for (const auto& [context, vao] : m_arrays)
+    {
+        if (id != 0 && context == id)
+        {
+            glCheck(glDeleteVertexArrays(1, &vao));
+        }
+        else
+        {
+            pendingArrays.emplace_back(context, vao);
+        }
+    }
+    pendingCount = pendingArrays.size();
+}
+
+void VertexArray::bind(const std::function<void()>& setup)
+{
+    auto id = sf::Context::getActiveContextId();
+    if (pendingCount != 0)
+    {
+        deletePending(id);
+    }
+
+    auto result = std::find_if(m_arrays.begin(), m_arrays.end(),
+        [id](const std::pair<std::uint64_t, GLuint>& pair)
+        {
+            return pair.first == id;
+        });
+
+    if (result == m_arrays.end())
+    {
+        GLuint vao = 0;
+        glCheck(glGenVertexArrays(1, &vao));
+        glCheck(glBindVertexArray(vao));
+        setup();
+        m_arrays.emplace_back(id, vao);
+    }
+    else
+    {
+        glCheck(glBindVertexArray(result->second));
+    }
+}
+
+void VertexArray::unbind()
+{
+    glCheck(glBindVertexArray(0));
+}
+
+//private
+void VertexArray::deletePending(std::uint64_t contextID)
+{
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    auto end = std::remove_if(pendingArrays.begin(), pendingArrays.end(),
+        [contextID](const std::pair<std::uint64_t, GLuint>& pair)
+        {
+            if (pair.first == contextID)
+            {
+                glCheck(glDeleteVertexArrays(1, &pair.second));
+                return true;
+            }
+            return false;
+        });
+    pendingArrays.erase(end, pendingArrays.end());
+    pendingCount = pendingArrays.size();
+}
+
+StreamBuffer::StreamBuffer(GLenum target, std::size_t capacity)
+    : m_target  (target),
+    m_capacity  (capacity),
+    m_offset    (0),
+    m_handle    (0)
+{
+
+}
+
+StreamBuffer::~StreamBuffer()
+{
+    if (m_handle)
+    {
+        TransientContextLock lock;
+        glCheck(glDeleteBuffersARB(1, &m_handle));
+    }
+}
+
+void StreamBuffer::bind()
+{
+    if (!m_handle)
+    {
+        glCheck(glGenBuffersARB(1, &m_handle));
+        glCheck(glBindBufferARB(m_target, m_handle));
+        orphan();
+    }
+    else
+    {
+        glCheck(glBindBufferARB(m_target, m_handle));
+    }
+}
+
+std::size_t StreamBuffer::write(const void* data, std::size_t size, std::size_t stride)
+{
+    auto offset = ((m_offset + stride - 1) / stride) * stride;
+    if (offset + size > m_capacity)
+    {
+        if (size > m_capacity)
+        {
+            m_capacity = size;
+        }
+        orphan();
+        offset = 0;
+    }
+
+    glCheck(glBufferSubDataARB(m_target, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data));
+    m_offset = offset + size;
+
+    return offset / stride;
+}
+
+//private
+void StreamBuffer::orphan()
+{
+    glCheck(glBufferDataARB(m_target, static_cast<GLsizeiptr>(m_capacity), nullptr, GL_STREAM_DRAW_ARB));
+    m_offset = 0;
+}
@@ -0,0 +1,125 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include "GLCheck.hpp"
+
+#include <SFML/Window/GlResource.hpp>
+
+#include <cstdint>
+#include <vector>
+#include <functional>
+
+//helpers for the OpenGL 3.3 core render backend
+//see App::setRenderBackend()
+
+namespace xy
+{
+    namespace Detail
+    {
+        //uniform buffer binding point used for view data by the built in shaders
+        static constexpr GLuint ViewUniformBinding = 0;
+        //uniform buffer binding point for the frame table of GPU played sprite animations
+        static constexpr GLuint FrameTableUniformBinding = 1;
+
+        /*!
+        \brief Vertex array objects are not shared between contexts, so
+        this creates one for each context it is bound in. They can only
+        be deleted while their own context is active, so any which are
+        not are queued and deleted the next time a VertexArray is bound
+        in that context.
+        */
+        class VertexArray final : public sf::GlResource
+        {
+        public:
+            VertexArray() = default;
+            ~VertexArray();
+
+            VertexArray(const VertexArray&) = delete;
+            VertexArray& operator = (const VertexArray&) = delete;
+
+            /*!
+            \brief Binds the VAO for the active context. If it does not yet
+            exist it is created and the setup function called to configure
+            its attributes while bound.
+            */
+            void bind(const std::function<void()>& setup);
+
+            static void unbind();
+
+        private:
+            std::vector<std::pair<std::uint64_t, GLuint>> m_arrays;
+
+            static void deletePending(std::uint64_t contextID);
+        };
+
+        /*!
+        \brief A buffer which is written to sequentially each frame. When
+        it is full the storage is orphaned so that the driver can allocate
+        new memory instead of waiting for pending draws to finish.
+        */
+        class StreamBuffer final : public sf::GlResource
+        {
+        public:
+            StreamBuffer(GLenum target, std::size_t capacity);
+            ~StreamBuffer();
+
+            StreamBuffer(const StreamBuffer&) = delete;
+            StreamBuffer& operator = (const StreamBuffer&) = delete;
+
+            void bind();
+
+            /*!
+            \brief Copies size bytes of data into the buffer, which must
+            be bound. The data is aligned to stride, and the index of the
+            first element is returned.
+            */
+            std::size_t write(const void* data, std::size_t size, std::size_t stride);
+
+            GLuint getHandle() const { return m_handle; }
+
+        private:
+            GLenum m_target;
+            std::size_t m_capacity;
+            std::size_t m_offset;
+            GLuint m_handle;
+
+            void orphan();
+        };
+
+        /*!
+        \brief Data layout of the ViewData uniform block, std140
+        */
+        struct ViewData final
+        {
+            float viewProjectionMatrix[16] = {};
+            float screenScale = 1.f;
+            float padding[3] = {};
+        };
+    }
+}
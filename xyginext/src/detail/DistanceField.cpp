@@ -0,0 +1,295 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include "DistanceField.hpp"
+
+#include "xyginext/core/Log.hpp"
+
+#include <SFML/Graphics/Font.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace xy::Detail;
+
+namespace
+{
+    constexpr std::uint32_t AtlasWidth = 1024;
+    constexpr std::uint32_t InitialHeight = 256;
+
+    //alpha is the distance to the glyph's edge, mapped from
+    //-Spread..Spread to 0..1 so that the edge lies at 0.5.
+    //u_outlineThickness is in the same units
+    const std::string FragmentShader = R"(
+        #version 120
+
+        uniform sampler2D u_texture;
+        uniform vec4 u_outlineColour;
+        uniform float u_outlineThickness;
+
+        void main()
+        {
+            float distance = texture2D(u_texture, gl_TexCoord[0].xy).a;
+            float width = fwidth(distance) * 0.7;
+            float fill = smoothstep(0.5 - width, 0.5 + width, distance);
+
+            if (u_outlineThickness > 0.0)
+            {
+                float edge = 0.5 - u_outlineThickness;
+                float outline = smoothstep(edge - width, edge + width, distance);
+                vec4 colour = mix(u_outlineColour, gl_Color, fill);
+                gl_FragColor = vec4(colour.rgb, colour.a * outline);
+            }
+            else
+            {
+                gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * fill);
+            }
+        })";
+
+    bool isWhitespace(std::uint32_t codepoint)
+    {
+        return codepoint == ' ' || codepoint == '\t' || codepoint == '\n';
+    }
+
+    //brute force search of the pixels within Spread of each output pixel
+    //for the nearest one on the other side of the glyph's edge. Only done
+    //once per glyph so simplicity wins over a distance transform.
+    std::vector<std::uint8_t> createField(const sf::Image& page, sf::IntRect rect)
+    {
+        constexpr auto Spread = DistanceFieldAtlas::Spread;
+        const auto width = rect.width + (Spread * 2);
+        const auto height = rect.height + (Spread * 2);
+
+        auto inside = [&](std::int32_t x, std::int32_t y)
+        {
+            if (x < 0 || y < 0 || x >= rect.width || y >= rect.height)
+            {
+                return false;
+            }
+            return page.getPixel(rect.left + x, rect.top + y).a > 127;
+        };
+
+        std::vector<std::uint8_t> pixels(width * height * 4, 255);
+        for (auto y = 0; y < height; ++y)
+        {
+            for (auto x = 0; x < width; ++x)
+            {
+                const auto sx = x - Spread;
+                const auto sy = y - Spread;
+                const bool in = inside(sx, sy);
+
+                auto nearest = static_cast<float>(Spread * Spread);
+                for (auto j = -Spread; j <= Spread; ++j)
+                {
+                    for (auto i = -Spread; i <= Spread; ++i)
+                    {
+                        const auto distance = static_cast<float>((i * i) + (j * j));
+                        if (distance < nearest
+                            && inside(sx + i, sy + j) != in)
+                        {
+                            nearest = distance;
+                        }
+                    }
+                }
+
+                //the edge lies between pixel centres
+                const auto distance = std::sqrt(nearest) - 0.5f;
+                const auto value = 0.5f + ((in ? distance : -distance) / (Spread * 2.f));
+                pixels[((y * width) + x) * 4 + 3] = static_cast<std::uint8_t>(std::clamp(value, 0.f, 1.f) * 255.f);
+            }
+        }
+        return pixels;
+    }
+}
+
+DistanceFieldAtlas::DistanceFieldAtlas(const sf::Font& font)
+    : m_font    (font),
+    m_rowHeight (0),
+    m_page      (&font.getTexture(BaseSize))
+{
+    m_image.create(AtlasWidth, InitialHeight, sf::Color::Transparent);
+    m_texture.loadFromImage(m_image);
+    m_texture.setSmooth(true);
+}
+
+//public
+void DistanceFieldAtlas::addGlyphs(const sf::String& string, std::size_t start)
+{
+    std::vector<std::uint32_t> missing;
+    for (auto i = start; i < string.getSize(); ++i)
+    {
+        const auto codepoint = string[i];
+        if (!isWhitespace(codepoint)
+            && m_glyphs.count(codepoint) == 0
+            && std::find(missing.begin(), missing.end(), codepoint) == missing.end())
+        {
+            missing.push_back(codepoint);
+        }
+    }
+
+    if (missing.empty())
+    {
+        return;
+    }
+
+    //rasterise everything first so the page is only read back once
+    std::vector<sf::Glyph> glyphs;
+    for (auto codepoint : missing)
+    {
+        glyphs.push_back(m_font.getGlyph(codepoint, BaseSize, false));
+    }
+    const auto page = m_font.getTexture(BaseSize).copyToImage();
+
+    for (auto i = 0u; i < missing.size(); ++i)
+    {
+        auto glyph = glyphs[i];
+        if (glyph.textureRect.width > 0 && glyph.textureRect.height > 0)
+        {
+            const sf::Vector2u size(glyph.textureRect.width + (Spread * 2), glyph.textureRect.height + (Spread * 2));
+            sf::Vector2u position;
+            if (pack(size, position))
+            {
+                const auto pixels = createField(page, glyph.textureRect);
+                for (auto y = 0u; y < size.y; ++y)
+                {
+                    for (auto x = 0u; x < size.x; ++x)
+                    {
+                        m_image.setPixel(position.x + x, position.y + y, sf::Color(255, 255, 255, pixels[((y * size.x) + x) * 4 + 3]));
+                    }
+                }
+                m_texture.update(pixels.data(), size.x, size.y, position.x, position.y);
+
+                glyph.textureRect = sf::IntRect(position.x, position.y, size.x, size.y);
+                glyph.bounds.left -= Spread;
+                glyph.bounds.top -= Spread;
+                glyph.bounds.width += Spread * 2;
+                glyph.bounds.height += Spread * 2;
+            }
+            else
+            {
+                glyph.textureRect = {};
+            }
+        }
+        m_glyphs.insert(std::make_pair(missing[i], glyph));
+    }
+}
+
+const sf::Glyph& DistanceFieldAtlas::getGlyph(std::uint32_t codepoint) const
+{
+    auto result = m_glyphs.find(codepoint);
+    return result == m_glyphs.end() ? m_emptyGlyph : result->second;
+}
+
+//private
+bool DistanceFieldAtlas::pack(sf::Vector2u size, sf::Vector2u& position)
+{
+    if (size.x > AtlasWidth)
+    {
+        return false;
+    }
+
+    if (m_cursor.x + size.x > AtlasWidth)
+    {
+        m_cursor.x = 0;
+        m_cursor.y += m_rowHeight;
+        m_rowHeight = 0;
+    }
+
+    auto height = m_image.getSize().y;
+    if (m_cursor.y + size.y > height)
+    {
+        //existing texture rects stay valid as the atlas only grows downwards
+        while (m_cursor.y + size.y > height)
+        {
+            height *= 2;
+        }
+
+        if (height > sf::Texture::getMaximumSize())
+        {
+            Logger::log("Distance field atlas is full, glyphs will be missing", Logger::Type::Warning);
+            return false;
+        }
+
+        sf::Image image;
+        image.create(AtlasWidth, height, sf::Color::Transparent);
+        image.copy(m_image, 0, 0);
+        m_image = image;
+        m_texture.loadFromImage(m_image);
+    }
+
+    position = m_cursor;
+    m_cursor.x += size.x;
+    m_rowHeight = std::max(m_rowHeight, size.y);
+    return true;
+}
+
+DistanceFieldCache& DistanceFieldCache::get()
+{
+    static DistanceFieldCache cache;
+    return cache;
+}
+
+DistanceFieldAtlas& DistanceFieldCache::getAtlas(const sf::Font& font)
+{
+    auto& atlas = m_atlases[&font];
+    if (!atlas || atlas->m_page != &font.getTexture(DistanceFieldAtlas::BaseSize))
+    {
+        atlas = std::make_unique<DistanceFieldAtlas>(font);
+    }
+    return *atlas;
+}
+
+void DistanceFieldCache::removeFont(const sf::Font& font)
+{
+    m_atlases.erase(&font);
+}
+
+sf::Shader* DistanceFieldCache::getShader()
+{
+    if (!m_shaderLoaded)
+    {
+        m_shaderLoaded = true;
+        if (sf::Shader::isAvailable())
+        {
+            m_shader = std::make_unique<sf::Shader>();
+            if (!m_shader->loadFromMemory(FragmentShader, sf::Shader::Fragment))
+            {
+                Logger::log("Failed creating distance field text shader", Logger::Type::Error);
+                m_shader.reset();
+            }
+        }
+    }
+    return m_shader.get();
+}
+
+void DistanceFieldCache::clear()
+{
+    m_atlases.clear();
+    m_shader.reset();
+    m_shaderLoaded = false;
+}
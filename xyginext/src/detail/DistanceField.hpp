@@ -0,0 +1,151 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include <SFML/Graphics/Glyph.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/String.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <unordered_map>
+
+namespace sf
+{
+    class Font;
+}
+
+namespace xy
+{
+    namespace Detail
+    {
+        /*!
+        \brief Signed distance fields of a font's glyphs, packed into a
+        single texture. Glyphs are rasterised once at BaseSize and scaled
+        by the text shader, so text of any size or scale is drawn from the
+        same texture without creating new glyph pages.
+        */
+        class DistanceFieldAtlas final
+        {
+        public:
+            //size at which glyphs are rasterised
+            static constexpr std::uint32_t BaseSize = 48;
+            //distance in pixels at BaseSize stored either side of a glyph's edge,
+            //which is also the widest outline which can be drawn at BaseSize
+            static constexpr std::int32_t Spread = 6;
+
+            explicit DistanceFieldAtlas(const sf::Font&);
+
+            DistanceFieldAtlas(const DistanceFieldAtlas&) = delete;
+            DistanceFieldAtlas& operator = (const DistanceFieldAtlas&) = delete;
+
+            /*!
+            \brief Adds any glyphs in the string from the given index which
+            are not yet in the atlas. The font's page at BaseSize is read back
+            once for all new glyphs.
+            */
+            void addGlyphs(const sf::String&, std::size_t start = 0);
+
+            /*!
+            \brief Returns the glyph at BaseSize, with bounds and texture
+            rect including the spread. Glyphs must have been added first.
+            */
+            const sf::Glyph& getGlyph(std::uint32_t codepoint) const;
+
+            const sf::Texture& getTexture() const { return m_texture; }
+
+        private:
+            const sf::Font& m_font;
+            std::unordered_map<std::uint32_t, sf::Glyph> m_glyphs;
+            sf::Glyph m_emptyGlyph;
+
+            //rows of glyphs are packed from the top, and the
+            //atlas grows downwards when it runs out of space
+            sf::Image m_image;
+            sf::Texture m_texture;
+            sf::Vector2u m_cursor;
+            std::uint32_t m_rowHeight;
+
+            const sf::Texture* m_page;
+
+            bool pack(sf::Vector2u size, sf::Vector2u& position);
+
+            friend class DistanceFieldCache;
+        };
+
+        /*!
+        \brief Owns a DistanceFieldAtlas for each font used by Text in
+        distance field mode, along with the shader which draws them.
+        GL resources are released by the App on shutdown.
+        */
+        class DistanceFieldCache final
+        {
+        public:
+            static DistanceFieldCache& get();
+
+            /*!
+            \brief Returns the atlas of the given font. The atlas is rebuilt
+            if the font's glyph page at DistanceFieldAtlas::BaseSize has been
+            replaced, as happens when a font is reloaded.
+            */
+            DistanceFieldAtlas& getAtlas(const sf::Font&);
+
+            /*!
+            \brief Destroys the atlas of the given font, if there is one
+            */
+            void removeFont(const sf::Font&);
+
+            /*!
+            \brief Returns the distance field shader, or nullptr if
+            shaders are unavailable.
+            */
+            sf::Shader* getShader();
+
+            /*!
+            \brief Returns true if the given shader is the distance field
+            shader. Does not load the shader.
+            */
+            bool isShader(const sf::Shader* shader) const { return m_shader && m_shader.get() == shader; }
+
+            /*!
+            \brief Destroys all atlases and the shader
+            */
+            void clear();
+
+        private:
+            DistanceFieldCache() = default;
+
+            std::map<const sf::Font*, std::unique_ptr<DistanceFieldAtlas>> m_atlases;
+            std::unique_ptr<sf::Shader> m_shader;
+            bool m_shaderLoaded = false;
+        };
+    }
+}
@@ -0,0 +1,142 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include "FrameTable.hpp"
+
+#include <algorithm>
+
+using namespace xy::Detail;
+
+FrameTable::FrameTable()
+    : m_frames(std::make_shared<std::vector<sf::FloatRect>>())
+{
+
+}
+
+//public
+FrameTable& FrameTable::get()
+{
+    static FrameTable table;
+    return table;
+}
+
+std::int32_t FrameTable::getFirstFrame(const std::shared_ptr<const std::vector<Sprite::Animation>>& animations,
+    std::uint32_t revision, std::size_t index)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto result = std::find_if(m_entries.begin(), m_entries.end(),
+        [&](const Entry& entry)
+        {
+            return entry.animations == animations.get()
+                && entry.revision == revision
+                && entry.index == index
+                && !entry.owner.expired();
+        });
+
+    if (result != m_entries.end())
+    {
+        return static_cast<std::int32_t>(result->first);
+    }
+
+    //animations are only modified in place by a sprite which is their sole
+    //owner, so entries for earlier revisions are no longer used. Left in
+    //place they would fill the table while the sprite is being edited
+    m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+        [&](const Entry& entry)
+        {
+            return entry.animations == animations.get()
+                && entry.revision != revision;
+        }), m_entries.end());
+
+    const auto& frames = (*animations)[index].frames;
+    const auto count = static_cast<std::uint32_t>(frames.size());
+    const auto first = allocate(count);
+    if (first < 0)
+    {
+        return first;
+    }
+
+    Entry entry;
+    entry.owner = animations;
+    entry.animations = animations.get();
+    entry.revision = revision;
+    entry.index = index;
+    entry.first = static_cast<std::uint32_t>(first);
+    entry.count = count;
+    m_entries.insert(std::upper_bound(m_entries.begin(), m_entries.end(), entry,
+        [](const Entry& a, const Entry& b)
+        {
+            return a.first < b.first;
+        }), entry);
+
+    //copy rather than modify, the previous table may be in use by a render snapshot
+    auto table = std::make_shared<std::vector<sf::FloatRect>>(*m_frames);
+    if (table->size() < entry.first + count)
+    {
+        table->resize(entry.first + count);
+    }
+    std::copy(frames.begin(), frames.end(), table->begin() + entry.first);
+    m_frames = std::move(table);
+
+    return first;
+}
+
+std::shared_ptr<const std::vector<sf::FloatRect>> FrameTable::getFrames() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_frames;
+}
+
+//private
+std::int32_t FrameTable::allocate(std::uint32_t count)
+{
+    //space is only reclaimed when it's needed, as entries are
+    //likely to be reused while any sprite still uses them
+    m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+        [](const Entry& entry)
+        {
+            return entry.owner.expired();
+        }), m_entries.end());
+
+    //first fit
+    std::uint32_t start = 0;
+    for (const auto& entry : m_entries)
+    {
+        if (entry.first - start >= count)
+        {
+            break;
+        }
+        start = entry.first + entry.count;
+    }
+
+    if (start + count > MaxFrames)
+    {
+        return -1;
+    }
+    return static_cast<std::int32_t>(start);
+}
@@ -0,0 +1,101 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include "xyginext/ecs/components/Sprite.hpp"
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Clock.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace xy
+{
+    namespace Detail
+    {
+        /*!
+        \brief Frames of the sprite animations which are played on the GPU.
+        Animations are added by the SpriteAnimator and the frames uploaded
+        to a uniform buffer by the RenderSystem, where the instanced sprite
+        shader picks the current frame. The table is shared by all Scenes,
+        and the space used by an animation is reused once every Sprite
+        which referenced its animation data has been destroyed, or once
+        the animation data has been modified.
+        */
+        class FrameTable final
+        {
+        public:
+            //vec4 per frame, the 16kb minimum uniform block size of GL 3.3
+            static constexpr std::size_t MaxFrames = 1024;
+
+            static FrameTable& get();
+
+            /*!
+            \brief Returns the index of the first frame of the given animation
+            in the table, adding it if it doesn't exist, or -1 if the table
+            is full.
+            */
+            std::int32_t getFirstFrame(const std::shared_ptr<const std::vector<Sprite::Animation>>& animations,
+                std::uint32_t revision, std::size_t index);
+
+            /*!
+            \brief Returns the frames. This is replaced rather than modified
+            when animations are added, so can be held by a render snapshot.
+            */
+            std::shared_ptr<const std::vector<sf::FloatRect>> getFrames() const;
+
+            /*!
+            \brief Time base in seconds of all GPU animations
+            */
+            float getTime() const { return m_clock.getElapsedTime().asSeconds(); }
+
+        private:
+            FrameTable();
+
+            struct Entry final
+            {
+                std::weak_ptr<const void> owner;
+                const void* animations = nullptr;
+                std::uint32_t revision = 0;
+                std::size_t index = 0;
+                std::uint32_t first = 0;
+                std::uint32_t count = 0;
+            };
+            std::vector<Entry> m_entries; //sorted by first frame
+
+            mutable std::mutex m_mutex;
+            std::shared_ptr<const std::vector<sf::FloatRect>> m_frames;
+            sf::Clock m_clock;
+
+            std::int32_t allocate(std::uint32_t count);
+        };
+    }
+}
@@ -114,6 +114,17 @@ namespace xy
                 errorCode = glGetError(); //call until all errors are printed
             }
         }
+
+        //sf::Shader::getNativeHandle() returns an unsigned int, but
+        //GLhandleARB is a pointer type on macOS
+        static inline GLhandleARB toGlHandle(unsigned int handle)
+        {
+#ifdef __APPLE__
+            return reinterpret_cast<GLhandleARB>(static_cast<std::ptrdiff_t>(handle));
+#else
+            return static_cast<GLhandleARB>(handle);
+#endif
+        }
     }
 }
 
@@ -0,0 +1,298 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include "GLStateCache.hpp"
+
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Shader.hpp>
+
+using namespace xy::Detail;
+
+namespace
+{
+    //convert an sf::BlendMode::Factor constant to the corresponding OpenGL constant.
+    //taken from sf::RenderTarget source
+    GLenum factorToGlConstant(sf::BlendMode::Factor blendFactor)
+    {
+        switch (blendFactor)
+        {
+        case sf::BlendMode::Zero:             return GL_ZERO;
+        case sf::BlendMode::One:              return GL_ONE;
+        case sf::BlendMode::SrcColor:         return GL_SRC_COLOR;
+        case sf::BlendMode::OneMinusSrcColor: return GL_ONE_MINUS_SRC_COLOR;
+        case sf::BlendMode::DstColor:         return GL_DST_COLOR;
+        case sf::BlendMode::OneMinusDstColor: return GL_ONE_MINUS_DST_COLOR;
+        case sf::BlendMode::SrcAlpha:         return GL_SRC_ALPHA;
+        case sf::BlendMode::OneMinusSrcAlpha: return GL_ONE_MINUS_SRC_ALPHA;
+        case sf::BlendMode::DstAlpha:         return GL_DST_ALPHA;
+        case sf::BlendMode::OneMinusDstAlpha: return GL_ONE_MINUS_DST_ALPHA;
+        }
+
+        return GL_ZERO;
+    }
+
+
+    //convert an sf::BlendMode::BlendEquation constant to the corresponding OpenGL constant.
+    //taken from sf::RenderTarget source
+    GLenum equationToGlConstant(sf::BlendMode::Equation blendEquation)
+    {
+        switch (blendEquation)
+        {
+        case sf::BlendMode::Add:             return GL_FUNC_ADD;
+        case sf::BlendMode::Subtract:        return GL_FUNC_SUBTRACT;
+        case sf::BlendMode::ReverseSubtract: return GL_FUNC_REVERSE_SUBTRACT;
+        case sf::BlendMode::Min:             return GL_MIN;
+        case sf::BlendMode::Max:             return GL_MAX;
+        }
+        return GL_FUNC_ADD;
+    }
+}
+
+GLStateCache& GLStateCache::get()
+{
+    static GLStateCache cache;
+    return cache;
+}
+
+void GLStateCache::invalidate()
+{
+    for (auto i = 0u; i < m_capCount; ++i)
+    {
+        m_caps[i].state = Unknown;
+    }
+    for (auto i = 0u; i < m_clientStateCount; ++i)
+    {
+        m_clientStates[i].state = Unknown;
+    }
+
+    m_scissorValid = false;
+    m_depthMask = Unknown;
+    m_depthFunc = 0;
+    m_blendModeValid = false;
+    m_textureValid = false;
+    m_shaderValid = false;
+}
+
+void GLStateCache::invalidateTargetCaps()
+{
+    for (auto i = 0u; i < m_capCount; ++i)
+    {
+        switch (m_caps[i].cap)
+        {
+        default: break;
+        case GL_CULL_FACE:
+        case GL_LIGHTING:
+        case GL_DEPTH_TEST:
+        case GL_ALPHA_TEST:
+        case GL_BLEND:
+        case GL_TEXTURE_2D:
+            m_caps[i].state = Unknown;
+            break;
+        }
+    }
+    m_blendModeValid = false;
+    m_textureValid = false;
+    m_shaderValid = false;
+}
+
+void GLStateCache::setEnabled(GLenum cap, bool enabled)
+{
+    auto* c = findCap(m_caps, m_capCount, cap);
+    const auto state = enabled ? On : Off;
+    if (update(!c || c->state != state))
+    {
+        if (enabled)
+        {
+            glCheck(glEnable(cap));
+        }
+        else
+        {
+            glCheck(glDisable(cap));
+        }
+
+        if (c)
+        {
+            c->state = state;
+        }
+    }
+}
+
+void GLStateCache::setClientState(GLenum array, bool enabled)
+{
+    auto* c = findCap(m_clientStates, m_clientStateCount, array);
+    const auto state = enabled ? On : Off;
+    if (update(!c || c->state != state))
+    {
+        if (enabled)
+        {
+            glCheck(glEnableClientState(array));
+        }
+        else
+        {
+            glCheck(glDisableClientState(array));
+        }
+
+        if (c)
+        {
+            c->state = state;
+        }
+    }
+}
+
+void GLStateCache::setScissor(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    const std::array<GLint, 4u> scissor = { x, y, width, height };
+    if (update(!m_scissorValid || m_scissor != scissor))
+    {
+        glCheck(glScissor(x, y, width, height));
+        m_scissor = scissor;
+        m_scissorValid = true;
+    }
+}
+
+void GLStateCache::setDepthMask(bool enabled)
+{
+    const auto state = enabled ? On : Off;
+    if (update(m_depthMask != state))
+    {
+        glCheck(glDepthMask(enabled ? GL_TRUE : GL_FALSE));
+        m_depthMask = state;
+    }
+}
+
+void GLStateCache::setDepthFunc(GLenum func)
+{
+    if (update(m_depthFunc != func))
+    {
+        glCheck(glDepthFunc(func));
+        m_depthFunc = func;
+    }
+}
+
+void GLStateCache::setBlendMode(const sf::BlendMode& mode)
+{
+    if (update(!m_blendModeValid || m_blendMode != mode))
+    {
+        if (GLAD_GL_EXT_blend_func_separate)
+        {
+            glCheck(glBlendFuncSeparateEXT(factorToGlConstant(mode.colorSrcFactor), factorToGlConstant(mode.colorDstFactor),
+                factorToGlConstant(mode.alphaSrcFactor), factorToGlConstant(mode.alphaDstFactor)));
+        }
+        else
+        {
+            glCheck(glBlendFunc(factorToGlConstant(mode.colorSrcFactor), factorToGlConstant(mode.colorDstFactor)));
+        }
+
+        if (GLAD_GL_EXT_blend_minmax && GLAD_GL_EXT_blend_subtract)
+        {
+            if (GLAD_GL_EXT_blend_equation_separate)
+            {
+                glCheck(glBlendEquationSeparateEXT(equationToGlConstant(mode.colorEquation), equationToGlConstant(mode.alphaEquation)));
+            }
+            else
+            {
+                glCheck(glBlendEquationEXT(equationToGlConstant(mode.colorEquation)));
+            }
+        }
+
+        m_blendMode = mode;
+        m_blendModeValid = true;
+    }
+}
+
+void GLStateCache::bindTexture(const sf::Texture* texture)
+{
+    if (update(!m_textureValid || m_texture != texture))
+    {
+        sf::Texture::bind(texture);
+        m_texture = texture;
+        m_textureValid = true;
+    }
+}
+
+void GLStateCache::bindShader(const sf::Shader* shader)
+{
+    if (update(!m_shaderValid || m_shader != shader))
+    {
+        sf::Shader::bind(shader);
+        m_shader = shader;
+        m_shaderValid = true;
+    }
+}
+
+void GLStateCache::disableAll()
+{
+    for (auto i = 0u; i < m_capCount; ++i)
+    {
+        if (m_caps[i].state == On)
+        {
+            setEnabled(m_caps[i].cap, false);
+        }
+    }
+}
+
+void GLStateCache::endFrame()
+{
+    m_lastIssued = m_issued;
+    m_lastSkipped = m_skipped;
+    m_issued = 0;
+    m_skipped = 0;
+}
+
+//private
+bool GLStateCache::update(bool changed)
+{
+    if (changed)
+    {
+        m_issued++;
+    }
+    else
+    {
+        m_skipped++;
+    }
+    return changed;
+}
+
+GLStateCache::Cap* GLStateCache::findCap(std::array<Cap, MaxCaps>& caps, std::size_t& count, GLenum cap)
+{
+    for (auto i = 0u; i < count; ++i)
+    {
+        if (caps[i].cap == cap)
+        {
+            return &caps[i];
+        }
+    }
+
+    //untracked caps are always applied once the list is full
+    if (count < caps.size())
+    {
+        caps[count].cap = cap;
+        caps[count].state = Unknown;
+        return &caps[count++];
+    }
+    return nullptr;
+}
@@ -0,0 +1,145 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include "GLCheck.hpp"
+
+#include <SFML/Graphics/BlendMode.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace sf
+{
+    class Texture;
+    class Shader;
+}
+
+namespace xy
+{
+    namespace Detail
+    {
+        /*!
+        \brief Tracks the GL state set by xygine's own render paths so that
+        redundant state changes can be skipped.
+        SFML (and user code) may modify state between systems being drawn,
+        so the tracked state is discarded with invalidate() at the start of
+        each draw pass, after which the first change to any state is always
+        issued. Counts of issued and skipped changes for the previous frame
+        are displayed in the Stats tab of the console.
+        */
+        class GLStateCache final
+        {
+        public:
+            static GLStateCache& get();
+
+            /*!
+            \brief Marks all state as unknown
+            */
+            void invalidate();
+
+            /*!
+            \brief Marks the caps modified by sf::RenderTarget::resetGLStates()
+            as unknown, along with the blend mode, texture and shader which
+            SFML sets when drawing. SFML resets its states internally the first
+            time a target is drawn to, which may happen partway through a pass.
+            */
+            void invalidateTargetCaps();
+
+            void setEnabled(GLenum cap, bool enabled);
+            void setClientState(GLenum array, bool enabled);
+            void setScissor(GLint x, GLint y, GLsizei width, GLsizei height);
+            void setDepthMask(bool enabled);
+            void setDepthFunc(GLenum func);
+
+            /*!
+            \brief Applies a blend mode as SFML would, with separate
+            alpha factors and equations where they are supported
+            */
+            void setBlendMode(const sf::BlendMode&);
+            void bindTexture(const sf::Texture*);
+            void bindShader(const sf::Shader*);
+
+            /*!
+            \brief Disables any caps enabled through the cache
+            */
+            void disableAll();
+
+            /*!
+            \brief Stores the counts for the current frame and resets them.
+            Called by the App once a frame has been drawn.
+            */
+            void endFrame();
+
+            std::uint32_t getIssuedCount() const { return m_lastIssued; }
+            std::uint32_t getSkippedCount() const { return m_lastSkipped; }
+
+        private:
+            GLStateCache() = default;
+
+            enum State : std::int8_t
+            {
+                Unknown = -1, Off, On
+            };
+
+            static constexpr std::size_t MaxCaps = 16;
+            struct Cap final
+            {
+                GLenum cap = 0;
+                State state = Unknown;
+            };
+            std::array<Cap, MaxCaps> m_caps = {};
+            std::size_t m_capCount = 0;
+            std::array<Cap, MaxCaps> m_clientStates = {};
+            std::size_t m_clientStateCount = 0;
+
+            std::array<GLint, 4u> m_scissor = {};
+            bool m_scissorValid = false;
+
+            State m_depthMask = Unknown;
+            GLenum m_depthFunc = 0;
+            sf::BlendMode m_blendMode;
+            bool m_blendModeValid = false;
+
+            const sf::Texture* m_texture = nullptr;
+            bool m_textureValid = false;
+            const sf::Shader* m_shader = nullptr;
+            bool m_shaderValid = false;
+
+            std::uint32_t m_issued = 0;
+            std::uint32_t m_skipped = 0;
+            std::atomic<std::uint32_t> m_lastIssued = 0;
+            std::atomic<std::uint32_t> m_lastSkipped = 0;
+
+            //returns true if the change needs to be issued
+            bool update(bool changed);
+            Cap* findCap(std::array<Cap, MaxCaps>&, std::size_t&, GLenum);
+        };
+    }
+}
@@ -0,0 +1,142 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include "GlyphCache.hpp"
+
+#include <SFML/Graphics/Font.hpp>
+
+#include <limits>
+
+using namespace xy::Detail;
+
+GlyphTable::GlyphTable(const sf::Font& font, std::uint32_t charSize, float outlineThickness)
+    : m_font            (font),
+    m_charSize          (charSize),
+    m_outlineThickness  (outlineThickness),
+    m_directLoaded      (),
+    m_texture           (&font.getTexture(charSize)),
+    m_lastUsed          (0)
+{
+
+}
+
+//public
+const sf::Glyph& GlyphTable::getGlyph(std::uint32_t codepoint)
+{
+    if (codepoint < DirectCount)
+    {
+        if (!m_directLoaded[codepoint])
+        {
+            m_directGlyphs[codepoint] = m_font.getGlyph(codepoint, m_charSize, false, m_outlineThickness);
+            m_directLoaded[codepoint] = true;
+        }
+        return m_directGlyphs[codepoint];
+    }
+
+    auto result = m_glyphs.find(codepoint);
+    if (result == m_glyphs.end())
+    {
+        result = m_glyphs.insert(std::make_pair(codepoint, m_font.getGlyph(codepoint, m_charSize, false, m_outlineThickness))).first;
+    }
+    return result->second;
+}
+
+float GlyphTable::getKerning(std::uint32_t first, std::uint32_t second)
+{
+    if (first == 0)
+    {
+        return 0.f;
+    }
+
+    const auto key = (static_cast<std::uint64_t>(first) << 32) | second;
+    auto result = m_kerning.find(key);
+    if (result == m_kerning.end())
+    {
+        result = m_kerning.insert(std::make_pair(key, m_font.getKerning(first, second, m_charSize))).first;
+    }
+    return result->second;
+}
+
+GlyphCache& GlyphCache::get()
+{
+    static GlyphCache cache;
+    return cache;
+}
+
+GlyphTable& GlyphCache::getTable(const sf::Font& font, std::uint32_t charSize, float outlineThickness)
+{
+    const auto key = std::make_tuple(&font, charSize, outlineThickness);
+    auto result = m_tables.find(key);
+    if (result == m_tables.end())
+    {
+        //text which animates its size would otherwise add a table per size
+        std::size_t count = 0;
+        auto oldest = m_tables.end();
+        for (auto it = getFirstTable(&font); it != m_tables.end() && std::get<0>(it->first) == &font; ++it)
+        {
+            if (oldest == m_tables.end()
+                || it->second->m_lastUsed < oldest->second->m_lastUsed)
+            {
+                oldest = it;
+            }
+            count++;
+        }
+
+        if (count >= MaxTablesPerFont)
+        {
+            m_tables.erase(oldest);
+        }
+        result = m_tables.emplace(key, nullptr).first;
+    }
+
+    //a reloaded font creates new pages, in which
+    //the glyphs will likely be in different places
+    auto& table = result->second;
+    if (!table || table->m_texture != &font.getTexture(charSize))
+    {
+        table = std::make_unique<GlyphTable>(font, charSize, outlineThickness);
+    }
+    table->m_lastUsed = ++m_useCount;
+    return *table;
+}
+
+void GlyphCache::removeFont(const sf::Font& font)
+{
+    auto first = getFirstTable(&font);
+    auto last = first;
+    while (last != m_tables.end() && std::get<0>(last->first) == &font)
+    {
+        ++last;
+    }
+    m_tables.erase(first, last);
+}
+
+//private
+std::map<GlyphCache::Key, std::unique_ptr<GlyphTable>>::iterator GlyphCache::getFirstTable(const sf::Font* font)
+{
+    return m_tables.lower_bound(std::make_tuple(font, 0u, std::numeric_limits<float>::lowest()));
+}
@@ -0,0 +1,120 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include <SFML/Graphics/Glyph.hpp>
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+
+namespace sf
+{
+    class Font;
+    class Texture;
+}
+
+namespace xy
+{
+    namespace Detail
+    {
+        /*!
+        \brief Glyph metrics and kerning of a font at one character size
+        and outline thickness. sf::Font looks up each glyph in a map and
+        queries FreeType for each kerning pair, which adds up when text
+        is rebuilt every frame, so the results are kept here.
+        */
+        class GlyphTable final
+        {
+        public:
+            GlyphTable(const sf::Font&, std::uint32_t charSize, float outlineThickness);
+
+            const sf::Glyph& getGlyph(std::uint32_t codepoint);
+            float getKerning(std::uint32_t first, std::uint32_t second);
+
+        private:
+            const sf::Font& m_font;
+            std::uint32_t m_charSize;
+            float m_outlineThickness;
+
+            //ASCII is looked up directly, everything else is hashed
+            static constexpr std::size_t DirectCount = 128;
+            std::array<sf::Glyph, DirectCount> m_directGlyphs;
+            std::array<bool, DirectCount> m_directLoaded;
+
+            std::unordered_map<std::uint32_t, sf::Glyph> m_glyphs;
+            std::unordered_map<std::uint64_t, float> m_kerning;
+
+            const sf::Texture* m_texture;
+            std::uint64_t m_lastUsed;
+
+            friend class GlyphCache;
+        };
+
+        /*!
+        \brief Shares glyph tables between every Text using the same font,
+        character size and outline thickness. Fonts are only known by their
+        address, so tables must be removed with removeFont() before a font
+        is destroyed, else a new font at the same address may be given them.
+        */
+        class GlyphCache final
+        {
+        public:
+            //tables kept per font, the least recently used is replaced
+            static constexpr std::size_t MaxTablesPerFont = 16;
+
+            static GlyphCache& get();
+
+            /*!
+            \brief Returns the table for the given font. The table is
+            rebuilt if the font's texture page has been replaced, as
+            happens when a font is reloaded, so the returned reference
+            should not be held beyond the current update.
+            */
+            GlyphTable& getTable(const sf::Font&, std::uint32_t charSize, float outlineThickness);
+
+            /*!
+            \brief Destroys all the tables of the given font
+            */
+            void removeFont(const sf::Font&);
+
+        private:
+            GlyphCache() = default;
+
+            using Key = std::tuple<const sf::Font*, std::uint32_t, float>;
+            std::map<Key, std::unique_ptr<GlyphTable>> m_tables;
+            std::uint64_t m_useCount = 0;
+
+            //first table of the font, tables are ordered by font
+            std::map<Key, std::unique_ptr<GlyphTable>>::iterator getFirstTable(const sf::Font*);
+        };
+    }
+}
@@ -0,0 +1,119 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include "WorkerPool.hpp"
+
+using namespace xy::Detail;
+
+WorkerPool::WorkerPool(std::size_t workerCount)
+    : m_task        (nullptr),
+    m_taskCount     (0),
+    m_nextTask      (0),
+    m_pendingCount  (0),
+    m_running       (true)
+{
+    for (auto i = 0u; i < workerCount; ++i)
+    {
+        m_threads.emplace_back(&WorkerPool::workerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+    m_startCondition.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+//public
+void WorkerPool::run(std::size_t taskCount, const std::function<void(std::size_t)>& task)
+{
+    if (taskCount == 0)
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_task = &task;
+    m_taskCount = taskCount;
+    m_nextTask = 0;
+    m_pendingCount = taskCount;
+    lock.unlock();
+    m_startCondition.notify_all();
+    lock.lock();
+
+    //rather than sitting idle while the workers run
+    while (m_nextTask < m_taskCount)
+    {
+        auto index = m_nextTask++;
+        lock.unlock();
+        task(index);
+        lock.lock();
+        m_pendingCount--;
+    }
+
+    m_doneCondition.wait(lock, [this]() { return m_pendingCount == 0; });
+    m_task = nullptr;
+    m_taskCount = 0;
+}
+
+//private
+void WorkerPool::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_startCondition.wait(lock, [this]()
+            {
+                return !m_running || m_nextTask < m_taskCount;
+            });
+
+        if (!m_running)
+        {
+            return;
+        }
+
+        //the task remains valid until every index has completed
+        auto index = m_nextTask++;
+        const auto& task = *m_task;
+        lock.unlock();
+        task(index);
+        lock.lock();
+
+        if (--m_pendingCount == 0)
+        {
+            m_doneCondition.notify_one();
+        }
+    }
+}
@@ -0,0 +1,82 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace xy
+{
+    namespace Detail
+    {
+        /*!
+        \brief Persistent worker threads which run a batch of tasks, such
+        as culling one camera each, without creating threads every frame.
+        The calling thread also runs tasks, so a pool without any workers
+        runs the whole batch inline. run() must not be called from more
+        than one thread at a time.
+        */
+        class WorkerPool final
+        {
+        public:
+            explicit WorkerPool(std::size_t workerCount);
+            ~WorkerPool();
+
+            WorkerPool(const WorkerPool&) = delete;
+            WorkerPool(WorkerPool&&) = delete;
+            WorkerPool& operator = (const WorkerPool&) = delete;
+            WorkerPool& operator = (WorkerPool&&) = delete;
+
+            std::size_t getWorkerCount() const { return m_threads.size(); }
+
+            /*!
+            \brief Calls task with each index from 0 to taskCount - 1,
+            returning once all of them have completed
+            */
+            void run(std::size_t taskCount, const std::function<void(std::size_t)>& task);
+
+        private:
+            std::vector<std::thread> m_threads;
+            std::mutex m_mutex;
+            std::condition_variable m_startCondition;
+            std::condition_variable m_doneCondition;
+
+            const std::function<void(std::size_t)>* m_task;
+            std::size_t m_taskCount;
+            std::size_t m_nextTask;
+            std::size_t m_pendingCount; //started or waiting to start
+            bool m_running;
+
+            void workerLoop();
+        };
+    }
+}
@@ -32,8 +32,13 @@ source distribution.
 #include "xyginext/ecs/components/Camera.hpp"
 #include "xyginext/ecs/components/Transform.hpp"
 #include "xyginext/ecs/components/AudioListener.hpp"
+#include "xyginext/ecs/systems/RenderSystem.hpp"
+#include "xyginext/graphics/RenderStats.hpp"
 
 #include <SFML/Window/Event.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+
+#include <algorithm>
 
 using namespace xy;
 
@@ -53,14 +58,18 @@ namespace
 
             return { { 0.f, top },{ 1.f, sizeY } };
         }
-        return {};
+
+        //eg when rendering headless
+        return { 0.f, 0.f, 1.f, 1.f };
     }
 }
 
 Scene::Scene(MessageBus& mb, std::size_t poolSize)
     : m_messageBus      (mb),
     m_entityManager     (mb, m_componentManager, poolSize),
-    m_systemManager     (*this, m_componentManager)
+    m_systemManager     (*this, m_componentManager),
+    m_resolutionScale   (1.f),
+    m_dynamicResolutionEnabled(false)
 {
     auto defaultCamera = createEntity();
     defaultCamera.addComponent<Transform>().setPosition(xy::DefaultSceneSize / 2.f);
@@ -72,14 +81,7 @@ Scene::Scene(MessageBus& mb, std::size_t poolSize)
     m_activeCamera = m_defaultCamera;
     m_activeListener = m_defaultCamera;
 
-    currentRenderPath = [this](sf::RenderTarget& rt, sf::RenderStates states)
-    {
-        rt.setView(m_activeCamera.getComponent<Camera>().m_view);
-        for (auto r : m_drawables)
-        {
-            rt.draw(*r, states);
-        }
-    };
+    currentRenderPath = std::bind(&Scene::drawCameras, this, std::placeholders::_1, std::placeholders::_2);
 }
 
 //public
@@ -111,12 +113,37 @@ void Scene::update(float dt)
 
 
     m_systemManager.process(dt);
-    for (auto& p : m_postEffects)
+
+    //sorted, culled and copied to the render snapshot once
+    //everything else has been updated for this frame
+    for (auto* renderSystem : m_renderSystems)
+    {
+        if (renderSystem->isActive())
+        {
+            renderSystem->updateFrame();
+        }
+    }
+
+    if (App::isRenderThreadEnabled())
     {
-        p->update(dt);
+        //post effects are being drawn so are updated by the render thread
+        m_renderSnapshots[App::getSnapshotWriteIndex()].postUpdateTime += dt;
+        writeRenderSnapshot();
+    }
+    else
+    {
+        for (auto& p : m_postEffects)
+        {
+            p->update(dt);
+        }
     }
 }
 
+Scene::~Scene()
+{
+    App::syncRenderThread();
+}
+
 Entity Scene::createEntity()
 {
     m_pendingEntities.push_back(m_entityManager.createEntity());
@@ -136,25 +163,41 @@ Entity Scene::getEntity(Entity::ID id) const
 
 void Scene::setPostEnabled(bool enabled)
 {
+    App::syncRenderThread();
     if (enabled && !m_postEffects.empty())
     {
         currentRenderPath = std::bind(&Scene::postRenderPath, this, std::placeholders::_1, std::placeholders::_2);
         
-        XY_ASSERT(App::getRenderWindow(), "no valid window");
-        auto size = App::getRenderWindow()->getSize();
-        m_sceneBuffer.create(size.x, size.y, sf::ContextSettings(24));
+        auto size = getPostOutputSize();
+        createSceneBuffer(size);
         for (auto& p : m_postEffects) p->resizeBuffer(size.x, size.y);
     }
     else
     {       
-        currentRenderPath = [this](sf::RenderTarget& rt, sf::RenderStates states)
-        {
-            rt.setView(m_activeCamera.getComponent<Camera>().m_view);
-            for (auto r : m_drawables)
-            {
-                rt.draw(*r, states);
-            }
-        };
+        currentRenderPath = std::bind(&Scene::drawCameras, this, std::placeholders::_1, std::placeholders::_2);
+    }
+}
+
+void Scene::setResolutionScale(float scale)
+{
+    //the buffer is resized next time it is drawn
+    App::syncRenderThread();
+    m_resolutionScale = std::max(0.1f, std::min(1.f, scale));
+}
+
+void Scene::setDynamicResolution(bool enabled, const DynamicResolution::Settings& settings)
+{
+    App::syncRenderThread();
+    m_dynamicResolutionEnabled = enabled;
+    if (enabled)
+    {
+        m_dynamicResolution.setSettings(settings);
+        m_dynamicResolution.reset();
+        m_frameClock.restart();
+    }
+    else
+    {
+        m_resolutionScale = 1.f;
     }
 }
 
@@ -173,6 +216,18 @@ Entity Scene::setActiveCamera(Entity entity)
     return oldCam;
 }
 
+void Scene::setRenderCameras(const std::vector<Entity>& cameras)
+{
+#ifdef XY_DEBUG
+    for (auto camera : cameras)
+    {
+        XY_ASSERT(camera.hasComponent<Transform>() && camera.hasComponent<Camera>(), "Entity requires at least a transform and a camera component");
+        XY_ASSERT(m_entityManager.owns(camera), "This entity must belong to this scene!");
+    }
+#endif //XY_DEBUG
+    m_renderCameras = cameras;
+}
+
 Entity Scene::setActiveListener(Entity entity)
 {
     XY_ASSERT(entity.hasComponent<Transform>() && entity.hasComponent<AudioListener>(), "Entity requires at least a transform and a camera component");
@@ -213,66 +268,309 @@ void Scene::forwardMessage(const Message& msg)
         const auto& data = msg.getData<Message::WindowEvent>();
         if (data.type == Message::WindowEvent::Resized)
         {
+            //the render thread may be using the buffers so
+            //wait until they're next drawn to resize them
+            if (App::isRenderThreadEnabled())
+            {
+                m_pendingBufferSize = { data.width, data.height };
+            }
             //update post effect buffers if they exist
-            if (m_sceneBuffer.getTexture().getNativeHandle() > 0)
+            else if (m_sceneBuffer.getTexture().getNativeHandle() > 0)
             {
-                m_sceneBuffer.create(data.width, data.height, sf::ContextSettings(24));
+                createSceneBuffer({ data.width, data.height });
+                m_postTargets.clear();
+            }
+            //updates the view of the default camera
+            m_defaultCamera.getComponent<Camera>().setViewport(getDefaultViewport());
+        }
+    }
+   
+}
+
+//private
+void Scene::writeRenderSnapshot()
+{
+    auto& snapshot = m_renderSnapshots[App::getSnapshotWriteIndex()];
+    snapshot.activeView = m_activeCamera.getComponent<Camera>().m_view;
+    snapshot.cameras.clear();
+
+    //the render thread resizes the buffers when it draws this snapshot
+    if (m_pendingBufferSize.x > 0)
+    {
+        snapshot.bufferSize = m_pendingBufferSize;
+        m_pendingBufferSize = {};
+    }
+
+    for (auto entity : m_renderCameras)
+    {
+        if (!entity.destroyed())
+        {
+            const auto& camera = entity.getComponent<Camera>();
+            snapshot.cameras.emplace_back(camera.m_view, camera.m_renderTarget);
+        }
+    }
+}
 
-                for (auto& b : m_postBuffers)
+void Scene::drawCameras(sf::RenderTarget& rt, sf::RenderStates states)
+{
+    if (App::isRenderThreadEnabled())
+    {
+        //camera components may be modified by the main thread
+        //while drawing, so only read the snapshot
+        const auto& snapshot = m_renderSnapshots[App::getSnapshotReadIndex()];
+        if (snapshot.cameras.empty())
+        {
+            rt.setView(snapshot.activeView);
+            for (auto r : m_drawables)
+            {
+                rt.draw(*r, states);
+            }
+        }
+        else
+        {
+            for (const auto& [view, target] : snapshot.cameras)
+            {
+                if (target)
                 {
-                    if (b.getTexture().getNativeHandle() > 0)
+                    target->clear(sf::Color::Transparent);
+                    target->setView(view);
+                    for (auto r : m_drawables)
                     {
-                        b.create(data.width, data.height);
+                        target->draw(*r, states);
+                    }
+                    target->display();
+                }
+                else
+                {
+                    rt.setView(view);
+                    for (auto r : m_drawables)
+                    {
+                        rt.draw(*r, states);
                     }
                 }
             }
-            //updates the view of the default camera
-            m_defaultCamera.getComponent<Camera>().setViewport(getDefaultViewport());
         }
+        return;
     }
-   
+
+    if (m_renderCameras.empty())
+    {
+        rt.setView(m_activeCamera.getComponent<Camera>().m_view);
+        for (auto r : m_drawables)
+        {
+            rt.draw(*r, states);
+        }
+        return;
+    }
+
+    auto activeCamera = m_activeCamera;
+    for (auto entity : m_renderCameras)
+    {
+        if (entity.destroyed())
+        {
+            continue;
+        }
+
+        //systems look at the active camera to find their
+        //culling results and filter flags for this pass
+        m_activeCamera = entity;
+        const auto& camera = entity.getComponent<Camera>();
+
+        if (camera.m_renderTarget)
+        {
+            camera.m_renderTarget->clear(sf::Color::Transparent);
+            camera.m_renderTarget->setView(camera.m_view);
+            for (auto r : m_drawables)
+            {
+                camera.m_renderTarget->draw(*r, states);
+            }
+            camera.m_renderTarget->display();
+        }
+        else
+        {
+            rt.setView(camera.m_view);
+            for (auto r : m_drawables)
+            {
+                rt.draw(*r, states);
+            }
+        }
+    }
+    m_activeCamera = activeCamera;
 }
 
-//private
 void Scene::postRenderPath(sf::RenderTarget& rt, sf::RenderStates states)
 {
-    auto activeView = m_activeCamera.getComponent<Camera>().m_view;
+    if (App::isRenderThreadEnabled())
+    {
+        auto& snapshot = m_renderSnapshots[App::getSnapshotReadIndex()];
+        if (snapshot.bufferSize.x > 0)
+        {
+            createSceneBuffer(snapshot.bufferSize);
+            m_postTargets.clear();
+            snapshot.bufferSize = {};
+        }
+    }
+
+    //without a window the scene is drawn to a render texture, whose
+    //size the buffers are matched to instead
+    if (!App::getRenderWindow()
+        && rt.getSize() != m_outputSize)
+    {
+        createSceneBuffer(rt.getSize());
+        for (auto& p : m_postEffects) p->resizeBuffer(rt.getSize().x, rt.getSize().y);
+        m_postTargets.clear();
+    }
+
+    if (m_dynamicResolutionEnabled)
+    {
+        //GPU time is preferred as it isn't limited by vsync
+        //or affected by time spent on the CPU
+        auto frameTime = m_frameClock.restart().asSeconds();
+        if (RenderStats::getGPUFrameTime() > 0.f)
+        {
+            frameTime = RenderStats::getGPUFrameTime();
+        }
+        m_resolutionScale = m_dynamicResolution.update(frameTime);
+    }
+
+    if (getScaledSize(m_outputSize, m_resolutionScale) != m_sceneBuffer.getSize())
+    {
+        createSceneBuffer(m_outputSize);
+    }
+
+    if (App::isRenderThreadEnabled())
+    {
+        auto& snapshot = m_renderSnapshots[App::getSnapshotReadIndex()];
+        for (auto& p : m_postEffects)
+        {
+            p->update(snapshot.postUpdateTime);
+        }
+        snapshot.postUpdateTime = 0.f;
+    }
+
+    //effects which wouldn't change the image are skipped
+    m_activePostEffects.clear();
+    for (const auto& effect : m_postEffects)
+    {
+        if (!effect->isBypassed())
+        {
+            m_activePostEffects.push_back(effect.get());
+        }
+    }
+
+    const auto size = m_sceneBuffer.getSize();
+    if (m_activePostEffects.empty()
+        && size == m_outputSize)
+    {
+        drawCameras(rt, states);
+        return;
+    }
+
+    auto activeView = App::isRenderThreadEnabled() ?
+        m_renderSnapshots[App::getSnapshotReadIndex()].activeView :
+        m_activeCamera.getComponent<Camera>().m_view;
 
     m_sceneBuffer.setView(activeView);
 
-    //TODO if rendering multiple/split views
-    //this needs to be done for each camera
-    //in this loop - this doesn't affect the
-    //default render path, however
     //m_sceneBuffer.clear(sf::Color::Transparent);
     m_sceneBuffer.setActive();
     glCheck(glClearColor(0.f, 0.f, 0.f, 0.f));
     glCheck(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
 
-    for (auto r : m_drawables)
-    {
-        m_sceneBuffer.draw(*r, states);
-    }
+    drawCameras(m_sceneBuffer, states);
     m_sceneBuffer.display();
 
+    //each pass writes to a target from the pool, which is released
+    //once the following pass has read it. This means intermediate
+    //targets are ping-ponged, and any targets used internally by an
+    //effect are shared with the other effects in the chain.
     sf::RenderTexture* inTex = &m_sceneBuffer;
-    sf::RenderTexture* outTex = nullptr;
+    const auto applyEffect = [&](PostProcess& effect)
+    {
+        auto outSize = getScaledSize(size, effect.getResolutionScale());
+        auto& outTex = m_postTargets.acquire(outSize, outSize != m_outputSize);
+        outTex.clear();
+
+        RenderStats::Scope scope("PostProcess");
+        effect.apply(*inTex, outTex);
+        outTex.display();
+
+        if (inTex != &m_sceneBuffer)
+        {
+            m_postTargets.release(*inTex);
+        }
+        inTex = &outTex;
+    };
 
-    for (auto i = 0u; i < m_postEffects.size() - 1; ++i)
+    for (auto i = 0u; i + 1 < m_activePostEffects.size(); ++i)
     {
-        outTex = &m_postBuffers[i % 2];
-        outTex->clear();
-        m_postEffects[i]->apply(*inTex, *outTex);
-        outTex->display();
-        inTex = outTex;
+        applyEffect(*m_activePostEffects[i]);
     }
 
-    rt.setView(inTex->getDefaultView());
-    m_postEffects.back()->apply(*inTex, rt);
+    //the final pass is written directly to the output, which
+    //also upscales the image if the scene buffer is scaled, unless
+    //the effect itself is to be performed at a reduced resolution
+    rt.setView(rt.getDefaultView());
+    if (!m_activePostEffects.empty()
+        && m_activePostEffects.back()->getResolutionScale() == 1.f)
+    {
+        RenderStats::Scope scope("PostProcess");
+        m_activePostEffects.back()->apply(*inTex, rt);
+    }
+    else
+    {
+        if (!m_activePostEffects.empty())
+        {
+            applyEffect(*m_activePostEffects.back());
+        }
+
+        sf::Sprite sprite(inTex->getTexture());
+        sprite.setScale(static_cast<float>(rt.getSize().x) / static_cast<float>(inTex->getSize().x),
+                        static_cast<float>(rt.getSize().y) / static_cast<float>(inTex->getSize().y));
+        rt.draw(sprite, sf::BlendNone);
+        RenderStats::addDrawCall(4);
+    }
+
+    if (inTex != &m_sceneBuffer)
+    {
+        m_postTargets.release(*inTex);
+    }
+    m_postTargets.endFrame();
 
     rt.setView(activeView);
 }
 
+bool Scene::createSceneBuffer(sf::Vector2u outputSize)
+{
+    m_outputSize = outputSize;
+
+    const auto size = getScaledSize(outputSize, m_resolutionScale);
+    if (!m_sceneBuffer.create(size.x, size.y, sf::ContextSettings(24)))
+    {
+        return false;
+    }
+
+    //smoothed so that the image is filtered when upscaled
+    m_sceneBuffer.setSmooth(size != outputSize);
+    return true;
+}
+
+sf::Vector2u Scene::getPostOutputSize()
+{
+    if (App::getRenderWindow())
+    {
+        return App::getRenderWindow()->getSize();
+    }
+    return sf::Vector2u(DefaultSceneSize);
+}
+
+sf::Vector2u Scene::getScaledSize(sf::Vector2u size, float scale)
+{
+    size.x = std::max(1u, static_cast<std::uint32_t>(static_cast<float>(size.x) * scale));
+    size.y = std::max(1u, static_cast<std::uint32_t>(static_cast<float>(size.y) * scale));
+    return size;
+}
+
 void Scene::draw(sf::RenderTarget& rt, sf::RenderStates states) const
 {
     currentRenderPath(rt, states);
@@ -89,6 +89,12 @@ Scene* System::getScene()
     return m_scene;
 }
 
+const Scene* System::getScene() const
+{
+    XY_ASSERT(m_scene, "Scene is nullptr - something went wrong!");
+    return m_scene;
+}
+
 
 //private
 void System::processTypes(ComponentManager& cm)
@@ -31,23 +31,44 @@ source distribution.
 
 #include <SFML/Graphics/Vertex.hpp>
 
+#include <algorithm>
+
 using namespace xy;
 
 namespace
 {
-    void addCharacter(std::vector<sf::Vertex>& verts, sf::Vector2f position, sf::FloatRect glyph, sf::Color colour)
+    void addCharacter(sf::Vertex* verts, sf::Vector2f position, const sf::FloatRect& glyph, sf::Color colour)
     {
-        verts.emplace_back(position, colour, sf::Vector2f(glyph.left, glyph.top));
-        verts.emplace_back(sf::Vector2f(position.x + glyph.width, position.y), colour, sf::Vector2f(glyph.left + glyph.width, glyph.top));
-        verts.emplace_back(sf::Vector2f(position.x + glyph.width, position.y + glyph.height), colour, sf::Vector2f(glyph.left + glyph.width, glyph.top + glyph.height));
-        verts.emplace_back(sf::Vector2f(position.x, position.y + glyph.height), colour, sf::Vector2f(glyph.left, glyph.top + glyph.height));
+        verts[0] = sf::Vertex(position, colour, sf::Vector2f(glyph.left, glyph.top));
+        verts[1] = sf::Vertex(sf::Vector2f(position.x + glyph.width, position.y), colour, sf::Vector2f(glyph.left + glyph.width, glyph.top));
+        verts[2] = sf::Vertex(sf::Vector2f(position.x + glyph.width, position.y + glyph.height), colour, sf::Vector2f(glyph.left + glyph.width, glyph.top + glyph.height));
+        verts[3] = sf::Vertex(sf::Vector2f(position.x, position.y + glyph.height), colour, sf::Vector2f(glyph.left, glyph.top + glyph.height));
+    }
+
+    //number of quads in the string, so the vertices can be sized once
+    std::size_t getCharacterCount(const std::string& str)
+    {
+        std::size_t count = 0;
+        for (auto c : str)
+        {
+            if (c == '\t')
+            {
+                count += 4;
+            }
+            else if (c > 31 && c < 127)
+            {
+                count++;
+            }
+        }
+        return count;
     }
 }
 
 BitmapText::BitmapText()
     : m_font    (nullptr),
     m_colour    (sf::Color::White),
-    m_dirty     (true)
+    m_dirty     (true),
+    m_colourDirty(false)
 {
 
 }
@@ -55,7 +76,8 @@ BitmapText::BitmapText()
 BitmapText::BitmapText(const BitmapFont& font)
     : m_font    (nullptr),
     m_colour    (sf::Color::White),
-    m_dirty     (true)
+    m_dirty     (true),
+    m_colourDirty(false)
 {
     setFont(font);
 }
@@ -81,7 +103,7 @@ void BitmapText::setColour(sf::Color c)
     if (c != m_colour)
     {
         m_colour = c;
-        m_dirty = true;
+        m_colourDirty = true;
     }
 }
 
@@ -107,8 +129,6 @@ sf::FloatRect BitmapText::getLocalBounds(xy::Entity entity)
     if (text.m_dirty)
     {
         text.updateVertices(drawable);
-        drawable.setTexture(text.getFont()->getTexture());
-        drawable.setPrimitiveType(sf::PrimitiveType::Quads);
     }
     return drawable.getLocalBounds();
 }
@@ -117,40 +137,71 @@ sf::FloatRect BitmapText::getLocalBounds(xy::Entity entity)
 void BitmapText::updateVertices(Drawable& drawable)
 {
     m_dirty = false;
+    m_colourDirty = false;
 
     auto& verts = drawable.getVertices();
-    verts.clear();
-
     if (!m_font || m_string.empty())
     {
+        verts.clear();
         drawable.updateLocalBounds(sf::FloatRect());
         return;
     }
 
+    verts.resize(getCharacterCount(m_string) * 4);
+
+    const auto charSize = m_font->getCharacterSize();
+    auto* vert = verts.data();
     float left = 0.f;
     float top = 0.f;
+    float width = 0.f;
     for (auto c : m_string)
     {
         if (c == '\n')
         {
-            top += m_font->getCharacterSize().y;
+            top += charSize.y;
             left = 0.f;
         }
         else if (c == '\t')
         {
+            const auto& glyph = m_font->getGlyph(' ');
             for (auto i = 0; i < 4; ++i)
             {
-                auto glyph = m_font->getGlyph(' ');
-                addCharacter(verts, { left, top }, glyph, m_colour);
-                left += m_font->getCharacterSize().x;
+                addCharacter(vert, { left, top }, glyph, m_colour);
+                vert += 4;
+                left += charSize.x;
             }
         }
         else if (c > 31 && c < 127)
         {
-            addCharacter(verts, { left, top }, m_font->getGlyph(c), m_colour);
-            left += m_font->getCharacterSize().x;
+            addCharacter(vert, { left, top }, m_font->getGlyph(c), m_colour);
+            vert += 4;
+            left += charSize.x;
         }
+        width = std::max(width, left);
+    }
+
+    //every glyph is the same size, so the bounds are known without
+    //looking at every vertex. Rows with characters all start at zero
+    sf::FloatRect bounds;
+    if (!verts.empty())
+    {
+        bounds.top = verts[0].position.y;
+        bounds.width = width;
+        bounds.height = verts[verts.size() - 1].position.y - bounds.top;
     }
+    drawable.updateLocalBounds(bounds);
 
-    drawable.updateLocalBounds();
-}
\ No newline at end of file
+    drawable.setTexture(m_font->getTexture());
+    drawable.setPrimitiveType(sf::PrimitiveType::Quads);
+    drawable.setBatchingEnabled(true);
+}
+
+void BitmapText::updateColour(Drawable& drawable)
+{
+    m_colourDirty = false;
+    for (auto& vert : drawable.getVertices())
+    {
+        vert.color = m_colour;
+    }
+    drawable.markContentChanged();
+}
@@ -36,7 +36,9 @@ Camera::Camera()
     : m_lockAxis    (None),
     m_axisValue     (0.f),
     m_lockRotation  (false),
-    m_zoom          (1.f)
+    m_zoom          (1.f),
+    m_filterFlags   (std::numeric_limits<std::uint64_t>::max()),
+    m_renderTarget  (nullptr)
 {
     m_view.setSize(DefaultSceneSize);
     m_view.setCenter(DefaultSceneSize / 2.f);
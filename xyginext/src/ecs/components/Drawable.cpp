@@ -29,51 +29,139 @@ source distribution.
 #include "xyginext/core/Log.hpp"
 #include "xyginext/core/Assert.hpp"
 
+#include "../../detail/GLCheck.hpp"
+
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Shader.hpp>
 
 #include <limits>
+#include <algorithm>
+#include <unordered_map>
 
 using namespace xy;
 
+namespace
+{
+    //the last values uploaded to a program, indexed by uniform location
+    struct UploadedUniform final
+    {
+        std::array<float, 16u> value = {};
+        const void* pointer = nullptr;
+        bool valid = false;
+    };
+
+    struct ProgramState final
+    {
+        std::uint32_t program = 0;
+        std::unordered_map<std::string, std::int32_t> locations;
+        std::vector<UploadedUniform> uniforms;
+        std::int32_t currentTexture = -1;
+    };
+
+    //only accessed by whichever thread is currently drawing, and cleared
+    //after each pass as shaders may be reloaded or destroyed in between,
+    //or have their uniforms set directly
+    std::unordered_map<const sf::Shader*, ProgramState> programStates;
+    std::uint64_t uniformPass = 0;
+    bool uniformPassActive = false;
+
+    constexpr std::size_t MaxCachedLocation = 1024;
+}
+
 Drawable::Drawable()
-    : m_primitiveType   (sf::Quads),
+    : m_filterFlags     (DefaultFilterFlag),
+    m_sortKey           (0),
     m_zDepth            (0),
+    m_treeID            (-1),
+    m_layer             (0),
+    m_primitiveType     (sf::Quads),
     m_wantsSorting      (true),
-    m_filterFlags       (DefaultFilterFlag),
     m_cull              (true),
-    m_croppingArea      (std::numeric_limits<float>::lowest() / 2.f, std::numeric_limits<float>::lowest() / 2.f,
-                        std::numeric_limits<float>::max(), std::numeric_limits<float>::max()),
+    m_static            (false),
     m_cropped           (false),
-    m_glFlagIndex       (0),
-    m_depthWriteEnabled (true)
+    m_depthWriteEnabled (true),
+    m_instanced         (false),
+    m_batchingEnabled   (false),
+    m_boundsDirty       (true),
+    m_contentChanged    (true),
+    m_glFlagCount       (0)
 {
 
 }
 
 Drawable::Drawable(const sf::Texture& texture)
-    : m_primitiveType   (sf::Quads),
-    m_zDepth            (0),
-    m_wantsSorting      (true),    
-    m_filterFlags       (DefaultFilterFlag),
-    m_cull              (true),
-    m_croppingArea      (std::numeric_limits<float>::lowest() / 2.f, std::numeric_limits<float>::lowest() / 2.f,
-                        std::numeric_limits<float>::max(), std::numeric_limits<float>::max()),
-    m_cropped           (false),
-    m_glFlagIndex       (0),
-    m_depthWriteEnabled (true)
+    : Drawable()
+{
+    m_texture = &texture;
+}
+
+Drawable::~Drawable() = default;
+
+Drawable::Drawable(const Drawable& other)
+    : m_filterFlags     (other.m_filterFlags),
+    m_worldBounds       (other.m_worldBounds),
+    m_localBounds       (other.m_localBounds),
+    m_sortKey           (other.m_sortKey),
+    m_zDepth            (other.m_zDepth),
+    m_treeID            (-1), //a copy is not in any broadphase tree
+    m_layer             (other.m_layer),
+    m_texture           (other.m_texture),
+    m_shader            (other.m_shader),
+    m_blendMode         (other.m_blendMode),
+    m_vertices          (other.m_vertices),
+    m_primitiveType     (other.m_primitiveType),
+    m_wantsSorting      (true),
+    m_cull              (other.m_cull),
+    m_static            (other.m_static),
+    m_cropped           (other.m_cropped),
+    m_depthWriteEnabled (other.m_depthWriteEnabled),
+    m_instanced         (other.m_instanced),
+    m_batchingEnabled   (other.m_batchingEnabled),
+    m_boundsDirty       (true),
+    m_contentChanged    (true),
+    m_glFlagCount       (other.m_glFlagCount),
+    m_instanceData      (other.m_instanceData)
 {
-    m_states.texture = &texture;
+    if (other.m_coldData)
+    {
+        m_coldData = std::make_unique<ColdData>(*other.m_coldData);
+    }
+}
+
+Drawable& Drawable::operator=(const Drawable& other)
+{
+    if (&other != this)
+    {
+        //this drawable keeps its place in any broadphase tree
+        auto treeID = m_treeID;
+        Drawable copy(other);
+        *this = std::move(copy);
+        m_treeID = treeID;
+    }
+    return *this;
 }
 
+Drawable::Drawable(Drawable&&) noexcept = default;
+Drawable& Drawable::operator=(Drawable&&) noexcept = default;
+
 void Drawable::setTexture(const sf::Texture* texture)
 {
-    m_states.texture = texture;
+    if (m_texture != texture)
+    {
+        m_texture = texture;
+        m_wantsSorting = true;
+        m_contentChanged = true;
+    }
 }
 
 void Drawable::setShader(sf::Shader* shader)
 {
-    m_states.shader = shader;
+    if (m_shader != shader)
+    {
+        m_shader = shader;
+        m_wantsSorting = true;
+        m_contentChanged = true;
+    }
 }
 
 void Drawable::setDepth(std::int32_t depth)
@@ -82,71 +170,96 @@ void Drawable::setDepth(std::int32_t depth)
     {
         m_zDepth = depth;
         m_wantsSorting = true;
+        m_contentChanged = true;
+    }
+}
+
+void Drawable::setLayer(std::uint8_t layer)
+{
+    XY_ASSERT(layer < MaxLayers, "Layer out of range");
+    layer = std::min(layer, static_cast<std::uint8_t>(MaxLayers - 1));
+    if (m_layer != layer)
+    {
+        m_layer = layer;
+        m_wantsSorting = true;
+        m_contentChanged = true;
     }
 }
 
 void Drawable::bindUniform(const std::string& name, const sf::Texture& texture)
 {
-    bindUniform(name, &texture, m_textureBindings);
+    getColdData().uniformBindings.set(name, UniformBindings::Type::Texture, nullptr, 0, &texture);
 }
 
 void Drawable::bindUniform(const std::string& name, float value)
 {
-    bindUniform(name, value, m_floatBindings);
+    getColdData().uniformBindings.set(name, UniformBindings::Type::Float, &value, 1);
 }
 
 void Drawable::bindUniform(const std::string& name, sf::Vector2f value)
 {
-    bindUniform(name, value, m_vec2Bindings);
+    const float values[] = { value.x, value.y };
+    getColdData().uniformBindings.set(name, UniformBindings::Type::Vec2, values, 2);
 }
 
 void Drawable::bindUniform(const std::string& name, sf::Vector3f value)
 {
-    bindUniform(name, value, m_vec3Bindings);
+    const float values[] = { value.x, value.y, value.z };
+    getColdData().uniformBindings.set(name, UniformBindings::Type::Vec3, values, 3);
 }
 
 void Drawable::bindUniform(const std::string& name, bool value)
 {
-    bindUniform(name, value, m_boolBindings);
+    const float f = value ? 1.f : 0.f;
+    getColdData().uniformBindings.set(name, UniformBindings::Type::Bool, &f, 1);
 }
 
 void Drawable::bindUniform(const std::string& name, sf::Color value)
 {
-    bindUniform(name, sf::Glsl::Vec4(value), m_colourBindings);
+    const sf::Glsl::Vec4 colour(value);
+    const float values[] = { colour.x, colour.y, colour.z, colour.w };
+    getColdData().uniformBindings.set(name, UniformBindings::Type::Vec4, values, 4);
 }
 
 void Drawable::bindUniform(const std::string& name, const float* matrix)
 {
-    bindUniform(name, matrix, m_matBindings);
+    getColdData().uniformBindings.set(name, UniformBindings::Type::Matrix, nullptr, 0, matrix);
 }
 
 void Drawable::bindUniformToCurrentTexture(const std::string& name)
 {
-    auto result = std::find(m_currentTexBindings.begin(), m_currentTexBindings.end(), name);
-    if (result == m_currentTexBindings.end())
-    {
-        m_currentTexBindings.emplace_back(name);
-    }
+    getColdData().uniformBindings.set(name, UniformBindings::Type::CurrentTexture, nullptr, 0);
 }
 
 void Drawable::setBlendMode(sf::BlendMode mode)
 {
-    m_states.blendMode = mode;
+    if (m_blendMode != mode)
+    {
+        m_blendMode = mode;
+        m_wantsSorting = true;
+        m_contentChanged = true;
+    }
 }
 
 void Drawable::setCroppingArea(sf::FloatRect area)
 {
-    m_croppingArea = area;
+    getColdData().croppingArea = area;
+    m_boundsDirty = true;
+}
+
+sf::FloatRect Drawable::getCroppingArea() const
+{
+    return m_coldData ? m_coldData->croppingArea : ColdData().croppingArea;
 }
 
 sf::Texture* Drawable::getTexture()
 {
-    return const_cast<sf::Texture*>(m_states.texture);
+    return const_cast<sf::Texture*>(m_texture);
 }
 
 sf::Shader* Drawable::getShader()
 {
-    return const_cast<sf::Shader*>(m_states.shader);
+    return const_cast<sf::Shader*>(m_shader);
 }
 
 sf::FloatRect Drawable::getLocalBounds() const
@@ -156,6 +269,8 @@ sf::FloatRect Drawable::getLocalBounds() const
 
 void Drawable::updateLocalBounds()
 {
+    m_boundsDirty = true;
+    m_contentChanged = true;
     if (m_vertices.empty())
     {
         m_localBounds = {};
@@ -189,58 +304,273 @@ void Drawable::updateLocalBounds()
 void Drawable::updateLocalBounds(sf::FloatRect rect)
 {
     m_localBounds = rect;
+    m_boundsDirty = true;
+    m_contentChanged = true;
+}
+
+void Drawable::setInstanceData(const InstanceData& data)
+{
+    m_instanced = true;
+    m_instanceData = data;
+    m_contentChanged = true;
+    m_vertices.clear();
+    updateLocalBounds({ 0.f, 0.f, data.textureRect.width, data.textureRect.height });
+}
+
+void Drawable::clearInstanceData()
+{
+    m_instanced = false;
+    m_contentChanged = true;
 }
 
 sf::RenderStates Drawable::getStates() const
 {
-    return m_states;
+    sf::RenderStates states;
+    states.texture = m_texture;
+    states.shader = m_shader;
+    states.blendMode = m_blendMode;
+    return states;
 }
 
 void Drawable::applyShader() const
 {
-    XY_ASSERT(m_states.shader, "No shader set!");
+    XY_ASSERT(m_shader, "No shader set!");
+    if (m_coldData)
+    {
+        m_coldData->uniformBindings.apply(*const_cast<sf::Shader*>(m_shader));
+    }
+}
 
-    sf::Shader* shader = const_cast<sf::Shader*>(m_states.shader);
-    for (const auto& [name, value] : m_textureBindings)
+std::size_t Drawable::UniformBindings::valueCount(Type type)
+{
+    switch (type)
     {
-        shader->setUniform(name, *value);
+    default: return 0;
+    case Type::Float:
+    case Type::Bool:
+        return 1;
+    case Type::Vec2:
+        return 2;
+    case Type::Vec3:
+        return 3;
+    case Type::Vec4:
+        return 4;
     }
-    for (const auto& [name, value] : m_floatBindings)
+}
+
+void Drawable::UniformBindings::set(const std::string& name, Type type, const float* data, std::size_t count, const void* pointer)
+{
+    auto result = std::find_if(bindings.begin(), bindings.end(),
+        [&name](const Binding& binding)
+        {
+            return binding.name == name;
+        });
+
+    if (result == bindings.end())
     {
-        shader->setUniform(name, value);
+        auto& binding = bindings.emplace_back();
+        binding.name = name;
+        binding.offset = static_cast<std::uint32_t>(values.size());
+        values.resize(values.size() + count);
+        result = bindings.end() - 1;
     }
-    for (const auto& [name, value] : m_vec2Bindings)
+    else if (valueCount(result->type) < count)
     {
-        shader->setUniform(name, value);
+        //type changed and no longer fits in its old slot
+        result->offset = static_cast<std::uint32_t>(values.size());
+        values.resize(values.size() + count);
     }
-    for (const auto& [name, value] : m_vec3Bindings)
+
+    result->type = type;
+    result->pointer = pointer;
+    std::copy(data, data + count, values.begin() + result->offset);
+}
+
+void Drawable::UniformBindings::apply(sf::Shader& shader) const
+{
+    if (!GLAD_GL_ARB_shader_objects
+        || !uniformPassActive)
     {
-        shader->setUniform(name, value);
+        //fall back to letting SFML look up each uniform by name
+        for (const auto& binding : bindings)
+        {
+            const auto* value = values.data() + binding.offset;
+            switch (binding.type)
+            {
+            default: break;
+            case Type::Float:
+                shader.setUniform(binding.name, value[0]);
+                break;
+            case Type::Vec2:
+                shader.setUniform(binding.name, sf::Glsl::Vec2(value[0], value[1]));
+                break;
+            case Type::Vec3:
+                shader.setUniform(binding.name, sf::Glsl::Vec3(value[0], value[1], value[2]));
+                break;
+            case Type::Vec4:
+                shader.setUniform(binding.name, sf::Glsl::Vec4(value[0], value[1], value[2], value[3]));
+                break;
+            case Type::Bool:
+                shader.setUniform(binding.name, value[0] != 0.f);
+                break;
+            case Type::Matrix:
+                shader.setUniform(binding.name, sf::Glsl::Mat4(static_cast<const float*>(binding.pointer)));
+                break;
+            case Type::Texture:
+                shader.setUniform(binding.name, *static_cast<const sf::Texture*>(binding.pointer));
+                break;
+            case Type::CurrentTexture:
+                shader.setUniform(binding.name, sf::Shader::CurrentTexture);
+                break;
+            }
+        }
+        return;
     }
-    for (const auto& [name, value] : m_boolBindings)
+
+    const auto handle = shader.getNativeHandle();
+    auto& state = programStates[&shader];
+    if (state.program != handle)
     {
-        shader->setUniform(name, value);
+        state = {};
+        state.program = handle;
     }
-    for (const auto& [name, value] : m_colourBindings)
+
+    if (program != handle
+        || pass != uniformPass)
     {
-        shader->setUniform(name, value);
+        for (const auto& binding : bindings)
+        {
+            auto result = state.locations.find(binding.name);
+            if (result == state.locations.end())
+            {
+                std::int32_t location = -1;
+                glCheck(location = glGetUniformLocationARB(Detail::toGlHandle(handle), binding.name.c_str()));
+                result = state.locations.insert(std::make_pair(binding.name, location)).first;
+            }
+            binding.location = result->second;
+        }
+        program = handle;
+        pass = uniformPass;
+    }
+
+    //SFML restores the previously bound program after setting
+    //a uniform, so do the same - but only if something changed
+    bool programBound = false;
+    GLhandleARB previousProgram = 0;
+    auto bindProgram = [&]()
+    {
+        if (!programBound)
+        {
+            glCheck(previousProgram = glGetHandleARB(GL_PROGRAM_OBJECT_ARB));
+            glCheck(glUseProgramObjectARB(Detail::toGlHandle(handle)));
+            programBound = true;
+        }
+    };
+
+    for (const auto& binding : bindings)
+    {
+        if (binding.location < 0)
+        {
+            continue;
+        }
+
+        //textures are tracked by SFML as it manages the texture units
+        if (binding.type == Type::CurrentTexture)
+        {
+            if (state.currentTexture != binding.location)
+            {
+                shader.setUniform(binding.name, sf::Shader::CurrentTexture);
+                state.currentTexture = binding.location;
+            }
+            continue;
+        }
+
+        const auto location = static_cast<std::size_t>(binding.location);
+        if (location >= state.uniforms.size())
+        {
+            state.uniforms.resize(std::min(location + 1, MaxCachedLocation));
+        }
+        UploadedUniform dummy;
+        auto& uploaded = location < state.uniforms.size() ? state.uniforms[location] : dummy;
+
+        if (binding.type == Type::Texture)
+        {
+            if (!uploaded.valid || uploaded.pointer != binding.pointer)
+            {
+                shader.setUniform(binding.name, *static_cast<const sf::Texture*>(binding.pointer));
+                uploaded.pointer = binding.pointer;
+                uploaded.valid = true;
+            }
+            continue;
+        }
+
+        const auto* value = binding.type == Type::Matrix ?
+            static_cast<const float*>(binding.pointer) : values.data() + binding.offset;
+        const auto count = binding.type == Type::Matrix ? 16 : valueCount(binding.type);
+
+        if (uploaded.valid
+            && std::equal(value, value + count, uploaded.value.begin()))
+        {
+            continue;
+        }
+        std::copy(value, value + count, uploaded.value.begin());
+        uploaded.valid = true;
+
+        bindProgram();
+        switch (binding.type)
+        {
+        default: break;
+        case Type::Float:
+            glCheck(glUniform1fARB(binding.location, value[0]));
+            break;
+        case Type::Vec2:
+            glCheck(glUniform2fARB(binding.location, value[0], value[1]));
+            break;
+        case Type::Vec3:
+            glCheck(glUniform3fARB(binding.location, value[0], value[1], value[2]));
+            break;
+        case Type::Vec4:
+            glCheck(glUniform4fARB(binding.location, value[0], value[1], value[2], value[3]));
+            break;
+        case Type::Bool:
+            glCheck(glUniform1iARB(binding.location, value[0] != 0.f ? 1 : 0));
+            break;
+        case Type::Matrix:
+            glCheck(glUniformMatrix4fvARB(binding.location, 1, GL_FALSE, value));
+            break;
+        }
     }
-    for (const auto& [name, value] : m_matBindings)
+
+    if (programBound)
     {
-        shader->setUniform(name, sf::Glsl::Mat4(value));
+        glCheck(glUseProgramObjectARB(previousProgram));
     }
+}
 
-    for(const auto& str : m_currentTexBindings)
+bool Drawable::UniformBindings::matches(const UniformBindings& other) const
+{
+    if (bindings.size() != other.bindings.size()
+        || values != other.values)
     {
-        shader->setUniform(str, sf::Shader::CurrentTexture);
+        return false;
     }
+
+    return std::equal(bindings.begin(), bindings.end(), other.bindings.begin(),
+        [](const Binding& a, const Binding& b)
+        {
+            return a.type == b.type
+                && a.offset == b.offset
+                && a.pointer == b.pointer
+                && a.name == b.name;
+        });
 }
 
 void Drawable::addGlFlag(std::int32_t flag)
 {
-    if (m_glFlagIndex < m_glFlags.size())
+    auto& flags = getColdData().glFlags;
+    if (m_glFlagCount < flags.size())
     {
-        m_glFlags[m_glFlagIndex++] = flag;
+        flags[m_glFlagCount++] = flag;
     }
     else
     {
@@ -249,7 +579,57 @@ void Drawable::addGlFlag(std::int32_t flag)
 }
 
 //private
+void Drawable::beginUniformPass()
+{
+    programStates.clear();
+    uniformPass++;
+    uniformPassActive = true;
+}
+
+void Drawable::endUniformPass()
+{
+    programStates.clear();
+    uniformPassActive = false;
+}
+
+Drawable::ColdData::ColdData()
+    : croppingArea  (std::numeric_limits<float>::lowest() / 2.f, std::numeric_limits<float>::lowest() / 2.f,
+                    std::numeric_limits<float>::max(), std::numeric_limits<float>::max())
+{
+
+}
+
+Drawable::ColdData& Drawable::getColdData()
+{
+    //only requested when uniforms, flags or cropping are modified
+    m_contentChanged = true;
+    if (!m_coldData)
+    {
+        m_coldData = std::make_unique<ColdData>();
+    }
+    return *m_coldData;
+}
+
+std::array<sf::Vertex, 4u> Drawable::getInstanceQuad(const InstanceData& data)
+{
+    const auto& rect = data.textureRect;
+
+    //same winding as the SpriteSystem uses
+    std::array<sf::Vertex, 4u> quad;
+    quad[0] = { sf::Vector2f(), data.colour, sf::Vector2f(rect.left, rect.top) };
+    quad[1] = { sf::Vector2f(0.f, rect.height), data.colour, sf::Vector2f(rect.left, rect.top + rect.height) };
+    quad[2] = { sf::Vector2f(rect.width, rect.height), data.colour, sf::Vector2f(rect.left + rect.width, rect.top + rect.height) };
+    quad[3] = { sf::Vector2f(rect.width, 0.f), data.colour, sf::Vector2f(rect.left + rect.width, rect.top) };
+    return quad;
+}
+
 void Drawable::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
+    if (m_instanced)
+    {
+        auto quad = getInstanceQuad(m_instanceData);
+        target.draw(quad.data(), quad.size(), sf::Quads, states);
+        return;
+    }
     target.draw(m_vertices.data(), m_vertices.size(), m_primitiveType, states);
 }
\ No newline at end of file
@@ -31,20 +31,37 @@ source distribution.
 
 using namespace xy;
 
+namespace
+{
+    const std::shared_ptr<const std::vector<Sprite::Animation>>& emptyAnimations()
+    {
+        static const std::shared_ptr<const std::vector<Sprite::Animation>> animations = std::make_shared<std::vector<Sprite::Animation>>();
+        return animations;
+    }
+}
+
 Sprite::Sprite()
-    : m_texture     (nullptr),
-    m_colour        (sf::Color::White),
-    m_blendOverride (false),
-    m_dirty         (true)
+    : m_texture         (nullptr),
+    m_colour            (sf::Color::White),
+    m_blendOverride     (false),
+    m_dirty             (true),
+    m_texCoordsDirty    (false),
+    m_instanced         (false),
+    m_animations        (emptyAnimations()),
+    m_animationRevision (0)
 {
 
 }
 
 Sprite::Sprite(const sf::Texture& texture)
-    : m_texture     (nullptr),
-    m_colour        (sf::Color::White),
-    m_blendOverride (false),
-    m_dirty         (true)
+    : m_texture         (nullptr),
+    m_colour            (sf::Color::White),
+    m_blendOverride     (false),
+    m_dirty             (true),
+    m_texCoordsDirty    (false),
+    m_instanced         (false),
+    m_animations        (emptyAnimations()),
+    m_animationRevision (0)
 {
     setTexture(texture);
 }
@@ -98,3 +115,23 @@ sf::Color Sprite::getColour() const
 {
     return m_colour;
 }
+
+std::vector<Sprite::Animation>& Sprite::getAnimations()
+{
+    //copy on write, so shared animations are never modified. The
+    //array itself is never created const, so casting it is safe
+    if (m_animations.use_count() > 1)
+    {
+        m_animations = std::make_shared<std::vector<Animation>>(*m_animations);
+    }
+    m_animationRevision++;
+    m_animatorHook.markDirty();
+    return const_cast<std::vector<Animation>&>(*m_animations);
+}
+
+void Sprite::setAnimations(std::vector<Animation> animations)
+{
+    m_animations = std::make_shared<std::vector<Animation>>(std::move(animations));
+    m_animationRevision++;
+    m_animatorHook.markDirty();
+}
@@ -34,6 +34,13 @@ source distribution.
 #include "xyginext/ecs/components/Drawable.hpp"
 
 #include "xyginext/core/Log.hpp"
+#include "xyginext/core/App.hpp"
+
+#include "../../detail/DistanceField.hpp"
+#include "../../detail/GlyphCache.hpp"
+
+#include <algorithm>
+#include <cmath>
 
 using namespace xy;
 
@@ -44,7 +51,11 @@ Text::Text()
     m_fillColour        (sf::Color::White),
     m_outlineThickness  (0.f),
     m_dirty             (true),
-    m_alignment         (Alignment::Left)
+    m_colourDirty       (false),
+    m_alignment         (Alignment::Left),
+    m_mode              (Mode::Bitmap),
+    m_layoutStart       (0),
+    m_alignmentOffset   (0.f)
 {
 
 }
@@ -56,7 +67,11 @@ Text::Text(const sf::Font& font)
     m_fillColour        (sf::Color::White),
     m_outlineThickness  (0.f),
     m_dirty             (true),
-    m_alignment         (Alignment::Left)
+    m_colourDirty       (false),
+    m_alignment         (Alignment::Left),
+    m_mode              (Mode::Bitmap),
+    m_layoutStart       (0),
+    m_alignmentOffset   (0.f)
 {
     setFont(font);
 }
@@ -65,25 +80,29 @@ Text::Text(const sf::Font& font)
 void Text::setFont(const sf::Font& font)
 {
     m_font = &font;
-    m_dirty = true;
+    invalidateLayout();
 }
 
 void Text::setCharacterSize(std::uint32_t size)
 {
     m_charSize = size;
-    m_dirty = true;
+    invalidateLayout();
 }
 
 void Text::setVerticalSpacing(float spacing)
 {
     m_verticalSpacing = spacing;
-    m_dirty = true;
+    invalidateLayout();
 }
 
 void Text::setString(const sf::String& str)
 {
     if (m_string != str)
     {
+        //only the characters after the common prefix need laying out
+        auto prefix = std::mismatch(m_string.begin(), m_string.end(), str.begin(), str.end()).first;
+        m_layoutStart = std::min(m_layoutStart, static_cast<std::size_t>(std::distance(m_string.begin(), prefix)));
+
         m_string = str;
         m_dirty = true;
     }
@@ -93,9 +112,8 @@ void Text::setFillColour(sf::Color colour)
 {
     if (m_fillColour != colour)
     {
-        //TODO rather than dirty just update the vert
-        //colours if the text is not already dirty
         m_fillColour = colour;
+        m_colourDirty = true;
         m_dirty = true;
     }
 }
@@ -105,6 +123,7 @@ void Text::setOutlineColour(sf::Color colour)
     if (m_outlineColour != colour)
     {
         m_outlineColour = colour;
+        m_colourDirty = true;
         m_dirty = true;
     }
 }
@@ -114,7 +133,7 @@ void Text::setOutlineThickness(float thickness)
     if (m_outlineThickness != thickness)
     {
         m_outlineThickness = thickness;
-        m_dirty = true;
+        invalidateLayout();
     }
 }
 
@@ -185,12 +204,19 @@ sf::FloatRect Text::getLocalBounds(xy::Entity entity)
     if (text.m_dirty)
     {
         text.updateVertices(drawable);
-        drawable.setTexture(&text.getFont()->getTexture(text.getCharacterSize()));
-        drawable.setPrimitiveType(sf::PrimitiveType::Triangles);
     }
     return drawable.getLocalBounds();
 }
 
+void Text::releaseFont(const sf::Font& font)
+{
+    //the render thread may be drawing from the atlas
+    App::syncRenderThread();
+
+    Detail::GlyphCache::get().removeFont(font);
+    Detail::DistanceFieldCache::get().removeFont(font);
+}
+
 void Text::setCroppingArea(sf::FloatRect)
 {
     LOG("DEPRECATED: Use Drawable::setCroppingArea() instead.", xy::Logger::Type::Warning);
@@ -204,45 +230,142 @@ sf::FloatRect Text::getCroppingArea() const
 
 void Text::setAlignment(Text::Alignment alignment)
 {
+    //the layout is unaligned, so only the offset is updated
     m_alignment = alignment;
     m_dirty = true;
 }
 
+void Text::setMode(Mode mode)
+{
+    if (m_mode != mode)
+    {
+        m_mode = mode;
+        invalidateLayout();
+    }
+}
+
 //private
 void Text::updateVertices(Drawable& drawable)
 {
     m_dirty = false;
     
     auto& vertices = drawable.getVertices();
-
-    vertices.clear();
     sf::FloatRect localBounds;
     
     //skip if nothing to build
     if (!m_font || m_string.isEmpty())
     {
+        vertices.clear();
+        m_layout.clear();
+        m_layoutStart = 0;
+        m_alignmentOffset = 0.f;
+        m_colourDirty = false;
+
         drawable.updateLocalBounds(localBounds);
         return;
     }
+
+    const bool distanceField = (m_mode == Mode::DistanceField);
+    Detail::DistanceFieldAtlas* atlas = distanceField ? &Detail::DistanceFieldCache::get().getAtlas(*m_font) : nullptr;
+    const auto* texture = distanceField ? &atlas->getTexture() : &m_font->getTexture(m_charSize);
+
+    //keep the vertices of the characters which haven't changed, unless
+    //the drawable's vertices or texture were replaced since the last layout
+    std::size_t start = std::min(m_layoutStart, m_layout.size());
+    const std::size_t previousVertexCount = m_layout.empty() ? 0 : m_layout.back().vertexCount;
+    if (vertices.size() != previousVertexCount
+        || drawable.getTexture() != texture)
+    {
+        start = 0;
+    }
+    m_layout.resize(start);
+
+    const std::size_t keptVertexCount = m_layout.empty() ? 0 : m_layout.back().vertexCount;
+    vertices.resize(keptVertexCount);
+
+    if (m_colourDirty)
+    {
+        updateColours(vertices, keptVertexCount);
+        m_colourDirty = false;
+    }
     
+    //distance field glyphs are stored at the base size and
+    //scaled, and the outline is drawn by the shader. The outline
+    //thickness is limited by the distance stored in the field
+    float scale = 1.f;
+    float fieldOutline = 0.f;
+    if (distanceField)
+    {
+        atlas->addGlyphs(m_string, m_layout.size());
+        scale = static_cast<float>(m_charSize) / Detail::DistanceFieldAtlas::BaseSize;
+        fieldOutline = std::min(std::abs(m_outlineThickness) / scale, Detail::DistanceFieldAtlas::Spread - 1.f);
+    }
+    const bool outlineQuads = !distanceField && m_outlineThickness != 0;
+
     //update glyphs - TODO here we could check for bold fonts in the future
-    float xOffset = static_cast<float>(m_font->getGlyph(L' ', m_charSize, false).advance);
+    auto& fillGlyphs = Detail::GlyphCache::get().getTable(*m_font, distanceField ? Detail::DistanceFieldAtlas::BaseSize : m_charSize, 0.f);
+    auto* outlineGlyphs = outlineQuads ? &Detail::GlyphCache::get().getTable(*m_font, m_charSize, m_outlineThickness) : nullptr;
+
+    auto getGlyph = [&](std::uint32_t codepoint)
+    {
+        if (!distanceField)
+        {
+            return fillGlyphs.getGlyph(codepoint);
+        }
+
+        auto glyph = atlas->getGlyph(codepoint);
+        glyph.advance *= scale;
+        glyph.bounds = { glyph.bounds.left * scale, glyph.bounds.top * scale, glyph.bounds.width * scale, glyph.bounds.height * scale };
+        return glyph;
+    };
+
+    //distance field glyph bounds include the field around the glyph
+    const float inset = distanceField ? (Detail::DistanceFieldAtlas::Spread - fieldOutline) * scale : 0.f;
+
+    float xOffset = static_cast<float>(fillGlyphs.getGlyph(L' ').advance) * scale;
     float yOffset = static_cast<float>(m_font->getLineSpacing(m_charSize));
-    float x = 0.f;
-    float y = static_cast<float>(m_charSize);
+
+    LayoutState state;
+    if (m_layout.empty())
+    {
+        state.y = static_cast<float>(m_charSize);
+        state.minY = state.y;
+    }
+    else
+    {
+        state = m_layout.back();
+    }
+
+    float x = state.x;
+    float y = state.y;
     
-    float minX = x;
-    float minY = y;
-    float maxX = 0.f;
-    float maxY = 0.f;
+    float minX = state.minX;
+    float minY = state.minY;
+    float maxX = state.maxX;
+    float maxY = state.maxY;
     
-    std::uint32_t prevChar = 0;
+    std::uint32_t prevChar = state.prevChar;
     const auto& string = m_string;
-    for (auto i = 0u; i < string.getSize(); ++i)
+    m_layout.reserve(string.getSize());
+
+    auto storeState = [&]()
+    {
+        state.x = x;
+        state.y = y;
+        state.minX = minX;
+        state.minY = minY;
+        state.maxX = maxX;
+        state.maxY = maxY;
+        state.prevChar = prevChar;
+        state.vertexCount = static_cast<std::uint32_t>(vertices.size());
+        m_layout.push_back(state);
+    };
+
+    for (auto i = m_layout.size(); i < string.getSize(); ++i)
     {
         std::uint32_t currChar = string[i];
         
-        x += m_font->getKerning(prevChar, currChar, m_charSize);
+        x += fillGlyphs.getKerning(prevChar, currChar) * scale;
         prevChar = currChar;
         
         //whitespace chars
@@ -269,13 +392,14 @@ void Text::updateVertices(Drawable& drawable)
             maxX = std::max(maxX, x);
             maxY = std::max(maxY, y);
             
+            storeState();
             continue; //skip quad for whitespace
         }
         
         //create the quads.
         auto addOutline = [&]()
         {
-            const auto& glyph = m_font->getGlyph(currChar, m_charSize, false, m_outlineThickness);
+            const auto& glyph = outlineGlyphs->getGlyph(currChar);
 
             float left = glyph.bounds.left;
             float top = glyph.bounds.top;
@@ -292,27 +416,27 @@ void Text::updateVertices(Drawable& drawable)
         };
 
         //if outline is larger, add first
-        if (m_outlineThickness > 0)
+        if (outlineQuads && m_outlineThickness > 0)
         {
             addOutline();
         }
 
-        const auto& glyph = m_font->getGlyph(currChar, m_charSize, false);
+        const auto glyph = getGlyph(currChar);
         addQuad(vertices, sf::Vector2f(x, y), m_fillColour, glyph);
         
         //else add outline on top
-        if (m_outlineThickness < 0)
+        if (outlineQuads && m_outlineThickness < 0)
         {
             addOutline();
         }
 
         //only do this if not outlined
-        if (m_outlineThickness == 0)
+        if (!outlineQuads)
         {
-            float left = glyph.bounds.left;
-            float top = glyph.bounds.top;
-            float right = glyph.bounds.left + glyph.bounds.width;
-            float bottom = glyph.bounds.top + glyph.bounds.height;
+            float left = glyph.bounds.left + inset;
+            float top = glyph.bounds.top + inset;
+            float right = glyph.bounds.left + glyph.bounds.width - inset;
+            float bottom = glyph.bounds.top + glyph.bounds.height - inset;
 
             minX = std::min(minX, x + left);
             maxX = std::max(maxX, x + right);
@@ -321,7 +445,9 @@ void Text::updateVertices(Drawable& drawable)
         }
 
         x += glyph.advance;
+        storeState();
     }
+    m_layoutStart = m_layout.size();
     
     localBounds.left = minX;
     localBounds.top = minY;
@@ -329,7 +455,8 @@ void Text::updateVertices(Drawable& drawable)
     localBounds.height = maxY - minY;
     
     
-    //check for alignment
+    //check for alignment. The kept vertices already
+    //have the previous offset applied, new ones don't
     float offset = 0.f;
     if (m_alignment == Text::Alignment::Centre)
     {
@@ -339,19 +466,80 @@ void Text::updateVertices(Drawable& drawable)
     {
         offset = localBounds.width;
     }
-    if (offset > 0)
+
+    const float keptOffset = offset - m_alignmentOffset;
+    if (keptOffset != 0)
+    {
+        for (auto i = 0u; i < keptVertexCount; ++i)
+        {
+            vertices[i].position.x -= keptOffset;
+        }
+    }
+    if (offset != 0)
     {
-        for (auto& v : vertices)
+        for (auto i = keptVertexCount; i < vertices.size(); ++i)
         {
-            v.position.x -= offset;
+            vertices[i].position.x -= offset;
         }
-        localBounds.left -= offset;
     }
+    localBounds.left -= offset;
+    m_alignmentOffset = offset;
 
     drawable.updateLocalBounds(localBounds);
+    drawable.setTexture(texture);
+    drawable.setPrimitiveType(sf::PrimitiveType::Triangles);
+    drawable.setBatchingEnabled(true);
+
+    auto& fieldCache = Detail::DistanceFieldCache::get();
+    if (distanceField)
+    {
+        drawable.setShader(fieldCache.getShader());
+        drawable.bindUniformToCurrentTexture("u_texture");
+        drawable.bindUniform("u_outlineColour", m_outlineColour);
+        drawable.bindUniform("u_outlineThickness", fieldOutline / (Detail::DistanceFieldAtlas::Spread * 2.f));
+    }
+    else if (fieldCache.isShader(drawable.getShader()))
+    {
+        drawable.setShader(nullptr);
+    }
+}
+
+void Text::updateColours(Drawable::VertexList& vertices, std::size_t count)
+{
+    //each character is a fill quad, plus an outline quad before
+    //or after it when bitmap text is outlined
+    static constexpr std::size_t QuadSize = 6;
+    for (auto i = 0u; i < count; i += QuadSize)
+    {
+        const auto quad = i / QuadSize;
+        bool outline = false;
+        if (m_mode == Mode::Bitmap)
+        {
+            if (m_outlineThickness > 0)
+            {
+                outline = (quad % 2) == 0;
+            }
+            else if (m_outlineThickness < 0)
+            {
+                outline = (quad % 2) == 1;
+            }
+        }
+
+        const auto colour = outline ? m_outlineColour : m_fillColour;
+        for (auto j = i; j < i + QuadSize; ++j)
+        {
+            vertices[j].color = colour;
+        }
+    }
+}
+
+void Text::invalidateLayout()
+{
+    m_layoutStart = 0;
+    m_dirty = true;
 }
 
-void Text::addQuad(std::vector<sf::Vertex>& vertices, sf::Vector2f position, sf::Color colour, const sf::Glyph& glyph,  float outlineThickness)
+void Text::addQuad(Drawable::VertexList& vertices, sf::Vector2f position, sf::Color colour, const sf::Glyph& glyph,  float outlineThickness)
 {
     float left = glyph.bounds.left;
     float top = glyph.bounds.top;
@@ -0,0 +1,306 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include "xyginext/ecs/components/TileMap.hpp"
+#include "xyginext/core/Assert.hpp"
+#include "xyginext/core/Log.hpp"
+
+#include <SFML/Graphics/Texture.hpp>
+
+#include <algorithm>
+
+using namespace xy;
+
+namespace
+{
+    sf::Vector2f getTilePosition(const TileMap::Tileset& tileset, std::uint32_t tileID)
+    {
+        const auto index = tileID - tileset.firstID;
+        const auto x = index % tileset.columnCount;
+        const auto y = index / tileset.columnCount;
+
+        return
+        {
+            static_cast<float>(tileset.margin + (x * (tileset.tileSize.x + tileset.spacing))),
+            static_cast<float>(tileset.margin + (y * (tileset.tileSize.y + tileset.spacing)))
+        };
+    }
+}
+
+TileMap::TileMap()
+    : m_chunkSize       (16u, 16u),
+    m_streamingBorder   (0.f),
+    m_opacity           (1.f),
+    m_time              (0.f)
+{
+
+}
+
+//public
+void TileMap::setSize(sf::Vector2u tileCount, sf::Vector2f tileSize)
+{
+    m_tileCount = tileCount;
+    m_tileSize = tileSize;
+    m_tiles.clear();
+    clearChunks();
+}
+
+void TileMap::setChunkSize(sf::Vector2u size)
+{
+    XY_ASSERT(size.x > 0 && size.y > 0, "Chunk size must be greater than zero");
+    m_chunkSize = size;
+    clearChunks();
+}
+
+void TileMap::addTileset(const Tileset& tileset)
+{
+    XY_ASSERT(tileset.texture, "Tilesets require a texture");
+    XY_ASSERT(tileset.columnCount > 0, "Tilesets require at least one column");
+
+    auto data = std::make_shared<TilesetData>();
+    data->tileset = tileset;
+    data->frames.resize(MaxAnimations * MaxAnimationFrames);
+
+    if (tileset.animations.size() > MaxAnimations)
+    {
+        Logger::log("Tileset has more than " + std::to_string(MaxAnimations) + " animations, extra animations are ignored", Logger::Type::Warning);
+        data->tileset.animations.resize(MaxAnimations);
+    }
+
+    auto inTileset = [&tileset](std::uint32_t id)
+    {
+        return id >= tileset.firstID && id < tileset.firstID + tileset.tileCount;
+    };
+
+    for (auto i = 0u; i < data->tileset.animations.size(); ++i)
+    {
+        auto& animation = data->tileset.animations[i];
+        if (animation.frames.size() > MaxAnimationFrames)
+        {
+            animation.frames.resize(MaxAnimationFrames);
+        }
+
+        //frames outside of this tileset can't be drawn with its texture
+        animation.frames.erase(std::remove_if(animation.frames.begin(), animation.frames.end(),
+            [&inTileset](const Tileset::Animation::Frame& frame)
+            {
+                return !inTileset(frame.tileID) || frame.duration <= 0.f;
+            }), animation.frames.end());
+
+        if (!inTileset(animation.tileID) || animation.frames.empty())
+        {
+            animation.frames.clear();
+            continue;
+        }
+
+        const auto basePosition = getTilePosition(tileset, animation.tileID);
+        float endTime = 0.f;
+        for (auto j = 0u; j < animation.frames.size(); ++j)
+        {
+            const auto& frame = animation.frames[j];
+            auto offset = getTilePosition(tileset, frame.tileID) - basePosition;
+            endTime += frame.duration * 1000.f;
+            data->frames[(i * MaxAnimationFrames) + j] = { offset.x, offset.y, endTime, 0.f };
+        }
+
+        //unused frames end after the animation so they're never selected
+        for (auto j = 0u; j < MaxAnimationFrames; ++j)
+        {
+            auto& frame = data->frames[(i * MaxAnimationFrames) + j];
+            if (j >= animation.frames.size())
+            {
+                frame.z = endTime + 1.f;
+            }
+            frame.w = endTime;
+        }
+    }
+
+    m_tilesets.push_back(data);
+    clearChunks();
+}
+
+void TileMap::setTiles(std::vector<Tile> tiles)
+{
+    XY_ASSERT(tiles.size() == static_cast<std::size_t>(m_tileCount.x) * m_tileCount.y, "Tile count doesn't match map size");
+    m_tiles = std::move(tiles);
+    m_chunkLoader = {};
+    clearChunks();
+}
+
+void TileMap::setTile(sf::Vector2u position, Tile tile)
+{
+    if (m_tiles.empty()
+        || position.x >= m_tileCount.x
+        || position.y >= m_tileCount.y)
+    {
+        return;
+    }
+
+    m_tiles[(position.y * m_tileCount.x) + position.x] = tile;
+
+    sf::Vector2u chunk(position.x / m_chunkSize.x, position.y / m_chunkSize.y);
+    if (std::find(m_dirtyChunks.begin(), m_dirtyChunks.end(), chunk) == m_dirtyChunks.end())
+    {
+        m_dirtyChunks.push_back(chunk);
+    }
+}
+
+void TileMap::setChunkLoader(const ChunkLoader& loader)
+{
+    m_chunkLoader = loader;
+    m_tiles.clear();
+    clearChunks();
+}
+
+void TileMap::setOpacity(float opacity)
+{
+    m_opacity = std::max(0.f, std::min(1.f, opacity));
+    clearChunks();
+}
+
+sf::FloatRect TileMap::getLocalBounds() const
+{
+    return { 0.f, 0.f, m_tileCount.x * m_tileSize.x, m_tileCount.y * m_tileSize.y };
+}
+
+//private
+std::shared_ptr<TileMap::Chunk> TileMap::buildChunk(sf::Vector2u position) const
+{
+    auto chunk = std::make_shared<Chunk>();
+    chunk->position = position;
+
+    const sf::Vector2u start(position.x * m_chunkSize.x, position.y * m_chunkSize.y);
+    const sf::Vector2u end(std::min(start.x + m_chunkSize.x, m_tileCount.x), std::min(start.y + m_chunkSize.y, m_tileCount.y));
+
+    chunk->bounds = { start.x * m_tileSize.x, start.y * m_tileSize.y,
+        (end.x - start.x) * m_tileSize.x, (end.y - start.y) * m_tileSize.y };
+
+    //streamed chunks are always full sized, with empty tiles outside the map
+    std::vector<Tile> loadedTiles;
+    if (m_chunkLoader)
+    {
+        loadedTiles.resize(static_cast<std::size_t>(m_chunkSize.x) * m_chunkSize.y);
+        m_chunkLoader(position, loadedTiles);
+    }
+
+    const auto alpha = static_cast<sf::Uint8>(m_opacity * 255.f);
+
+    for (auto y = start.y; y < end.y; ++y)
+    {
+        for (auto x = start.x; x < end.x; ++x)
+        {
+            const auto& tile = m_chunkLoader ?
+                loadedTiles[((y - start.y) * m_chunkSize.x) + (x - start.x)] :
+                m_tiles[(y * m_tileCount.x) + x];
+
+            if (tile.ID == 0)
+            {
+                continue;
+            }
+
+            auto tileset = std::find_if(m_tilesets.begin(), m_tilesets.end(),
+                [&tile](const std::shared_ptr<const TilesetData>& data)
+                {
+                    return tile.ID >= data->tileset.firstID && tile.ID < data->tileset.firstID + data->tileset.tileCount;
+                });
+
+            if (tileset == m_tilesets.end())
+            {
+                continue;
+            }
+
+            auto geometry = std::find_if(chunk->geometry.begin(), chunk->geometry.end(),
+                [&tileset](const Chunk::Geometry& g)
+                {
+                    return g.tileset == *tileset;
+                });
+
+            if (geometry == chunk->geometry.end())
+            {
+                chunk->geometry.emplace_back().tileset = *tileset;
+                geometry = chunk->geometry.end() - 1;
+            }
+
+            const auto& set = (*tileset)->tileset;
+
+            //animated tiles store their animation index in the red channel,
+            //which the shader uses to look up the current frame
+            sf::Color colour(255, 255, 255, alpha);
+            auto animation = std::find_if(set.animations.begin(), set.animations.end(),
+                [&tile](const Tileset::Animation& a)
+                {
+                    return a.tileID == tile.ID && !a.frames.empty();
+                });
+            if (animation != set.animations.end())
+            {
+                colour.r = static_cast<sf::Uint8>(std::distance(set.animations.begin(), animation));
+            }
+
+            const sf::Vector2f position(x * m_tileSize.x, y * m_tileSize.y);
+            const auto texPosition = getTilePosition(set, tile.ID);
+            const sf::Vector2f texSize(static_cast<float>(set.tileSize.x), static_cast<float>(set.tileSize.y));
+
+            std::array<sf::Vector2f, 4u> texCoords =
+            {
+                texPosition,
+                sf::Vector2f(texPosition.x + texSize.x, texPosition.y),
+                texPosition + texSize,
+                sf::Vector2f(texPosition.x, texPosition.y + texSize.y)
+            };
+
+            //same flip order as Tiled, diagonal first
+            if (tile.flipFlags & FlipFlag::Diagonal)
+            {
+                std::swap(texCoords[1], texCoords[3]);
+            }
+            if (tile.flipFlags & FlipFlag::Horizontal)
+            {
+                std::swap(texCoords[0], texCoords[1]);
+                std::swap(texCoords[2], texCoords[3]);
+            }
+            if (tile.flipFlags & FlipFlag::Vertical)
+            {
+                std::swap(texCoords[0], texCoords[3]);
+                std::swap(texCoords[1], texCoords[2]);
+            }
+
+            auto& vertices = geometry->vertices;
+            vertices.emplace_back(position, colour, texCoords[0]);
+            vertices.emplace_back(sf::Vector2f(position.x + m_tileSize.x, position.y), colour, texCoords[1]);
+            vertices.emplace_back(position + m_tileSize, colour, texCoords[2]);
+            vertices.emplace_back(sf::Vector2f(position.x, position.y + m_tileSize.y), colour, texCoords[3]);
+        }
+    }
+
+    return chunk;
+}
+
+void TileMap::clearChunks()
+{
+    m_chunks.clear();
+    m_dirtyChunks.clear();
+}
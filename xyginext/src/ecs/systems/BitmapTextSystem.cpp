@@ -46,7 +46,7 @@ BitmapTextSystem::BitmapTextSystem(xy::MessageBus& mb)
 //public
 void BitmapTextSystem::process(float)
 {
-    auto entities = getEntities();
+    const auto& entities = getEntities();
     for (auto entity : entities)
     {
         auto& drawable = entity.getComponent<Drawable>();
@@ -55,9 +55,10 @@ void BitmapTextSystem::process(float)
         if (text.m_dirty)
         {
             text.updateVertices(drawable);
-
-            drawable.setTexture(text.getFont()->getTexture());
-            drawable.setPrimitiveType(sf::PrimitiveType::Quads);
+        }
+        else if (text.m_colourDirty)
+        {
+            text.updateColour(drawable);
         }
     }
 }
\ No newline at end of file
@@ -29,6 +29,7 @@ source distribution.
 #include "xyginext/ecs/components/Transform.hpp"
 #include "xyginext/ecs/components/ParticleEmitter.hpp"
 #include "xyginext/core/App.hpp"
+#include "xyginext/graphics/RenderStats.hpp"
 #include "xyginext/util/Const.hpp"
 #include "xyginext/util/Random.hpp"
 #include "xyginext/util/Vector.hpp"
@@ -37,6 +38,8 @@ source distribution.
 #include <SFML/Graphics/RenderTarget.hpp>
 
 #include "../../detail/GLCheck.hpp"
+#include "../../detail/GLStateCache.hpp"
+#include "../../detail/CoreProfile.hpp"
 
 #include <limits>
 
@@ -49,41 +52,6 @@ using namespace xy;
 
 namespace
 {
-    //convert an sf::BlendMode::Factor constant to the corresponding OpenGL constant.
-    //taken from sf::RenderTarget source
-    std::uint32_t factorToGlConstant(sf::BlendMode::Factor blendFactor)
-    {
-        switch (blendFactor)
-        {
-        case sf::BlendMode::Zero:             return GL_ZERO;
-        case sf::BlendMode::One:              return GL_ONE;
-        case sf::BlendMode::SrcColor:         return GL_SRC_COLOR;
-        case sf::BlendMode::OneMinusSrcColor: return GL_ONE_MINUS_SRC_COLOR;
-        case sf::BlendMode::DstColor:         return GL_DST_COLOR;
-        case sf::BlendMode::OneMinusDstColor: return GL_ONE_MINUS_DST_COLOR;
-        case sf::BlendMode::SrcAlpha:         return GL_SRC_ALPHA;
-        case sf::BlendMode::OneMinusSrcAlpha: return GL_ONE_MINUS_SRC_ALPHA;
-        case sf::BlendMode::DstAlpha:         return GL_DST_ALPHA;
-        case sf::BlendMode::OneMinusDstAlpha: return GL_ONE_MINUS_DST_ALPHA;
-        }
-
-        return GL_ZERO;
-    }
-
-
-    //convert an sf::BlendMode::BlendEquation constant to the corresponding OpenGL constant.
-    //taken from sf::RenderTarget source
-    std::uint32_t equationToGlConstant(sf::BlendMode::Equation blendEquation)
-    {
-        switch (blendEquation)
-        {
-        case sf::BlendMode::Add:             return GL_FUNC_ADD;
-        case sf::BlendMode::Subtract:        return GL_FUNC_SUBTRACT;
-        case sf::BlendMode::ReverseSubtract: return GL_FUNC_REVERSE_SUBTRACT;
-        }
-        return GL_FUNC_ADD;
-    }
-
     const std::string VertexShader = R"(
         #version 120    
         
@@ -144,15 +112,95 @@ namespace
             gl_FragColor = gl_Color * texture2D(u_texture, coord);
         })";
 
+    //used by the core profile backend
+    const std::string CoreVertexShader = R"(
+        #version 330 core
+
+        layout (location = 0) in vec3 a_position;
+        layout (location = 1) in vec4 a_colour;
+        layout (location = 2) in vec2 a_rotationScale;
+
+        layout (std140) uniform ViewData
+        {
+            mat4 u_viewProjectionMatrix;
+            float u_screenScale;
+        };
+
+        out mat2 v_rotation;
+        out float v_currentFrame;
+        out vec4 v_colour;
+
+        void main()
+        {
+            vec2 rot = vec2(sin(a_rotationScale.x), cos(a_rotationScale.x));
+            v_rotation[0] = vec2(rot.y, -rot.x);
+            v_rotation[1] = rot;
+
+            v_currentFrame = a_position.z;
+            v_colour = a_colour;
+
+            gl_Position = u_viewProjectionMatrix * vec4(a_position.xy, 0.0, 1.0);
+            gl_PointSize = a_rotationScale.y * u_screenScale;
+        })";
+
+    const std::string CoreFragmentShader = R"(
+        #version 330 core
+
+        uniform sampler2D u_texture;
+
+        uniform float u_frameCount;
+        uniform vec2 u_textureSize;
+
+        in mat2 v_rotation;
+        in float v_currentFrame;
+        in vec4 v_colour;
+
+        out vec4 o_colour;
+
+        void main()
+        {
+            float frameWidth = 1.0 / u_frameCount;
+
+            vec2 coord = gl_PointCoord;
+            coord.x *= frameWidth;
+            coord.x += v_currentFrame * frameWidth;
+
+            vec2 centreOffset = vec2((v_currentFrame * frameWidth) + (frameWidth / 2.0), 0.5);
+
+            coord *= u_textureSize;
+            centreOffset *= u_textureSize;
+
+            coord = v_rotation * (coord - centreOffset);
+            coord += centreOffset;
+
+            coord /= u_textureSize;
+
+            o_colour = v_colour * texture(u_texture, coord);
+        })";
+
     const std::size_t MaxParticleSystems = 64; //max VBOs, must be divisible by min count
     const std::size_t MinParticleSystems = 4; //min amount before resizing. This many are added on resize
 }
 
+struct ParticleSystem::CoreResources final
+{
+    sf::Shader shader;
+    bool loaded = false;
+    std::int32_t textureLocation = -1;
+    std::int32_t frameCountLocation = -1;
+    std::int32_t textureSizeLocation = -1;
+
+    Detail::VertexArray vertexArray;
+    Detail::StreamBuffer vertexBuffer = Detail::StreamBuffer(GL_ARRAY_BUFFER_ARB, sizeof(Vertex) * ParticleEmitter::MaxParticles * MinParticleSystems);
+    Detail::StreamBuffer uniformBuffer = Detail::StreamBuffer(GL_UNIFORM_BUFFER, sizeof(Detail::ViewData));
+};
+
 ParticleSystem::ParticleSystem(xy::MessageBus& mb)
     : xy::System        (mb, typeid(ParticleSystem)),
     m_visible           (true),
     m_arrayCount        (0),
-    m_activeArrayCount  (0)
+    m_activeArrayCount  ({}),
+    m_visibleSnapshot   ({ true, true })
 {
     requireComponent<ParticleEmitter>();
     requireComponent<Transform>();
@@ -162,8 +210,11 @@ ParticleSystem::ParticleSystem(xy::MessageBus& mb)
         Logger::log("Failed creating particle shader", Logger::Type::Error);
     }
 
-    m_emitterArrays.reserve(MaxParticleSystems);
-    m_emitterArrays.resize(MinParticleSystems);
+    for (auto& arrays : m_emitterArrays)
+    {
+        arrays.reserve(MaxParticleSystems);
+        arrays.resize(MinParticleSystems);
+    }
 
     sf::Image img;
     img.create(16, 16, sf::Color::White);
@@ -178,7 +229,25 @@ ParticleSystem::~ParticleSystem()
 //public
 void ParticleSystem::process(float dt)
 {
-    m_activeArrayCount = 0;
+    const auto bufferIndex = App::getSnapshotWriteIndex();
+    auto& emitterArrays = m_emitterArrays[bufferIndex];
+    auto& activeArrayCount = m_activeArrayCount[bufferIndex];
+    activeArrayCount = 0;
+    m_visibleSnapshot[bufferIndex] = m_visible;
+
+    //resized here rather than when entities are added/removed
+    //as the render thread may be reading the other buffer
+    auto arraySize = emitterArrays.size();
+    while (m_arrayCount >= arraySize)
+    {
+        arraySize += MinParticleSystems;
+    }
+    while (arraySize > MinParticleSystems
+        && m_arrayCount < (arraySize - MinParticleSystems))
+    {
+        arraySize -= MinParticleSystems;
+    }
+    emitterArrays.resize(arraySize);
 
     auto& entities = getEntities();
     for (auto& entity : entities)
@@ -287,9 +356,10 @@ void ParticleSystem::process(float dt)
         }
 
         //limit max number of active systems and generate actual vert array
-        if (m_activeArrayCount < MaxParticleSystems) 
+        if (activeArrayCount < MaxParticleSystems
+            && activeArrayCount < emitterArrays.size())
         {
-            auto& vertArray = m_emitterArrays[m_activeArrayCount++];
+            auto& vertArray = emitterArrays[activeArrayCount++];
             vertArray.count = 0;
             vertArray.texture = (emitter.settings.texture) ? emitter.settings.texture : &m_fallbackTexture;
             vertArray.bounds = emitter.m_bounds;
@@ -320,30 +390,32 @@ void ParticleSystem::process(float dt)
 void ParticleSystem::onEntityAdded(xy::Entity)
 {
     m_arrayCount++;
-
-    if (m_arrayCount == m_emitterArrays.size()/* && m_emitterArrays.size() < MaxParticleSystems*/)
-    {
-        m_emitterArrays.resize(m_emitterArrays.size() + MinParticleSystems);
-    }
 }
 
 void ParticleSystem::onEntityRemoved(xy::Entity)
 {
     m_arrayCount--; //if this is right it should never go less than 0...
-    if (m_arrayCount < (m_emitterArrays.size() - MinParticleSystems))
-    {
-        m_emitterArrays.resize(m_emitterArrays.size() - MinParticleSystems);
-    }
 }
 
 
 void ParticleSystem::draw(sf::RenderTarget& rt, sf::RenderStates) const
 {
-    //TODO lookup and cache shader uniforms - however this will need special
-    //care when setting custom shaders
-    if (m_visible)
+    if (m_visibleSnapshot[App::getSnapshotReadIndex()] && rt.setActive(true))
     {
-        rt.resetGLStates();
+        RenderStats::Scope scope("ParticleSystem");
+
+        //set the state SFML would usually set via resetGLStates()
+        auto& glState = Detail::GLStateCache::get();
+        glState.invalidate();
+        glState.setEnabled(GL_CULL_FACE, false);
+        glState.setEnabled(GL_LIGHTING, false);
+        glState.setEnabled(GL_DEPTH_TEST, false);
+        glState.setEnabled(GL_ALPHA_TEST, false);
+        glState.setEnabled(GL_BLEND, true);
+        if (GLAD_GL_ARB_vertex_buffer_object)
+        {
+            glCheck(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
+        }
 
         const auto& view = rt.getView();
         sf::FloatRect viewableArea(view.getCenter() - (view.getSize() / 2.f), view.getSize());
@@ -353,63 +425,167 @@ void ParticleSystem::draw(sf::RenderTarget& rt, sf::RenderStates) const
         auto top = rt.getSize().y - (viewport.top + viewport.height);
         glCheck(glViewport(viewport.left, top, viewport.width, viewport.height));
 
-        //set the projection matrix
-        glCheck(glMatrixMode(GL_PROJECTION));
-        glCheck(glLoadMatrixf(view.getTransform().getMatrix()));
+        //scale particles to match screen size
+        float ratio = static_cast<float>(rt.getSize().x) / viewableArea.width;
 
-        //go back to model-view mode
-        glCheck(glMatrixMode(GL_MODELVIEW));
+        glState.setEnabled(GL_PROGRAM_POINT_SIZE, true);
+        glState.setEnabled(GL_POINT_SPRITE, true);
 
+        if (App::getRenderBackend() == App::RenderBackend::Core
+            && loadCoreResources())
+        {
+            drawCore(view, viewableArea, ratio);
+        }
+        else
+        {
+            drawLegacy(view, viewableArea, ratio);
+        }
 
-        //apply the shader
-        sf::Shader::bind(&m_shader);
+        glState.bindShader(nullptr);
 
-        //scale particles to match screen size
-        float ratio = static_cast<float>(rt.getSize().x) / viewableArea.width;
-        m_shader.setUniform("u_screenScale", ratio);
+        glState.setEnabled(GL_PROGRAM_POINT_SIZE, false);
+        glState.setEnabled(GL_POINT_SPRITE, false);
+
+        //SFML caches the last texture and blend mode it used, so
+        //these need to be reset else its next draw may skip them
+        rt.resetGLStates();
+    }
+}
 
-        //we shouldn't need to apply the view as SFML ought to have
-        //set it up before the RenderTarget calls this function
+void ParticleSystem::drawLegacy(const sf::View& view, sf::FloatRect viewableArea, float ratio) const
+{
+    auto& glState = Detail::GLStateCache::get();
+    glState.setClientState(GL_VERTEX_ARRAY, true);
+    glState.setClientState(GL_COLOR_ARRAY, true);
+    glState.setClientState(GL_TEXTURE_COORD_ARRAY, true);
+
+    //set the projection matrix
+    glCheck(glMatrixMode(GL_PROJECTION));
+    glCheck(glLoadMatrixf(view.getTransform().getMatrix()));
+
+    //go back to model-view mode
+    glCheck(glMatrixMode(GL_MODELVIEW));
+
+    //apply the shader
+    glState.bindShader(&m_shader);
+    m_shader.setUniform("u_screenScale", ratio);
+
+    //set up the model matrix
+    //particles are always emitted in world space so we use an identity matrix
+    //and load it just once before rendering the particle arrays
+    glCheck(glLoadIdentity());
+
+    const auto bufferIndex = App::getSnapshotReadIndex();
+    const auto& emitterArrays = m_emitterArrays[bufferIndex];
+    const auto activeArrayCount = m_activeArrayCount[bufferIndex];
+    for (auto i = 0u; i < activeArrayCount; ++i)
+    {
+        if (emitterArrays[i].bounds.intersects(viewableArea))
+        {
+            glState.bindTexture(emitterArrays[i].texture);
+            m_shader.setUniform("u_frameCount", static_cast<float>(emitterArrays[i].frameCount));
+            m_shader.setUniform("u_texture", sf::Shader::CurrentTexture);
+            m_shader.setUniform("u_textureSize", sf::Glsl::Vec2(emitterArrays[i].texture->getSize()));
+
+            //blend mode
+            glState.setBlendMode(emitterArrays[i].blendMode);
+
+            const auto* data = reinterpret_cast<const char*>(emitterArrays[i].vertices.data());
+            glCheck(glVertexPointer(3, GL_FLOAT, sizeof(Vertex), data + Vertex::PositionOffset));
+            glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + Vertex::ColourOffset));
+            glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + Vertex::UVOffset));
+
+            glCheck(glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(emitterArrays[i].count)));
+            RenderStats::addDrawCall(static_cast<std::uint32_t>(emitterArrays[i].count));
+        }
+    }
+}
+
+void ParticleSystem::drawCore(const sf::View& view, sf::FloatRect viewableArea, float ratio) const
+{
+    auto& core = *m_coreResources;
+    auto& glState = Detail::GLStateCache::get();
 
-        glCheck(glEnable(GL_PROGRAM_POINT_SIZE));
-        glCheck(glEnable(GL_POINT_SPRITE));
+    Detail::ViewData viewData;
+    std::copy(view.getTransform().getMatrix(), view.getTransform().getMatrix() + 16, viewData.viewProjectionMatrix);
+    viewData.screenScale = ratio;
 
-        //TODO can we ask SFML if this is already enabled?
-        glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+    core.uniformBuffer.bind();
+    core.uniformBuffer.write(&viewData, sizeof(viewData), sizeof(viewData));
+    glCheck(glBindBufferBase(GL_UNIFORM_BUFFER, Detail::ViewUniformBinding, core.uniformBuffer.getHandle()));
 
-        //set up the model matrix
-        //particles are always emitted in world space so we use an identity matrix
-        //and load it just once before rendering the particle arrays
-        glCheck(glLoadIdentity());
+    glState.bindShader(&core.shader);
+    glCheck(glUniform1iARB(core.textureLocation, 0));
+    glCheck(glActiveTextureARB(GL_TEXTURE0_ARB));
 
-        for (auto i = 0u; i < m_activeArrayCount; ++i)
+    core.vertexBuffer.bind();
+    core.vertexArray.bind([]()
         {
-            if (m_emitterArrays[i].bounds.intersects(viewableArea))
+            glCheck(glEnableVertexAttribArrayARB(0));
+            glCheck(glVertexAttribPointerARB(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(Vertex::PositionOffset)));
+            glCheck(glEnableVertexAttribArrayARB(1));
+            glCheck(glVertexAttribPointerARB(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), reinterpret_cast<void*>(Vertex::ColourOffset)));
+            glCheck(glEnableVertexAttribArrayARB(2));
+            glCheck(glVertexAttribPointerARB(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(Vertex::UVOffset)));
+        });
+
+    const sf::Texture* lastTexture = nullptr;
+    const auto bufferIndex = App::getSnapshotReadIndex();
+    const auto& emitterArrays = m_emitterArrays[bufferIndex];
+    const auto activeArrayCount = m_activeArrayCount[bufferIndex];
+    for (auto i = 0u; i < activeArrayCount; ++i)
+    {
+        const auto& emitterArray = emitterArrays[i];
+        if (emitterArray.count > 0
+            && emitterArray.bounds.intersects(viewableArea))
+        {
+            const auto first = core.vertexBuffer.write(emitterArray.vertices.data(), emitterArray.count * sizeof(Vertex), sizeof(Vertex));
+
+            if (emitterArray.texture != lastTexture)
             {
-                //TODO can we query SFML to find out if this texture is already bound?
-                //bind() doesn't track this for us.
-                sf::Texture::bind(m_emitterArrays[i].texture);
-                m_shader.setUniform("u_frameCount", static_cast<float>(m_emitterArrays[i].frameCount));
-                m_shader.setUniform("u_texture", sf::Shader::CurrentTexture);
-                m_shader.setUniform("u_textureSize", sf::Glsl::Vec2(m_emitterArrays[i].texture->getSize()));
-
-                //blend mode
-                glCheck(glBlendFunc(factorToGlConstant(m_emitterArrays[i].blendMode.colorSrcFactor), factorToGlConstant(m_emitterArrays[i].blendMode.colorDstFactor)));
-
-                const auto* data = reinterpret_cast<const char*>(m_emitterArrays[i].vertices.data());
-                glCheck(glVertexPointer(3, GL_FLOAT, sizeof(Vertex), data + Vertex::PositionOffset));
-                glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + Vertex::ColourOffset));
-                glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + Vertex::UVOffset));
-
-                glCheck(glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(m_emitterArrays[i].count)));
+                glCheck(glBindTexture(GL_TEXTURE_2D, emitterArray.texture->getNativeHandle()));
+                glCheck(glUniform2fARB(core.textureSizeLocation, static_cast<float>(emitterArray.texture->getSize().x), static_cast<float>(emitterArray.texture->getSize().y)));
+                lastTexture = emitterArray.texture;
             }
+            glCheck(glUniform1fARB(core.frameCountLocation, static_cast<float>(emitterArray.frameCount)));
+            glState.setBlendMode(emitterArray.blendMode);
+
+            glCheck(glDrawArrays(GL_POINTS, static_cast<GLint>(first), static_cast<GLsizei>(emitterArray.count)));
+            RenderStats::addDrawCall(static_cast<std::uint32_t>(emitterArray.count));
         }
+    }
 
-        sf::Shader::bind(nullptr);
+    Detail::VertexArray::unbind();
+    glCheck(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
+    glCheck(glBindBufferBase(GL_UNIFORM_BUFFER, Detail::ViewUniformBinding, 0));
+    glCheck(glBindTexture(GL_TEXTURE_2D, 0));
+}
 
-        glCheck(glDisable(GL_PROGRAM_POINT_SIZE));
-        glCheck(glDisable(GL_POINT_SPRITE));
+bool ParticleSystem::loadCoreResources() const
+{
+    if (!m_coreResources)
+    {
+        m_coreResources = std::make_unique<CoreResources>();
+        auto& core = *m_coreResources;
+        if (core.shader.loadFromMemory(CoreVertexShader, CoreFragmentShader))
+        {
+            const auto program = core.shader.getNativeHandle();
+            auto blockIndex = glGetUniformBlockIndex(program, "ViewData");
+            if (blockIndex != GL_INVALID_INDEX)
+            {
+                glCheck(glUniformBlockBinding(program, blockIndex, Detail::ViewUniformBinding));
 
-        rt.resetGLStates();
+                core.textureLocation = glGetUniformLocationARB(Detail::toGlHandle(program), "u_texture");
+                core.frameCountLocation = glGetUniformLocationARB(Detail::toGlHandle(program), "u_frameCount");
+                core.textureSizeLocation = glGetUniformLocationARB(Detail::toGlHandle(program), "u_textureSize");
+                core.loaded = true;
+            }
+        }
+
+        if (!core.loaded)
+        {
+            Logger::log("Failed creating core profile particle shader, falling back to legacy rendering", Logger::Type::Error);
+        }
     }
+    return m_coreResources->loaded;
 }
@@ -29,147 +29,1640 @@ source distribution.
 
 #include "xyginext/ecs/components/Transform.hpp"
 #include "xyginext/ecs/components/Drawable.hpp"
+#include "xyginext/ecs/components/Camera.hpp"
+#include "xyginext/ecs/Scene.hpp"
+#include "xyginext/core/App.hpp"
+#include "xyginext/core/Assert.hpp"
+#include "xyginext/core/Log.hpp"
+#include "xyginext/graphics/RenderStats.hpp"
 
 #include "xyginext/util/Rectangle.hpp"
 
 #include "../../detail/GLCheck.hpp"
+#include "../../detail/GLStateCache.hpp"
+#include "../../detail/CoreProfile.hpp"
+#include "../../detail/FrameTable.hpp"
+#include "../../detail/WorkerPool.hpp"
 
 #include <SFML/Graphics/RenderStates.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/View.hpp>
 #include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Texture.hpp>
 #include <SFML/OpenGL.hpp>
 
 #include <limits>
+#include <array>
+#include <algorithm>
+#include <thread>
+#include <cstddef>
+#include <cmath>
+
+namespace
+{
+    //when fewer than this many keys changed since the last frame the
+    //queue is still mostly sorted, so an insertion sort is cheaper
+    constexpr std::size_t IncrementalSortThreshold = 16;
+
+    constexpr std::uint64_t LayerBits = 4;
+    constexpr std::uint64_t DepthBits = 32;
+    constexpr std::uint64_t ShaderBits = 10;
+    constexpr std::uint64_t TextureBits = 10;
+    constexpr std::uint64_t BlendBits = 8;
+
+    constexpr std::uint64_t LayerShift = DepthBits + ShaderBits + TextureBits + BlendBits;
+    constexpr std::uint64_t DepthShift = ShaderBits + TextureBits + BlendBits;
+    constexpr std::uint64_t ShaderShift = TextureBits + BlendBits;
+    constexpr std::uint64_t TextureShift = BlendBits;
+
+    //the last blend ID is shared by any modes beyond these
+    constexpr std::size_t MaxBlendModes = (1u << BlendBits) - 1;
+
+    static_assert(LayerShift + LayerBits == 64, "Sort key should use all 64 bits");
+    static_assert((1u << LayerBits) == xy::Drawable::MaxLayers, "Update the number of layer bits in the sort key");
+
+    //colours drawn into a transparent texture with alpha blending
+    //end up multiplied by their alpha
+    const sf::BlendMode PremultipliedAlpha(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha);
+
+    //flushed when reached to limit the size of the stream buffer
+    constexpr std::size_t MaxBatchInstances = 4096;
+
+    //two rows of the affine transform, the texture rect in whole pixels
+    //which is also the quad size, the colour and any GPU animation.
+    //48 bytes vs 80 bytes for the four sf::Vertex a sprite would
+    //otherwise use
+    struct InstanceVertex final
+    {
+        std::array<float, 6u> transform = {};
+        std::array<std::int16_t, 4u> textureRect = {};
+        sf::Color colour;
+        //first frame, frame count * 64 + loop start
+        std::array<std::uint16_t, 2u> animationFrames = {};
+        //framerate, start time
+        std::array<float, 2u> animationTiming = {};
+    };
+    static_assert(sizeof(InstanceVertex) == 48, "Update the instance attributes");
+
+    //fractional or very large texture rects are drawn without instancing
+    bool canPackTextureRect(const sf::FloatRect& rect)
+    {
+        const auto fits = [](float v)
+        {
+            return v >= std::numeric_limits<std::int16_t>::min()
+                && v <= std::numeric_limits<std::int16_t>::max()
+                && v == std::floor(v);
+        };
+        return fits(rect.left) && fits(rect.top) && fits(rect.width) && fits(rect.height);
+    }
+
+    static_assert(xy::Detail::FrameTable::MaxFrames == 1024, "Update the size of the frame table in the instance shader");
+
+    //the unit quad is generated from gl_VertexID as a triangle strip
+    const std::string InstanceVertexShader = R"(
+        #version 330 core
+
+        layout(location = 0) in vec3 a_transformRow0;
+        layout(location = 1) in vec3 a_transformRow1;
+        layout(location = 2) in vec4 a_textureRect;
+        layout(location = 3) in vec4 a_colour;
+        layout(location = 4) in vec2 a_animationFrames;
+        layout(location = 5) in vec2 a_animationTiming;
+
+        layout(std140) uniform FrameTable
+        {
+            vec4 u_frames[1024];
+        };
+
+        uniform mat4 u_viewProjectionMatrix;
+        uniform mat4 u_textureMatrix;
+        uniform float u_time;
+
+        out vec2 v_texCoord;
+        out vec4 v_colour;
+
+        void main()
+        {
+            vec4 textureRect = a_textureRect;
+            if (a_animationFrames.y > 0.0)
+            {
+                float frameCount = floor(a_animationFrames.y / 64.0);
+                float loopStart = a_animationFrames.y - (frameCount * 64.0);
+                float frame = floor(max(u_time - a_animationTiming.y, 0.0) * a_animationTiming.x);
+                if (frame >= frameCount)
+                {
+                    frame = loopStart + mod(frame - loopStart, frameCount - loopStart);
+                }
+                textureRect = u_frames[int(a_animationFrames.x + frame)];
+            }
+
+            vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+            vec3 position = vec3(corner * textureRect.zw, 1.0);
+
+            gl_Position = u_viewProjectionMatrix * vec4(dot(a_transformRow0, position), dot(a_transformRow1, position), 0.0, 1.0);
+            v_texCoord = (u_textureMatrix * vec4(textureRect.xy + (corner * textureRect.zw), 0.0, 1.0)).xy;
+            v_colour = a_colour;
+        })";
+
+    const std::string InstanceFragmentShader = R"(
+        #version 330 core
+
+        uniform sampler2D u_texture;
+
+        in vec2 v_texCoord;
+        in vec4 v_colour;
+
+        out vec4 o_colour;
+
+        void main()
+        {
+            o_colour = texture(u_texture, v_texCoord) * v_colour;
+        })";
+
+    //enables the given flags, disabling any which were active for the
+    //previous drawable but aren't required by this one
+    void applyGlFlags(const std::int32_t* flags, std::size_t count, std::array<std::int32_t, 4u>& active, std::size_t& activeCount)
+    {
+        auto& glState = xy::Detail::GLStateCache::get();
+        for (auto i = 0u; i < activeCount; ++i)
+        {
+            if (std::find(flags, flags + count, active[i]) == flags + count)
+            {
+                glState.setEnabled(active[i], false);
+            }
+        }
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            glState.setEnabled(flags[i], true);
+            active[i] = flags[i];
+        }
+        activeCount = count;
+    }
+
+    //only these can be appended to one another
+    bool isListPrimitive(sf::PrimitiveType type)
+    {
+        return type == sf::Points || type == sf::Lines
+            || type == sf::Triangles || type == sf::Quads;
+    }
+}
+
+struct xy::RenderSystem::InstanceBatch final
+{
+    sf::Shader shader;
+    bool loaded = false;
+    std::int32_t textureLocation = -1;
+    std::int32_t textureMatrixLocation = -1;
+    std::int32_t viewProjectionLocation = -1;
+    std::int32_t timeLocation = -1;
+
+    //only uploaded when the frame table changes
+    Detail::StreamBuffer frameBuffer = Detail::StreamBuffer(GL_UNIFORM_BUFFER, sizeof(sf::FloatRect) * Detail::FrameTable::MaxFrames);
+    const std::vector<sf::FloatRect>* uploadedFrames = nullptr;
+
+    Detail::VertexArray vertexArray;
+    Detail::StreamBuffer instanceBuffer = Detail::StreamBuffer(GL_ARRAY_BUFFER_ARB, sizeof(InstanceVertex) * MaxBatchInstances * 4);
+
+    std::vector<InstanceVertex> instances;
+    const sf::Texture* texture = nullptr;
+    sf::BlendMode blendMode;
+    bool depthWriteEnabled = true;
+};
+
+struct xy::RenderSystem::MeshBatch final
+{
+    //the first mesh is drawn as it is if nothing is merged with it
+    sf::RenderStates states;
+    const sf::Vertex* firstVertices = nullptr;
+    std::size_t firstVertexCount = 0;
+
+    sf::PrimitiveType primitiveType = sf::Triangles;
+    const xy::Drawable::UniformBindings* uniforms = nullptr;
+    bool depthWriteEnabled = true;
+    std::size_t meshCount = 0;
+
+    std::vector<sf::Vertex> vertices; //in world space
+};
+
+struct xy::RenderSystem::LayerTexture final
+{
+    sf::RenderTexture texture;
+    bool created = false;
+    sf::FloatRect region;
+    std::uint64_t revision = 0;
+    std::uint64_t filterFlags = 0;
+};
 
 xy::RenderSystem::RenderSystem(xy::MessageBus& mb)
     : xy::System        (mb, typeid(xy::RenderSystem)),
     m_wantsSorting      (true),
+    m_changedKeys       (0),
+    m_blendModesExhausted(false),
+    m_useBroadphase     (false),
+    m_frameCount        (0),
     m_filterFlags       (std::numeric_limits<std::uint64_t>::max()),
     m_lastDrawCount     (0),
-    m_depthWriteEnabled (true)
+    m_frameTime         (0.f)
+{
+    requireComponent<xy::Drawable>();
+    requireComponent<xy::Transform>();
+}
+
+xy::RenderSystem::~RenderSystem() = default;
+
+void xy::RenderSystem::updateFrame()
+{
+    m_frameCount++;
+
+    if (m_useBroadphase)
+    {
+        //static drawables are never touched here, sort keys
+        //are updated for visible drawables when they are culled
+        for (auto entity : m_dynamicEntities)
+        {
+            if (updateBounds(entity))
+            {
+                const auto& drawable = entity.getComponent<xy::Drawable>();
+                if (drawable.m_treeID != TreeNode::Null)
+                {
+                    m_tree.moveNode(drawable.m_treeID, drawable.m_worldBounds, {});
+                }
+            }
+        }
+    }
+    else
+    {
+        for (auto& item : m_renderQueue)
+        {
+            auto key = refreshSortKey(item.entity.getComponent<xy::Drawable>());
+            if (key != item.key)
+            {
+                item.key = key;
+                m_changedKeys++;
+                m_wantsSorting = true;
+            }
+
+            updateBounds(item.entity);
+        }
+
+        //do Z sorting
+        if (m_wantsSorting)
+        {
+            m_wantsSorting = false;
+
+            if (m_changedKeys > IncrementalSortThreshold)
+            {
+                radixSort(m_renderQueue, m_sortBuffer);
+            }
+            else
+            {
+                insertionSort(m_renderQueue);
+            }
+            m_changedKeys = 0;
+        }
+    }
+
+    updateVisibility();
+    updateLayerRegions();
+
+    if (App::isRenderThreadEnabled())
+    {
+        writeSnapshot();
+    }
+}
+
+//public
+void xy::RenderSystem::setCullingBorder(float size)
+{
+    m_cullingBorder = { size, size };
+}
+
+void xy::RenderSystem::setBroadphaseCulling(bool enabled)
+{
+    if (enabled == m_useBroadphase)
+    {
+        return;
+    }
+
+    m_useBroadphase = enabled;
+
+    m_tree.clear();
+    m_dynamicEntities.clear();
+    m_unculledEntities.clear();
+
+    if (enabled)
+    {
+        for (auto entity : getEntities())
+        {
+            addToBroadphase(entity);
+        }
+    }
+    else
+    {
+        //keys weren't maintained while using the broadphase
+        for (auto& item : m_renderQueue)
+        {
+            auto& drawable = item.entity.getComponent<xy::Drawable>();
+            drawable.m_treeID = TreeNode::Null;
+            drawable.m_wantsSorting = false;
+            drawable.m_sortKey = getSortKey(drawable);
+            item.key = drawable.m_sortKey;
+        }
+        radixSort(m_renderQueue, m_sortBuffer);
+        m_changedKeys = 0;
+    }
+}
+
+void xy::RenderSystem::setLayerCached(std::uint8_t layer, bool cached, float tileSize, float resolution)
+{
+    XY_ASSERT(layer < m_cachedLayers.size(), "Layer out of range");
+    XY_ASSERT(tileSize > 0.f && resolution > 0.f, "Tile size and resolution must be greater than zero");
+
+    if (layer < m_cachedLayers.size())
+    {
+        auto& cache = m_cachedLayers[layer];
+        cache.enabled = cached;
+        cache.tileSize = tileSize;
+        cache.resolution = resolution;
+        cache.region = {};
+        cache.dirty = true;
+    }
+}
+
+bool xy::RenderSystem::isLayerCached(std::uint8_t layer) const
+{
+    return layer < m_cachedLayers.size() && m_cachedLayers[layer].enabled;
+}
+
+void xy::RenderSystem::invalidateLayer(std::uint8_t layer)
+{
+    if (layer < m_cachedLayers.size())
+    {
+        m_cachedLayers[layer].dirty = true;
+    }
+}
+
+//private
+void xy::RenderSystem::onEntityAdded(xy::Entity entity)
+{
+    auto& drawable = entity.getComponent<xy::Drawable>();
+    m_cachedLayers[drawable.m_layer].dirty = true;
+    drawable.m_wantsSorting = false;
+    drawable.m_sortKey = getSortKey(drawable);
+    drawable.m_boundsDirty = true;
+    updateBounds(entity);
+
+    auto& item = m_renderQueue.emplace_back();
+    item.key = drawable.m_sortKey;
+    item.entity = entity;
+
+    m_changedKeys++;
+    m_wantsSorting = true;
+
+    if (m_useBroadphase)
+    {
+        addToBroadphase(entity);
+    }
+}
+
+void xy::RenderSystem::onEntityRemoved(xy::Entity entity)
+{
+    m_cachedLayers[entity.getComponent<xy::Drawable>().m_layer].dirty = true;
+
+    //erasing preserves the order so no re-sort is needed
+    m_renderQueue.erase(std::remove_if(m_renderQueue.begin(), m_renderQueue.end(),
+        [entity](const QueueItem& item)
+        {
+            return item.entity == entity;
+        }), m_renderQueue.end());
+
+    if (m_useBroadphase)
+    {
+        removeFromBroadphase(entity);
+    }
+}
+
+std::uint64_t xy::RenderSystem::getSortKey(const xy::Drawable& drawable) const
+{
+    //flipping the sign bit makes negative depths sort before positive
+    std::uint64_t key = static_cast<std::uint32_t>(drawable.m_zDepth) ^ 0x80000000u;
+    key <<= DepthShift;
+    key |= std::uint64_t(drawable.m_layer) << LayerShift;
+
+    //ids only need to be unique enough to group similar states, collisions
+    //cost some extra state changes but never affect the depth order
+    if (drawable.m_shader)
+    {
+        key |= (std::uint64_t(drawable.m_shader->getNativeHandle()) & ((1ull << ShaderBits) - 1)) << ShaderShift;
+    }
+
+    if (drawable.m_texture)
+    {
+        key |= (std::uint64_t(drawable.m_texture->getNativeHandle()) & ((1ull << TextureBits) - 1)) << TextureShift;
+    }
+
+    //the table is bounded so it's never searched for more than a few hundred modes
+    auto blendID = static_cast<std::size_t>(std::find(m_blendModes.begin(), m_blendModes.end(), drawable.m_blendMode) - m_blendModes.begin());
+    if (blendID == m_blendModes.size())
+    {
+        if (m_blendModes.size() < MaxBlendModes)
+        {
+            m_blendModes.push_back(drawable.m_blendMode);
+        }
+        else if (!m_blendModesExhausted)
+        {
+            //these are no longer grouped, which only costs state changes
+            Logger::log("More than " + std::to_string(MaxBlendModes) + " blend modes in use, further modes will share a sort ID", Logger::Type::Warning);
+            m_blendModesExhausted = true;
+        }
+    }
+    key |= std::uint64_t(blendID);
+
+    return key;
+}
+
+std::uint64_t xy::RenderSystem::refreshSortKey(xy::Drawable& drawable) const
+{
+    if (drawable.m_wantsSorting)
+    {
+        drawable.m_wantsSorting = false;
+
+        auto key = getSortKey(drawable);
+        if (key != drawable.m_sortKey)
+        {
+            //may have moved from one layer to another
+            m_cachedLayers[drawable.m_sortKey >> LayerShift].dirty = true;
+            m_cachedLayers[key >> LayerShift].dirty = true;
+            drawable.m_sortKey = key;
+        }
+    }
+    return drawable.m_sortKey;
+}
+
+void xy::RenderSystem::radixSort(std::vector<QueueItem>& items, std::vector<QueueItem>& buffer)
+{
+    //LSD radix sort a byte at a time. It's stable so drawables with
+    //equal keys keep their relative order between frames
+    if (items.empty())
+    {
+        return;
+    }
+    buffer.resize(items.size());
+
+    auto* src = &items;
+    auto* dst = &buffer;
+
+    for (auto shift = 0u; shift < 64u; shift += 8u)
+    {
+        std::array<std::size_t, 256> offsets = {};
+        for (const auto& item : *src)
+        {
+            offsets[(item.key >> shift) & 0xff]++;
+        }
+
+        //skip the pass if every key has the same value in this byte
+        if (offsets[(src->front().key >> shift) & 0xff] == src->size())
+        {
+            continue;
+        }
+
+        std::size_t total = 0;
+        for (auto& offset : offsets)
+        {
+            auto count = offset;
+            offset = total;
+            total += count;
+        }
+
+        for (const auto& item : *src)
+        {
+            (*dst)[offsets[(item.key >> shift) & 0xff]++] = item;
+        }
+        std::swap(src, dst);
+    }
+
+    if (src != &items)
+    {
+        items.swap(buffer);
+    }
+}
+
+void xy::RenderSystem::insertionSort(std::vector<QueueItem>& items)
+{
+    for (auto i = 1u; i < items.size(); ++i)
+    {
+        if (items[i].key < items[i - 1].key)
+        {
+            auto item = items[i];
+            auto j = i;
+            do
+            {
+                items[j] = items[j - 1];
+                --j;
+            } while (j > 0 && item.key < items[j - 1].key);
+            items[j] = item;
+        }
+    }
+}
+
+void xy::RenderSystem::addToBroadphase(xy::Entity entity)
+{
+    auto& drawable = entity.getComponent<xy::Drawable>();
+    drawable.m_treeID = TreeNode::Null;
+
+    if (drawable.m_cull)
+    {
+        drawable.m_treeID = m_tree.addToTree(drawable.m_worldBounds, entity);
+    }
+    else
+    {
+        m_unculledEntities.push_back(entity);
+    }
+
+    if (drawable.m_static)
+    {
+        //this is the only chance static drawables get to update
+        updateBounds(entity);
+    }
+    else
+    {
+        m_dynamicEntities.push_back(entity);
+    }
+}
+
+void xy::RenderSystem::removeFromBroadphase(xy::Entity entity)
+{
+    auto& drawable = entity.getComponent<xy::Drawable>();
+    if (drawable.m_treeID != TreeNode::Null)
+    {
+        m_tree.removeFromTree(drawable.m_treeID);
+        drawable.m_treeID = TreeNode::Null;
+    }
+
+    m_dynamicEntities.erase(std::remove(m_dynamicEntities.begin(), m_dynamicEntities.end(), entity), m_dynamicEntities.end());
+    m_unculledEntities.erase(std::remove(m_unculledEntities.begin(), m_unculledEntities.end(), entity), m_unculledEntities.end());
+}
+
+bool xy::RenderSystem::updateBounds(xy::Entity entity)
+{
+    auto& drawable = entity.getComponent<xy::Drawable>();
+    if (drawable.m_contentChanged)
+    {
+        drawable.m_contentChanged = false;
+        m_cachedLayers[drawable.m_layer].dirty = true;
+    }
+
+    //sf::Transform is a column major 4x4 matrix
+    const auto xForm = entity.getComponent<xy::Transform>().getWorldTransform();
+    const auto* matrix = xForm.getMatrix();
+    const std::array<float, 6u> affine = { matrix[0], matrix[1], matrix[4], matrix[5], matrix[12], matrix[13] };
+
+    if (!drawable.m_boundsDirty
+        && affine == drawable.m_boundsTransform)
+    {
+        return false;
+    }
+    drawable.m_boundsDirty = false;
+    drawable.m_boundsTransform = affine;
+    m_cachedLayers[drawable.m_layer].dirty = true;
+    drawable.m_worldBounds = xForm.transformRect(drawable.m_localBounds);
+
+    //no cold data means no cropping area was ever set
+    auto* coldData = drawable.m_coldData.get();
+    drawable.m_cropped = coldData && !Util::Rectangle::contains(coldData->croppingArea, drawable.m_localBounds);
+
+    if (drawable.m_cropped)
+    {
+        //update world positions
+        auto& worldArea = coldData->croppingWorldArea;
+        worldArea = xForm.transformRect(coldData->croppingArea);
+        worldArea.top += worldArea.height;
+        worldArea.height = -worldArea.height;
+    }
+    return true;
+}
+
+void xy::RenderSystem::updateVisibility()
+{
+    const auto* scene = getScene();
+    const auto& cameras = scene->getRenderCameras();
+
+    if (cameras.empty())
+    {
+        m_visibilityLists.resize(1);
+        m_visibilityLists[0].camera = scene->getActiveCamera();
+    }
+    else
+    {
+        m_visibilityLists.resize(cameras.size());
+        for (auto i = 0u; i < cameras.size(); ++i)
+        {
+            m_visibilityLists[i].camera = cameras[i];
+        }
+    }
+
+    for (auto& list : m_visibilityLists)
+    {
+        list.frame = m_frameCount;
+        list.viewableArea = {};
+        if (!list.camera.destroyed()
+            && list.camera.hasComponent<Camera>())
+        {
+            list.viewableArea = getViewableArea(list.camera.getComponent<Camera>().m_view, m_cullingBorder);
+        }
+    }
+
+    //world bounds were all updated in process(), so culling only reads
+    //shared data and each camera can be processed on its own thread.
+    //Updating sort keys writes to the drawables so is done in between
+    if (m_visibilityLists.size() == 1)
+    {
+        collectVisible(m_visibilityLists[0]);
+        refreshSortKeys(m_visibilityLists[0]);
+        sortVisible(m_visibilityLists[0]);
+    }
+    else
+    {
+        //this thread takes a camera too, so needs one fewer worker
+        const std::size_t workerCount = std::min(m_visibilityLists.size() - 1,
+            static_cast<std::size_t>(std::max(1u, std::thread::hardware_concurrency()) - 1));
+        if (!m_cullingWorkers
+            || m_cullingWorkers->getWorkerCount() < workerCount)
+        {
+            m_cullingWorkers = std::make_unique<Detail::WorkerPool>(workerCount);
+        }
+
+        m_cullingWorkers->run(m_visibilityLists.size(), [&](std::size_t i) { collectVisible(m_visibilityLists[i]); });
+
+        if (m_useBroadphase)
+        {
+            for (auto& list : m_visibilityLists)
+            {
+                refreshSortKeys(list);
+            }
+
+            m_cullingWorkers->run(m_visibilityLists.size(), [&](std::size_t i) { sortVisible(m_visibilityLists[i]); });
+        }
+    }
+}
+
+sf::FloatRect xy::RenderSystem::getViewableArea(const sf::View& view, sf::Vector2f border)
+{
+    return { (view.getCenter() - (view.getSize() / 2.f)) - border, view.getSize() + (border * 2.f) };
+}
+
+void xy::RenderSystem::collectVisible(VisibilityList& list) const
+{
+    list.items.clear();
+
+    if (m_useBroadphase)
+    {
+        //keys are filled in by refreshSortKeys()
+        m_tree.query(list.viewableArea, [&list](xy::Entity entity)
+            {
+                if (entity.getComponent<xy::Drawable>().m_worldBounds.intersects(list.viewableArea))
+                {
+                    list.items.emplace_back().entity = entity;
+                }
+            });
+
+        for (auto entity : m_unculledEntities)
+        {
+            list.items.emplace_back().entity = entity;
+        }
+    }
+    else
+    {
+        //the render queue is already sorted so culling preserves the order
+        for (const auto& item : m_renderQueue)
+        {
+            const auto& drawable = item.entity.getComponent<xy::Drawable>();
+            if (!drawable.m_cull || drawable.m_worldBounds.intersects(list.viewableArea))
+            {
+                list.items.push_back(item);
+            }
+        }
+    }
+}
+
+void xy::RenderSystem::refreshSortKeys(VisibilityList& list) const
+{
+    if (!m_useBroadphase)
+    {
+        return;
+    }
+
+    for (auto& item : list.items)
+    {
+        item.key = refreshSortKey(item.entity.getComponent<xy::Drawable>());
+    }
+}
+
+void xy::RenderSystem::sortVisible(VisibilityList& list) const
+{
+    //the query order changes as the tree is rebalanced, so
+    //visible drawables are sorted from scratch each time
+    if (m_useBroadphase)
+    {
+        radixSort(list.items, list.sortBuffer);
+    }
+}
+
+void xy::RenderSystem::updateLayerRegions()
+{
+    //caches follow the first camera. The region is aligned to the tiles
+    //and is one tile larger than the view, so it keeps the same size and
+    //only moves when the view crosses into a different tile
+    const auto area = m_visibilityLists.empty() ? sf::FloatRect() : m_visibilityLists[0].viewableArea;
+
+    for (auto& layer : m_cachedLayers)
+    {
+        if (!layer.enabled)
+        {
+            continue;
+        }
+
+        if (area.width > 0.f && area.height > 0.f)
+        {
+            sf::FloatRect region;
+            region.left = std::floor(area.left / layer.tileSize) * layer.tileSize;
+            region.top = std::floor(area.top / layer.tileSize) * layer.tileSize;
+            region.width = (std::ceil(area.width / layer.tileSize) + 1.f) * layer.tileSize;
+            region.height = (std::ceil(area.height / layer.tileSize) + 1.f) * layer.tileSize;
+
+            if (region != layer.region)
+            {
+                layer.region = region;
+                layer.dirty = true;
+            }
+        }
+
+        if (layer.dirty)
+        {
+            layer.dirty = false;
+            layer.revision++;
+        }
+    }
+}
+
+void xy::RenderSystem::collectLayer(std::uint8_t layer, std::vector<QueueItem>& items) const
+{
+    items.clear();
+    const auto& region = m_cachedLayers[layer].region;
+
+    if (m_useBroadphase)
+    {
+        auto add = [&](xy::Entity entity)
+        {
+            auto& drawable = entity.getComponent<xy::Drawable>();
+            if (drawable.m_layer == layer
+                && (!drawable.m_cull || drawable.m_worldBounds.intersects(region)))
+            {
+                auto& item = items.emplace_back();
+                item.key = refreshSortKey(drawable);
+                item.entity = entity;
+            }
+        };
+
+        m_tree.query(region, add);
+        for (auto entity : m_unculledEntities)
+        {
+            add(entity);
+        }
+        radixSort(items, m_layerSortBuffer);
+    }
+    else
+    {
+        //the render queue is sorted so the layer is a single run of items
+        auto item = std::partition_point(m_renderQueue.begin(), m_renderQueue.end(),
+            [layer](const QueueItem& queueItem)
+            {
+                return (queueItem.key >> LayerShift) < layer;
+            });
+
+        for (; item != m_renderQueue.end() && (item->key >> LayerShift) == layer; ++item)
+        {
+            const auto& drawable = item->entity.getComponent<xy::Drawable>();
+            if (!drawable.m_cull || drawable.m_worldBounds.intersects(region))
+            {
+                items.push_back(*item);
+            }
+        }
+    }
+}
+
+bool xy::RenderSystem::canComposite(const CachedLayer& layer, sf::FloatRect viewableArea)
+{
+    return layer.enabled && layer.revision != 0
+        && Util::Rectangle::contains(layer.region, viewableArea);
+}
+
+sf::RenderTexture* xy::RenderSystem::beginLayer(std::uint8_t layer, const CachedLayer& cache, std::uint64_t filterFlags) const
+{
+    auto& layerTexture = m_layerTextures[layer];
+    if (!layerTexture)
+    {
+        layerTexture = std::make_unique<LayerTexture>();
+    }
+
+    auto& target = *layerTexture;
+    if (target.revision == cache.revision
+        && target.filterFlags == filterFlags)
+    {
+        return nullptr;
+    }
+    target.revision = cache.revision;
+    target.filterFlags = filterFlags;
+    target.region = cache.region;
+
+    //resolution is lowered rather than exceeding the maximum texture size
+    const auto maxSize = static_cast<float>(sf::Texture::getMaximumSize());
+    const auto scale = std::min({ cache.resolution, maxSize / cache.region.width, maxSize / cache.region.height });
+    const sf::Vector2u size(static_cast<std::uint32_t>(std::ceil(cache.region.width * scale)),
+                            static_cast<std::uint32_t>(std::ceil(cache.region.height * scale)));
+
+    if (!target.created
+        || target.texture.getSize() != size)
+    {
+        target.created = target.texture.create(size.x, size.y);
+        if (!target.created)
+        {
+            xy::Logger::log("Failed creating texture for cached render layer " + std::to_string(layer), xy::Logger::Type::Error);
+            return nullptr;
+        }
+        target.texture.setSmooth(scale != 1.f);
+    }
+
+    target.texture.setView(sf::View(cache.region));
+    target.texture.clear(sf::Color::Transparent);
+    return &target.texture;
+}
+
+bool xy::RenderSystem::hasLayerTexture(std::uint8_t layer) const
 {
-    requireComponent<xy::Drawable>();
-    requireComponent<xy::Transform>();
+    return m_layerTextures[layer] && m_layerTextures[layer]->created;
 }
 
-//public
-void xy::RenderSystem::process(float)
+void xy::RenderSystem::compositeLayer(std::uint8_t layer, sf::RenderTarget& rt, std::array<std::int32_t, 4u>& activeFlags, std::size_t& activeFlagCount) const
+{
+    if (!hasLayerTexture(layer))
+    {
+        return;
+    }
+
+    const auto& layerTexture = *m_layerTextures[layer];
+    const auto& region = layerTexture.region;
+    const sf::Vector2f size(layerTexture.texture.getSize());
+
+    const std::array<sf::Vertex, 4u> quad =
+    {
+        sf::Vertex(sf::Vector2f(region.left, region.top), sf::Vector2f()),
+        sf::Vertex(sf::Vector2f(region.left, region.top + region.height), sf::Vector2f(0.f, size.y)),
+        sf::Vertex(sf::Vector2f(region.left + region.width, region.top + region.height), size),
+        sf::Vertex(sf::Vector2f(region.left + region.width, region.top), sf::Vector2f(size.x, 0.f))
+    };
+
+    applyScissor(rt, false, {});
+    Detail::GLStateCache::get().setDepthMask(true);
+    applyGlFlags(nullptr, 0, activeFlags, activeFlagCount);
+
+    sf::RenderStates states;
+    states.texture = &layerTexture.texture.getTexture();
+    states.blendMode = PremultipliedAlpha;
+    drawVertices(rt, quad.data(), quad.size(), sf::Quads, states);
+
+    Detail::GLStateCache::get().invalidateTargetCaps();
+}
+
+void xy::RenderSystem::writeSnapshot()
 {
-    auto& entities = getEntities();
-    for (auto& entity : entities)
+    auto& snapshot = m_snapshots[App::getSnapshotWriteIndex()];
+    snapshot.frameTable = Detail::FrameTable::get().getFrames();
+    snapshot.frameTime = Detail::FrameTable::get().getTime();
+    snapshot.drawables.clear();
+    snapshot.cullingBorder = m_cullingBorder;
+    snapshot.views.resize(m_visibilityLists.size());
+
+    //each snapshot keeps its own copy of the cached layers
+    for (auto i = 0u; i < m_cachedLayers.size(); ++i)
     {
-        auto& drawable = entity.getComponent<xy::Drawable>();
-        if (drawable.m_wantsSorting)
+        const auto& cache = m_cachedLayers[i];
+        auto& layer = snapshot.layers[i];
+
+        if (!cache.enabled)
         {
-            drawable.m_wantsSorting = false;
-            m_wantsSorting = true;
+            layer.drawables.clear();
+            layer.items.clear();
+        }
+        else if (cache.revision != layer.cache.revision)
+        {
+            collectLayer(static_cast<std::uint8_t>(i), m_layerItems);
+            layer.drawables.clear();
+            layer.items.clear();
+            for (const auto& item : m_layerItems)
+            {
+                layer.items.push_back(layer.drawables.add(item.entity));
+            }
         }
+        layer.cache = cache;
+    }
+
+    for (auto i = 0u; i < m_visibilityLists.size(); ++i)
+    {
+        const auto& list = m_visibilityLists[i];
+        auto& view = snapshot.views[i];
+        view.viewableArea = list.viewableArea;
+        view.filterFlags = m_filterFlags;
+        view.items.clear();
+        view.cachedLayers = 0;
 
-        //update cropping area
-        drawable.m_cropped = !Util::Rectangle::contains(drawable.m_croppingArea, drawable.m_localBounds);
+        if (!list.camera.destroyed()
+            && list.camera.hasComponent<Camera>())
+        {
+            view.filterFlags &= list.camera.getComponent<Camera>().getFilterFlags();
+        }
 
-        if (drawable.m_cropped)
+        for (const auto& [key, entity] : list.items)
         {
-            const auto& xForm = entity.getComponent<Transform>().getWorldTransform();
+            //the whole layer is drawn by a single item
+            const auto layer = static_cast<std::uint32_t>(key >> LayerShift);
+            if (canComposite(snapshot.layers[layer].cache, view.viewableArea))
+            {
+                if ((view.cachedLayers & (1u << layer)) == 0)
+                {
+                    view.cachedLayers |= (1u << layer);
+                    view.items.push_back(static_cast<std::uint32_t>(snapshot.drawables.items.size()));
+                    snapshot.drawables.items.emplace_back().cachedLayer = static_cast<std::int32_t>(layer);
+                }
+                continue;
+            }
+
+            auto index = entity.getIndex();
+            if (index >= m_snapshotFrames.size())
+            {
+                m_snapshotFrames.resize(index + 1, 0);
+                m_snapshotItems.resize(index + 1, 0);
+            }
+
+            if (m_snapshotFrames[index] != m_frameCount)
+            {
+                m_snapshotFrames[index] = m_frameCount;
+                m_snapshotItems[index] = snapshot.drawables.add(entity);
+            }
+            view.items.push_back(m_snapshotItems[index]);
+        }
+    }
+}
+
+void xy::RenderSystem::SnapshotBuffer::clear()
+{
+    items.clear();
+    vertices.clear();
+    uniformCount = 0;
+}
+
+std::uint32_t xy::RenderSystem::SnapshotBuffer::add(xy::Entity entity)
+{
+    const auto index = static_cast<std::uint32_t>(items.size());
+
+    const auto& drawable = entity.getComponent<xy::Drawable>();
+    auto& item = items.emplace_back();
+    item.states = drawable.getStates();
+    item.states.transform = entity.getComponent<xy::Transform>().getWorldTransform();
+    item.primitiveType = drawable.m_primitiveType;
+    item.firstVertex = vertices.size();
+    item.vertexCount = drawable.m_vertices.size();
+    item.filterFlags = drawable.m_filterFlags;
+    item.cropped = drawable.m_cropped;
+    item.depthWriteEnabled = drawable.m_depthWriteEnabled;
+    item.glFlagCount = drawable.m_glFlagCount;
+    if (drawable.m_coldData)
+    {
+        item.croppingWorldArea = drawable.m_coldData->croppingWorldArea;
+        item.glFlags = drawable.m_coldData->glFlags;
+    }
+    item.instanced = drawable.m_instanced;
+    item.batchingEnabled = drawable.m_batchingEnabled;
+    item.instanceData = drawable.m_instanceData;
+
+    vertices.insert(vertices.end(), drawable.m_vertices.begin(), drawable.m_vertices.end());
 
-            //update world positions
-            drawable.m_croppingWorldArea = xForm.transformRect(drawable.m_croppingArea);
-            drawable.m_croppingWorldArea.top += drawable.m_croppingWorldArea.height;
-            drawable.m_croppingWorldArea.height = -drawable.m_croppingWorldArea.height;
+    if (drawable.m_shader && drawable.m_coldData)
+    {
+        //assigning to existing elements reuses their memory
+        if (uniformCount == uniforms.size())
+        {
+            uniforms.emplace_back();
         }
+        uniforms[uniformCount] = drawable.m_coldData->uniformBindings;
+        item.uniformIndex = static_cast<std::int32_t>(uniformCount++);
     }
+    return index;
+}
+
+void xy::RenderSystem::drawSnapshot(sf::RenderTarget& rt) const
+{
+    m_lastDrawCount = 0;
 
-    //do Z sorting
-    if (m_wantsSorting)
+    const auto& snapshot = m_snapshots[App::getSnapshotReadIndex()];
+    if (snapshot.views.empty())
     {
-        m_wantsSorting = false;
+        return;
+    }
+    m_frameTable = snapshot.frameTable;
+    m_frameTime = snapshot.frameTime;
 
-        std::sort(entities.begin(), entities.end(),
-            [](const Entity& entA, const Entity& entB)
+    //the scene draws each camera with the view it had when the
+    //snapshot was taken, so the viewable areas will match
+    const auto viewableArea = getViewableArea(rt.getView(), snapshot.cullingBorder);
+    auto result = std::find_if(snapshot.views.begin(), snapshot.views.end(),
+        [&viewableArea](const Snapshot::View& view)
         {
-            return entA.getComponent<xy::Drawable>().getDepth() < entB.getComponent<xy::Drawable>().getDepth();
+            return view.viewableArea == viewableArea;
         });
+    const auto& view = (result == snapshot.views.end()) ? snapshot.views.front() : *result;
+    const auto filterFlags = view.filterFlags; //already includes the system's flags
+
+    //redraw any out of date layer caches before starting on the target
+    for (auto i = 0u; i < snapshot.layers.size(); ++i)
+    {
+        if (view.cachedLayers & (1u << i))
+        {
+            const auto& layer = snapshot.layers[i];
+            if (auto* texture = beginLayer(static_cast<std::uint8_t>(i), layer.cache, filterFlags); texture)
+            {
+                drawSnapshotItems(layer.drawables, layer.items, *texture, filterFlags);
+                texture->display();
+            }
+        }
     }
+
+    m_lastDrawCount = 0;
+    drawSnapshotItems(snapshot.drawables, view.items, rt, filterFlags);
 }
 
-void xy::RenderSystem::setCullingBorder(float size)
+void xy::RenderSystem::drawSnapshotItems(const SnapshotBuffer& buffer, const std::vector<std::uint32_t>& indices,
+    sf::RenderTarget& rt, std::uint64_t filterFlags) const
 {
-    m_cullingBorder = { size, size };
+    auto& glState = Detail::GLStateCache::get();
+    glState.invalidate();
+    xy::Drawable::beginUniformPass();
+    glState.setEnabled(GL_SCISSOR_TEST, true);
+    glState.setDepthFunc(GL_LEQUAL);
+
+    std::array<std::int32_t, 4u> activeFlags = {};
+    std::size_t activeFlagCount = 0;
+    bool firstDraw = true;
+    m_targetState.known = false;
+
+    for (auto i : indices)
+    {
+        const auto& item = buffer.items[i];
+        if (item.cachedLayer > -1)
+        {
+            flushInstances(rt);
+            flushMeshes(rt);
+            compositeLayer(static_cast<std::uint8_t>(item.cachedLayer), rt, activeFlags, activeFlagCount);
+            m_lastDrawCount++;
+            continue;
+        }
+
+        if (item.filterFlags & filterFlags)
+        {
+            if (item.instanced && !item.cropped
+                && item.glFlagCount == 0 && canPackTextureRect(item.instanceData.textureRect)
+                && canInstance(item.states))
+            {
+                flushMeshes(rt);
+                addInstance(rt, item.states, item.instanceData, item.depthWriteEnabled, activeFlags, activeFlagCount);
+                m_lastDrawCount++;
+                continue;
+            }
+            flushInstances(rt);
+
+            if (item.batchingEnabled && !item.instanced && !item.cropped
+                && item.glFlagCount == 0 && isListPrimitive(item.primitiveType))
+            {
+                addMesh(rt, item.states, buffer.vertices.data() + item.firstVertex, item.vertexCount, item.primitiveType,
+                    item.uniformIndex > -1 ? &buffer.uniforms[item.uniformIndex] : nullptr, item.depthWriteEnabled, activeFlags, activeFlagCount);
+                m_lastDrawCount++;
+                continue;
+            }
+            flushMeshes(rt);
+
+            if (item.uniformIndex > -1)
+            {
+                buffer.uniforms[item.uniformIndex].apply(*const_cast<sf::Shader*>(item.states.shader));
+            }
+
+            applyScissor(rt, item.cropped, item.croppingWorldArea);
+            glState.setDepthMask(item.depthWriteEnabled);
+            applyGlFlags(item.glFlags.data(), item.glFlagCount, activeFlags, activeFlagCount);
+
+            if (item.instanced)
+            {
+                auto quad = xy::Drawable::getInstanceQuad(item.instanceData);
+                drawVertices(rt, quad.data(), quad.size(), sf::Quads, item.states);
+            }
+            else
+            {
+                drawVertices(rt, buffer.vertices.data() + item.firstVertex, item.vertexCount, item.primitiveType, item.states);
+            }
+            m_lastDrawCount++;
+
+            if (firstDraw)
+            {
+                glState.invalidateTargetCaps();
+                firstDraw = false;
+            }
+        }
+    }
+    flushInstances(rt);
+    flushMeshes(rt);
+    glState.disableAll();
+    xy::Drawable::endUniformPass();
 }
 
-//private
-void xy::RenderSystem::onEntityAdded(xy::Entity)
+void xy::RenderSystem::drawVertices(sf::RenderTarget& rt, const sf::Vertex* vertices, std::size_t vertexCount,
+    sf::PrimitiveType primitiveType, const sf::RenderStates& states) const
 {
-    m_wantsSorting = true;
+    if (vertexCount == 0)
+    {
+        //SFML returns without applying anything
+        return;
+    }
+
+    rt.draw(vertices, vertexCount, primitiveType, states);
+    RenderStats::addDrawCall(static_cast<std::uint32_t>(vertexCount));
+
+    m_targetState = { states.texture, states.blendMode, true };
+}
+
+void xy::RenderSystem::applyScissor(sf::RenderTarget& rt, bool cropped, sf::FloatRect croppingWorldArea) const
+{
+    if (cropped)
+    {
+        //convert cropping area to target coords (remember this might not be a window!)
+        sf::Vector2f start(croppingWorldArea.left, croppingWorldArea.top);
+        sf::Vector2f end(start.x + croppingWorldArea.width, start.y + croppingWorldArea.height);
+
+        auto scissorStart = rt.mapCoordsToPixel(start);
+        auto scissorEnd = rt.mapCoordsToPixel(end);
+        //Y coords are flipped...
+        auto rtHeight = rt.getSize().y;
+        scissorStart.y = rtHeight - scissorStart.y;
+        scissorEnd.y = rtHeight - scissorEnd.y;
+
+        Detail::GLStateCache::get().setScissor(scissorStart.x, scissorStart.y, scissorEnd.x - scissorStart.x, scissorEnd.y - scissorStart.y);
+    }
+    else
+    {
+        //just set the scissor to the view
+        auto rtSize = rt.getSize();
+        Detail::GLStateCache::get().setScissor(0, 0, rtSize.x, rtSize.y);
+    }
 }
 
-void xy::RenderSystem::draw(sf::RenderTarget& rt, sf::RenderStates states) const
+void xy::RenderSystem::draw(sf::RenderTarget& rt, sf::RenderStates) const
 {
-    auto view = rt.getView();
-    sf::FloatRect viewableArea((view.getCenter() - (view.getSize() / 2.f)) - m_cullingBorder, view.getSize() + (m_cullingBorder * 2.f));
+    RenderStats::Scope scope("RenderSystem");
+
+    if (App::isRenderThreadEnabled())
+    {
+        drawSnapshot(rt);
+        return;
+    }
+
+    const auto viewableArea = getViewableArea(rt.getView(), m_cullingBorder);
+    auto filterFlags = m_filterFlags;
+
+    //find the results for the camera currently being drawn. If they're
+    //missing or out of date (eg the camera moved after process() was
+    //called) then cull again
+    auto camera = getScene()->getActiveCamera();
+    auto result = std::find_if(m_visibilityLists.begin(), m_visibilityLists.end(),
+        [camera](const VisibilityList& list)
+        {
+            return list.camera == camera;
+        });
+
+    auto& list = (result == m_visibilityLists.end()) ? m_fallbackList : *result;
+    if (list.frame != m_frameCount
+        || list.viewableArea != viewableArea)
+    {
+        list.camera = camera;
+        list.frame = m_frameCount;
+        list.viewableArea = viewableArea;
+        collectVisible(list);
+        refreshSortKeys(list);
+        sortVisible(list);
+    }
+
+    if (camera.isValid() && camera.hasComponent<Camera>())
+    {
+        filterFlags &= camera.getComponent<Camera>().getFilterFlags();
+    }
+
+    //redraw any out of date layer caches before starting on the target
+    std::uint32_t cachedLayers = 0;
+    if (std::any_of(m_cachedLayers.begin(), m_cachedLayers.end(), [](const CachedLayer& layer) { return layer.enabled; }))
+    {
+        std::uint32_t visibleLayers = 0;
+        for (const auto& item : list.items)
+        {
+            visibleLayers |= (1u << (item.key >> LayerShift));
+        }
+
+        for (auto i = 0u; i < m_cachedLayers.size(); ++i)
+        {
+            const auto layer = static_cast<std::uint8_t>(i);
+            if ((visibleLayers & (1u << i))
+                && canComposite(m_cachedLayers[i], viewableArea))
+            {
+                if (auto* texture = beginLayer(layer, m_cachedLayers[i], filterFlags); texture)
+                {
+                    collectLayer(layer, m_layerItems);
+                    drawItems(m_layerItems, *texture, filterFlags);
+                    texture->display();
+                }
+
+                if (hasLayerTexture(layer))
+                {
+                    cachedLayers |= (1u << i);
+                }
+            }
+        }
+    }
+
+    drawItems(list.items, rt, filterFlags, cachedLayers);
+}
 
+void xy::RenderSystem::drawItems(const std::vector<QueueItem>& items, sf::RenderTarget& rt, std::uint64_t filterFlags, std::uint32_t cachedLayers) const
+{
     m_lastDrawCount = 0;
+    m_frameTable = Detail::FrameTable::get().getFrames();
+    m_frameTime = Detail::FrameTable::get().getTime();
+
+    sf::RenderStates states;
+
+    auto& glState = Detail::GLStateCache::get();
+    glState.invalidate();
+    xy::Drawable::beginUniformPass();
+    glState.setEnabled(GL_SCISSOR_TEST, true);
+    glState.setDepthFunc(GL_LEQUAL);
 
+    std::array<std::int32_t, 4u> activeFlags = {};
+    std::size_t activeFlagCount = 0;
+    bool firstDraw = true;
+    std::uint32_t compositedLayers = 0;
+    m_targetState.known = false;
 
-    glCheck(glEnable(GL_SCISSOR_TEST));
-    glCheck(glDepthFunc(GL_LEQUAL));
-    for (auto entity : getEntities())
+    for (const auto& [key, entity] : items)
     {
-        const auto& drawable = entity.getComponent<xy::Drawable>();
-        const auto& tx = entity.getComponent<xy::Transform>().getWorldTransform();
-        const auto bounds = tx.transformRect(drawable.getLocalBounds());
+        //the whole layer is drawn in place of its first item
+        const auto layer = static_cast<std::uint32_t>(key >> LayerShift);
+        if (cachedLayers & (1u << layer))
+        {
+            if ((compositedLayers & (1u << layer)) == 0)
+            {
+                compositedLayers |= (1u << layer);
+                flushInstances(rt);
+                flushMeshes(rt);
+                compositeLayer(static_cast<std::uint8_t>(layer), rt, activeFlags, activeFlagCount);
+                m_lastDrawCount++;
+            }
+            continue;
+        }
 
-        if ((!drawable.m_cull || bounds.intersects(viewableArea))
-            && (drawable.m_filterFlags & m_filterFlags))
+        const auto& drawable = entity.getComponent<xy::Drawable>();
+        if (drawable.m_filterFlags & filterFlags)
         {
-            states = drawable.m_states;
+            const auto& tx = entity.getComponent<xy::Transform>().getWorldTransform();
+            states.texture = drawable.m_texture;
+            states.shader = drawable.m_shader;
+            states.blendMode = drawable.m_blendMode;
             states.transform = tx;
 
+            if (drawable.m_instanced && !drawable.m_cropped
+                && drawable.m_glFlagCount == 0 && canPackTextureRect(drawable.m_instanceData.textureRect)
+                && canInstance(states))
+            {
+                flushMeshes(rt);
+                addInstance(rt, states, drawable.m_instanceData, drawable.m_depthWriteEnabled, activeFlags, activeFlagCount);
+                m_lastDrawCount++;
+                continue;
+            }
+            flushInstances(rt);
+
+            if (drawable.m_batchingEnabled && !drawable.m_instanced && !drawable.m_cropped
+                && drawable.m_glFlagCount == 0 && isListPrimitive(drawable.m_primitiveType))
+            {
+                addMesh(rt, states, drawable.m_vertices.data(), drawable.m_vertices.size(), drawable.m_primitiveType,
+                    drawable.m_coldData ? &drawable.m_coldData->uniformBindings : nullptr, drawable.m_depthWriteEnabled, activeFlags, activeFlagCount);
+                m_lastDrawCount++;
+                continue;
+            }
+            flushMeshes(rt);
+
             if (states.shader)
             {
                 drawable.applyShader();
             }
 
-            if (drawable.m_cropped)
-            {
-                //convert cropping area to target coords (remember this might not be a window!)
-                sf::Vector2f start(drawable.m_croppingWorldArea.left, drawable.m_croppingWorldArea.top);
-                sf::Vector2f end(start.x + drawable.m_croppingWorldArea.width, start.y + drawable.m_croppingWorldArea.height);
+            //cropping and GL flags both imply the cold data exists
+            applyScissor(rt, drawable.m_cropped, drawable.m_cropped ? drawable.m_coldData->croppingWorldArea : sf::FloatRect());
+            glState.setDepthMask(drawable.m_depthWriteEnabled);
 
-                auto scissorStart = rt.mapCoordsToPixel(start);
-                auto scissorEnd = rt.mapCoordsToPixel(end);
-                //Y coords are flipped...
-                auto rtHeight = rt.getSize().y;
-                scissorStart.y = rtHeight - scissorStart.y;
-                scissorEnd.y = rtHeight - scissorEnd.y;
+            //apply any gl flags such as depth testing
+            applyGlFlags(drawable.m_glFlagCount ? drawable.m_coldData->glFlags.data() : nullptr, drawable.m_glFlagCount, activeFlags, activeFlagCount);
 
-                glCheck(glScissor(scissorStart.x, scissorStart.y, scissorEnd.x - scissorStart.x, scissorEnd.y - scissorStart.y));
+            if (drawable.m_instanced)
+            {
+                auto quad = xy::Drawable::getInstanceQuad(drawable.m_instanceData);
+                drawVertices(rt, quad.data(), quad.size(), sf::Quads, states);
             }
             else
             {
-                //just set the scissor to the view
-                auto rtSize = rt.getSize();
-                glCheck(glScissor(0, 0, rtSize.x, rtSize.y));
+                drawVertices(rt, drawable.m_vertices.data(), drawable.m_vertices.size(), drawable.m_primitiveType, states);
             }
+            m_lastDrawCount++;
 
-            if (m_depthWriteEnabled != drawable.m_depthWriteEnabled)
+            if (firstDraw)
             {
-                m_depthWriteEnabled = drawable.m_depthWriteEnabled;
-                glCheck(glDepthMask(m_depthWriteEnabled));
+                glState.invalidateTargetCaps();
+                firstDraw = false;
             }
+        }
+    }
+    flushInstances(rt);
+    flushMeshes(rt);
+    glState.disableAll();
+    xy::Drawable::endUniformPass();
+}
 
-            //apply any gl flags such as depth testing
-            for (auto i = 0u; i < drawable.m_glFlagIndex; ++i)
+bool xy::RenderSystem::canInstance(const sf::RenderStates& states) const
+{
+    if (states.shader || !states.texture
+        || App::getRenderBackend() != App::RenderBackend::Core)
+    {
+        return false;
+    }
+
+    if (!m_instanceBatch)
+    {
+        m_instanceBatch = std::make_unique<InstanceBatch>();
+        auto& batch = *m_instanceBatch;
+        if (batch.shader.loadFromMemory(InstanceVertexShader, InstanceFragmentShader))
+        {
+            const auto program = Detail::toGlHandle(batch.shader.getNativeHandle());
+            batch.textureLocation = glGetUniformLocationARB(program, "u_texture");
+            batch.textureMatrixLocation = glGetUniformLocationARB(program, "u_textureMatrix");
+            batch.viewProjectionLocation = glGetUniformLocationARB(program, "u_viewProjectionMatrix");
+            batch.timeLocation = glGetUniformLocationARB(program, "u_time");
+            batch.instances.reserve(MaxBatchInstances);
+
+            auto blockIndex = glGetUniformBlockIndex(program, "FrameTable");
+            if (blockIndex != GL_INVALID_INDEX)
             {
-                glCheck(glEnable(drawable.m_glFlags[i]));
+                glCheck(glUniformBlockBinding(program, blockIndex, Detail::FrameTableUniformBinding));
             }
-            rt.draw(drawable.m_vertices.data(), drawable.m_vertices.size(), drawable.m_primitiveType, states);
-            m_lastDrawCount++;
-            for (auto i = 0u; i < drawable.m_glFlagIndex; ++i)
+            batch.loaded = true;
+        }
+        else
+        {
+            Logger::log("Failed creating instanced sprite shader, falling back to regular drawing", Logger::Type::Error);
+        }
+    }
+    return m_instanceBatch->loaded;
+}
+
+void xy::RenderSystem::addInstance(sf::RenderTarget& rt, const sf::RenderStates& states, const xy::Drawable::InstanceData& data,
+    bool depthWriteEnabled, std::array<std::int32_t, 4u>& activeFlags, std::size_t& activeFlagCount) const
+{
+    auto& batch = *m_instanceBatch;
+    if (!batch.instances.empty()
+        && (batch.texture != states.texture
+            || batch.blendMode != states.blendMode
+            || batch.depthWriteEnabled != depthWriteEnabled
+            || batch.instances.size() == MaxBatchInstances))
+    {
+        flushInstances(rt);
+    }
+
+    if (batch.instances.empty())
+    {
+        //state applied here stays in effect until the batch is flushed
+        applyScissor(rt, false, {});
+        Detail::GLStateCache::get().setDepthMask(depthWriteEnabled);
+        applyGlFlags(nullptr, 0, activeFlags, activeFlagCount);
+
+        batch.texture = states.texture;
+        batch.blendMode = states.blendMode;
+        batch.depthWriteEnabled = depthWriteEnabled;
+    }
+
+    //sf::Transform is a column major 4x4 matrix
+    const auto* matrix = states.transform.getMatrix();
+    auto& instance = batch.instances.emplace_back();
+    instance.transform = { matrix[0], matrix[4], matrix[12], matrix[1], matrix[5], matrix[13] };
+    instance.textureRect = { static_cast<std::int16_t>(data.textureRect.left), static_cast<std::int16_t>(data.textureRect.top),
+        static_cast<std::int16_t>(data.textureRect.width), static_cast<std::int16_t>(data.textureRect.height) };
+    instance.colour = data.colour;
+
+    const auto& animation = data.animation;
+    if (animation.frameCount)
+    {
+        instance.animationFrames = { animation.firstFrame, static_cast<std::uint16_t>((animation.frameCount * 64) + animation.loopStart) };
+        instance.animationTiming = { animation.framerate, animation.startTime };
+    }
+}
+
+void xy::RenderSystem::flushInstances(sf::RenderTarget& rt) const
+{
+    if (!m_instanceBatch
+        || m_instanceBatch->instances.empty()
+        || !rt.setActive(true))
+    {
+        return;
+    }
+
+    auto& batch = *m_instanceBatch;
+    auto& glState = Detail::GLStateCache::get();
+
+    //SFML may have drawn since the last batch
+    glState.invalidateTargetCaps();
+    glState.setEnabled(GL_BLEND, true);
+    glState.setBlendMode(batch.blendMode);
+
+    //apply the view as SFML would
+    const auto& view = rt.getView();
+    auto viewport = rt.getViewport(view);
+    auto top = rt.getSize().y - (viewport.top + viewport.height);
+    glCheck(glViewport(viewport.left, top, viewport.width, viewport.height));
+
+    glState.bindShader(&batch.shader);
+    glCheck(glUniformMatrix4fvARB(batch.viewProjectionLocation, 1, GL_FALSE, view.getTransform().getMatrix()));
+    glCheck(glUniform1iARB(batch.textureLocation, 0));
+    glCheck(glUniform1fARB(batch.timeLocation, m_frameTime));
+
+    if (m_frameTable && !m_frameTable->empty())
+    {
+        batch.frameBuffer.bind();
+        if (batch.uploadedFrames != m_frameTable.get())
+        {
+            batch.frameBuffer.write(m_frameTable->data(), m_frameTable->size() * sizeof(sf::FloatRect), sizeof(sf::FloatRect) * Detail::FrameTable::MaxFrames);
+            batch.uploadedFrames = m_frameTable.get();
+        }
+        glCheck(glBindBufferBase(GL_UNIFORM_BUFFER, Detail::FrameTableUniformBinding, batch.frameBuffer.getHandle()));
+    }
+
+    //binding in pixel coordinates sets a texture matrix which accounts
+    //for padded and flipped textures. Core shaders can't read it directly
+    glCheck(glActiveTextureARB(GL_TEXTURE0_ARB));
+    sf::Texture::bind(batch.texture, sf::Texture::Pixels);
+    std::array<float, 16u> textureMatrix = {};
+    glCheck(glGetFloatv(GL_TEXTURE_MATRIX, textureMatrix.data()));
+    glCheck(glUniformMatrix4fvARB(batch.textureMatrixLocation, 1, GL_FALSE, textureMatrix.data()));
+
+    batch.instanceBuffer.bind();
+    batch.vertexArray.bind([]()
+        {
+            for (auto i = 0u; i < 6u; ++i)
             {
-                glCheck(glDisable(drawable.m_glFlags[i]));
+                glCheck(glEnableVertexAttribArrayARB(i));
+                glCheck(glVertexAttribDivisorARB(i, 1));
             }
+        });
+
+    const auto first = batch.instanceBuffer.write(batch.instances.data(), batch.instances.size() * sizeof(InstanceVertex), sizeof(InstanceVertex));
+
+    //there's no base instance in GL 3.3 so the attributes point at the first instance
+    const auto offset = first * sizeof(InstanceVertex);
+    glCheck(glVertexAttribPointerARB(0, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceVertex), reinterpret_cast<void*>(offset + offsetof(InstanceVertex, transform))));
+    glCheck(glVertexAttribPointerARB(1, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceVertex), reinterpret_cast<void*>(offset + offsetof(InstanceVertex, transform) + (sizeof(float) * 3))));
+    glCheck(glVertexAttribPointerARB(2, 4, GL_SHORT, GL_FALSE, sizeof(InstanceVertex), reinterpret_cast<void*>(offset + offsetof(InstanceVertex, textureRect))));
+    glCheck(glVertexAttribPointerARB(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(InstanceVertex), reinterpret_cast<void*>(offset + offsetof(InstanceVertex, colour))));
+    glCheck(glVertexAttribPointerARB(4, 2, GL_UNSIGNED_SHORT, GL_FALSE, sizeof(InstanceVertex), reinterpret_cast<void*>(offset + offsetof(InstanceVertex, animationFrames))));
+    glCheck(glVertexAttribPointerARB(5, 2, GL_FLOAT, GL_FALSE, sizeof(InstanceVertex), reinterpret_cast<void*>(offset + offsetof(InstanceVertex, animationTiming))));
+
+    glCheck(glDrawArraysInstancedARB(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(batch.instances.size())));
+    RenderStats::addDrawCall(static_cast<std::uint32_t>(batch.instances.size() * 4));
+
+    Detail::VertexArray::unbind();
+    glCheck(glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0));
+    glCheck(glBindBufferBase(GL_UNIFORM_BUFFER, Detail::FrameTableUniformBinding, 0));
+    glState.bindShader(nullptr);
+
+    batch.instances.clear();
+
+    //SFML caches the last texture and blend mode it applied, so put them
+    //back. If SFML hasn't drawn yet this pass its cache is reset instead,
+    //at most once, which also disables any active GL flags
+    if (m_targetState.known)
+    {
+        sf::Texture::bind(m_targetState.texture, sf::Texture::Pixels);
+        glState.setBlendMode(m_targetState.blendMode);
+    }
+    else
+    {
+        rt.resetGLStates();
+        m_targetState = { nullptr, sf::BlendAlpha, true };
+    }
+    glState.invalidateTargetCaps();
+}
+
+void xy::RenderSystem::addMesh(sf::RenderTarget& rt, const sf::RenderStates& states, const sf::Vertex* vertices, std::size_t vertexCount,
+    sf::PrimitiveType primitiveType, const xy::Drawable::UniformBindings* uniforms, bool depthWriteEnabled,
+    std::array<std::int32_t, 4u>& activeFlags, std::size_t& activeFlagCount) const
+{
+    if (vertexCount == 0)
+    {
+        return;
+    }
+
+    if (!m_meshBatch)
+    {
+        m_meshBatch = std::make_unique<MeshBatch>();
+    }
+
+    auto& batch = *m_meshBatch;
+    if (batch.meshCount != 0
+        && (batch.states.texture != states.texture
+            || batch.states.shader != states.shader
+            || batch.states.blendMode != states.blendMode
+            || batch.primitiveType != primitiveType
+            || batch.depthWriteEnabled != depthWriteEnabled
+            || (batch.uniforms != uniforms
+                && (!batch.uniforms || !uniforms || !batch.uniforms->matches(*uniforms)))))
+    {
+        flushMeshes(rt);
+    }
+
+    if (batch.meshCount == 0)
+    {
+        //state applied here stays in effect until the batch is flushed
+        applyScissor(rt, false, {});
+        Detail::GLStateCache::get().setDepthMask(depthWriteEnabled);
+        applyGlFlags(nullptr, 0, activeFlags, activeFlagCount);
+
+        batch.states = states;
+        batch.firstVertices = vertices;
+        batch.firstVertexCount = vertexCount;
+        batch.primitiveType = primitiveType;
+        batch.uniforms = uniforms;
+        batch.depthWriteEnabled = depthWriteEnabled;
+        batch.meshCount = 1;
+        return;
+    }
+
+    auto append = [&batch](const sf::Vertex* first, std::size_t count, const sf::Transform& transform)
+    {
+        for (auto i = 0u; i < count; ++i)
+        {
+            auto& vertex = batch.vertices.emplace_back(first[i]);
+            vertex.position = transform.transformPoint(vertex.position);
         }
+    };
+
+    if (batch.meshCount == 1)
+    {
+        append(batch.firstVertices, batch.firstVertexCount, batch.states.transform);
+    }
+    append(vertices, vertexCount, states.transform);
+    batch.meshCount++;
+}
+
+void xy::RenderSystem::flushMeshes(sf::RenderTarget& rt) const
+{
+    if (!m_meshBatch
+        || m_meshBatch->meshCount == 0)
+    {
+        return;
+    }
+
+    auto& batch = *m_meshBatch;
+    if (batch.states.shader && batch.uniforms)
+    {
+        batch.uniforms->apply(*const_cast<sf::Shader*>(batch.states.shader));
+    }
+
+    if (batch.meshCount == 1)
+    {
+        drawVertices(rt, batch.firstVertices, batch.firstVertexCount, batch.primitiveType, batch.states);
     }
-    glCheck(glDisable(GL_SCISSOR_TEST));
+    else
+    {
+        auto states = batch.states;
+        states.transform = sf::Transform::Identity;
+        drawVertices(rt, batch.vertices.data(), batch.vertices.size(), batch.primitiveType, states);
+    }
+
+    //this may have been the first draw to the target, after
+    //which SFML will have reset its GL state
+    Detail::GLStateCache::get().invalidateTargetCaps();
+
+    batch.vertices.clear();
+    batch.meshCount = 0;
 }
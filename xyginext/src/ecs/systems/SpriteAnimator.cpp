@@ -30,11 +30,35 @@ source distribution.
 #include "xyginext/ecs/components/SpriteAnimation.hpp"
 
 #include "xyginext/core/Message.hpp"
+#include "xyginext/core/Assert.hpp"
+#include "xyginext/core/Log.hpp"
+
+#include "../../detail/FrameTable.hpp"
+
+#include <algorithm>
+#include <limits>
 
 using namespace xy;
 
+namespace
+{
+    constexpr std::uint32_t NoSlot = std::numeric_limits<std::uint32_t>::max();
+
+    //matches the frame chosen by the instancing shader
+    std::uint32_t getFrame(const Drawable::InstanceData::Animation& animation, float time)
+    {
+        auto frame = static_cast<std::uint32_t>(std::max(0.f, (time - animation.startTime) * animation.framerate));
+        if (frame >= animation.frameCount)
+        {
+            frame = animation.loopStart + ((frame - animation.loopStart) % (animation.frameCount - animation.loopStart));
+        }
+        return frame;
+    }
+}
+
 SpriteAnimator::SpriteAnimator(MessageBus& mb)
-    : System(mb, typeid(SpriteAnimator))
+    : System        (mb, typeid(SpriteAnimator)),
+    m_dirtyList     (std::make_shared<std::vector<std::uint32_t>>())
 {
     requireComponent<Sprite>();
     requireComponent<SpriteAnimation>();
@@ -43,46 +67,260 @@ SpriteAnimator::SpriteAnimator(MessageBus& mb)
 //public
 void SpriteAnimator::process(float dt)
 {
-    auto& entities = getEntities();
-    for (auto& entity : entities) 
+    //pick up any animations played, paused or modified via the components.
+    //Entities may have been queued since being removed from the system
+    m_syncList.swap(*m_dirtyList);
+    for (auto entityIndex : m_syncList)
     {
-        auto& animation = entity.getComponent<SpriteAnimation>();
-        if (animation.m_playing)
+        if (entityIndex < m_slotIndices.size()
+            && m_slotIndices[entityIndex] != NoSlot)
         {
-            auto& sprite = entity.getComponent<Sprite>();
-            if (sprite.m_animations.empty() ||
-                animation.m_id >= sprite.m_animations.size() || //TODO it'd be more optimal to range check this when playing the animation, but we can't read the animation size from there
-                sprite.m_animations[animation.m_id].frames.empty())
-            {
-                animation.stop();
-                continue;
-            }
-
-            animation.m_currentFrameTime -= dt;
-            if (animation.m_currentFrameTime < 0 /*&& sprite.m_animations[animation.m_id].frameCount > 0*/)
-            {
-                XY_ASSERT(sprite.m_animations[animation.m_id].framerate > 0, "Illegal Frame Rate");
-                XY_ASSERT(!sprite.m_animations[animation.m_id].frames.empty(), "Illegal Frame Count");
-                animation.m_currentFrameTime += (1.f / sprite.m_animations[animation.m_id].framerate);
-
-                auto lastFrame = animation.m_frameID;
-                animation.m_frameID = (animation.m_frameID + 1) % sprite.m_animations[animation.m_id].frames.size();
-
-                if (animation.m_frameID < lastFrame)
-                {
-                    if (!sprite.m_animations[animation.m_id].looped)
-                    {
-                        animation.stop();
-                        continue;
-                    }
-                    else
-                    {
-                        animation.m_frameID = std::max(animation.m_frameID, sprite.m_animations[animation.m_id].loopStart);
-                    }
-                }
-
-                sprite.setTextureRect(sprite.m_animations[animation.m_id].frames[animation.m_frameID]);
-            }
+            syncSlot(m_slotIndices[entityIndex]);
         }
     }
-}
\ No newline at end of file
+    m_syncList.clear();
+
+    const auto count = m_slots.size();
+
+    //kept free of branches so that the compiler can vectorise it
+    auto* timers = m_timers.data();
+    const auto* active = m_active.data();
+    for (auto i = 0u; i < count; ++i)
+    {
+        timers[i] -= dt * active[i];
+    }
+
+    m_expired.clear();
+    for (auto i = 0u; i < count; ++i)
+    {
+        if (active[i] != 0.f && timers[i] < 0.f)
+        {
+            m_expired.push_back(i);
+        }
+    }
+
+    for (auto i : m_expired)
+    {
+        advanceFrame(i);
+    }
+}
+
+//private
+void SpriteAnimator::syncSlot(std::uint32_t index)
+{
+    auto& slot = m_slots[index];
+    auto& animation = slot.entity.getComponent<SpriteAnimation>();
+    auto& sprite = slot.entity.getComponent<Sprite>();
+    animation.m_hook.m_queued = false;
+    sprite.m_animatorHook.m_queued = false;
+
+    //an entity may be queued more than once, or by a copy of one of its components
+    const bool gpuRequested = animation.m_playback == SpriteAnimation::Playback::GPU;
+    if (!animation.m_rewound
+        && animation.m_playing == slot.playing
+        && animation.m_id == slot.id
+        && animation.m_frameID == slot.frameID
+        && sprite.m_animations.get() == slot.animations
+        && sprite.m_animationRevision == slot.revision
+        && gpuRequested == slot.gpuRequested
+        && animation.m_phase == slot.phase
+        && sprite.m_instanced == slot.instanced)
+    {
+        return;
+    }
+
+    if (slot.gpu)
+    {
+        stopGPUPlayback(slot, animation, sprite);
+    }
+    animation.m_rewound = false;
+
+    slot.playing = animation.m_playing;
+    slot.id = animation.m_id;
+    slot.frameID = animation.m_frameID;
+    slot.animations = sprite.m_animations.get();
+    slot.revision = sprite.m_animationRevision;
+    slot.gpuRequested = gpuRequested;
+    slot.phase = animation.m_phase;
+    slot.instanced = sprite.m_instanced;
+    m_active[index] = 0.f;
+
+    if (!slot.playing)
+    {
+        return;
+    }
+
+    const auto& animations = *sprite.m_animations;
+    if (slot.id >= animations.size()
+        || animations[slot.id].frames.empty())
+    {
+        //not via stop(), which would queue the entity again
+        animation.m_playing = false;
+        animation.m_frameID = 0;
+        slot.playing = false;
+        slot.frameID = 0;
+        return;
+    }
+
+    const auto& anim = animations[slot.id];
+    XY_ASSERT(anim.framerate > 0, "Illegal Frame Rate");
+
+    auto& timeline = slot.timeline;
+    timeline.frames = anim.frames.data();
+    timeline.frameCount = static_cast<std::uint32_t>(anim.frames.size());
+    timeline.loopStart = std::min(anim.loopStart, timeline.frameCount - 1);
+    timeline.looped = anim.looped;
+
+    if (gpuRequested && timeline.looped && slot.instanced
+        && startGPUPlayback(slot, animation, sprite))
+    {
+        return;
+    }
+
+    m_frameTimes[index] = 1.f / anim.framerate;
+    m_active[index] = 1.f;
+}
+
+void SpriteAnimator::advanceFrame(std::uint32_t index)
+{
+    auto& slot = m_slots[index];
+    const auto& timeline = slot.timeline;
+    m_timers[index] += m_frameTimes[index];
+
+    auto& animation = slot.entity.getComponent<SpriteAnimation>();
+
+    auto frameID = slot.frameID + 1;
+    if (frameID >= timeline.frameCount)
+    {
+        if (!timeline.looped)
+        {
+            animation.m_playing = false;
+            animation.m_frameID = 0;
+            slot.playing = false;
+            slot.frameID = 0;
+            m_active[index] = 0.f;
+            return;
+        }
+        frameID = timeline.loopStart;
+    }
+    slot.frameID = frameID;
+    animation.m_frameID = frameID;
+
+    //frames of the same size only need new texture coordinates
+    auto& sprite = slot.entity.getComponent<Sprite>();
+    const auto& frame = timeline.frames[frameID];
+    if (!sprite.m_dirty
+        && frame.width == sprite.m_textureRect.width
+        && frame.height == sprite.m_textureRect.height)
+    {
+        sprite.m_textureRect = frame;
+        sprite.m_texCoordsDirty = true;
+    }
+    else
+    {
+        sprite.setTextureRect(frame);
+    }
+}
+
+bool SpriteAnimator::startGPUPlayback(Slot& slot, SpriteAnimation& animation, Sprite& sprite)
+{
+    auto& frameTable = Detail::FrameTable::get();
+    const auto first = frameTable.getFirstFrame(sprite.m_animations, sprite.m_animationRevision, slot.id);
+    if (first < 0)
+    {
+        static bool warned = false;
+        if (!warned)
+        {
+            Logger::log("GPU animation frame table is full, animations will be played on the CPU", Logger::Type::Warning);
+            warned = true;
+        }
+        return false;
+    }
+
+    const auto& timeline = slot.timeline;
+    const auto frameID = std::min(slot.frameID, timeline.frameCount - 1);
+    const auto framerate = (*sprite.m_animations)[slot.id].framerate;
+
+    auto& gpuAnimation = sprite.m_gpuAnimation;
+    gpuAnimation.firstFrame = static_cast<std::uint16_t>(first);
+    gpuAnimation.frameCount = static_cast<std::uint8_t>(timeline.frameCount);
+    gpuAnimation.loopStart = static_cast<std::uint8_t>(timeline.loopStart);
+    gpuAnimation.framerate = framerate;
+    gpuAnimation.startTime = frameTable.getTime() - animation.m_phase - (static_cast<float>(frameID) / framerate);
+
+    //the current frame sets the bounds used for culling
+    sprite.setTextureRect(timeline.frames[frameID]);
+    slot.gpu = true;
+
+    return true;
+}
+
+void SpriteAnimator::stopGPUPlayback(Slot& slot, SpriteAnimation& animation, Sprite& sprite)
+{
+    //the sprite's animations may have been replaced, so the
+    //frame is read from the table rather than the timeline
+    auto& frameTable = Detail::FrameTable::get();
+    const auto& gpuAnimation = sprite.m_gpuAnimation;
+    const auto frameID = getFrame(gpuAnimation, frameTable.getTime());
+    const auto frames = frameTable.getFrames();
+
+    //a paused animation resumes from where it was, rather than
+    //the frame at which it started playing on the GPU
+    if (!animation.m_rewound)
+    {
+        animation.m_frameID = frameID;
+    }
+
+    sprite.setTextureRect((*frames)[gpuAnimation.firstFrame + frameID]);
+    sprite.m_gpuAnimation = {};
+    slot.gpu = false;
+}
+
+void SpriteAnimator::onEntityAdded(Entity entity)
+{
+    auto entityIndex = entity.getIndex();
+    if (entityIndex >= m_slotIndices.size())
+    {
+        m_slotIndices.resize(entityIndex + 1, NoSlot);
+    }
+    m_slotIndices[entityIndex] = static_cast<std::uint32_t>(m_slots.size());
+
+    auto& animationHook = entity.getComponent<SpriteAnimation>().m_hook;
+    animationHook.m_dirtyList = m_dirtyList;
+    animationHook.m_entityIndex = entityIndex;
+    animationHook.m_queued = false;
+
+    auto& spriteHook = entity.getComponent<Sprite>().m_animatorHook;
+    spriteHook.m_dirtyList = m_dirtyList;
+    spriteHook.m_entityIndex = entityIndex;
+    spriteHook.m_queued = false;
+
+    //read the initial state on the next update
+    animationHook.markDirty();
+
+    auto& slot = m_slots.emplace_back();
+    slot.entity = entity;
+    m_timers.push_back(0.f);
+    m_frameTimes.push_back(0.f);
+    m_active.push_back(0.f);
+}
+
+void SpriteAnimator::onEntityRemoved(Entity entity)
+{
+    //swap with the last slot to keep the arrays packed
+    auto index = m_slotIndices[entity.getIndex()];
+    auto last = m_slots.size() - 1;
+    if (index != last)
+    {
+        m_slots[index] = m_slots[last];
+        m_timers[index] = m_timers[last];
+        m_frameTimes[index] = m_frameTimes[last];
+        m_active[index] = m_active[last];
+        m_slotIndices[m_slots[index].entity.getIndex()] = index;
+    }
+    m_slotIndices[entity.getIndex()] = NoSlot;
+    m_slots.pop_back();
+    m_timers.pop_back();
+    m_frameTimes.pop_back();
+    m_active.pop_back();
+}
@@ -29,6 +29,7 @@ source distribution.
 #include "xyginext/ecs/components/Transform.hpp"
 #include "xyginext/ecs/components/Drawable.hpp"
 #include "xyginext/ecs/systems/SpriteSystem.hpp"
+#include "xyginext/core/App.hpp"
 
 using namespace xy;
 
@@ -39,7 +40,8 @@ namespace
 }
 
 SpriteSystem::SpriteSystem(MessageBus& mb)
-    : System        (mb, typeid(SpriteSystem))
+    : System            (mb, typeid(SpriteSystem)),
+    m_instancingEnabled (true)
 {
     //requireComponent<xy::Transform>();
     requireComponent<xy::Sprite>();
@@ -49,14 +51,40 @@ SpriteSystem::SpriteSystem(MessageBus& mb)
 //public
 void SpriteSystem::process(float)
 {
+    const bool instancing = m_instancingEnabled
+        && App::getRenderBackend() == App::RenderBackend::Core;
+
     //update geometry
     auto& entities = getEntities();
     for (auto& entity : entities)
     {
         auto& sprite = entity.getComponent<xy::Sprite>();
-        if (sprite.m_dirty)
+        auto& drawable = entity.getComponent<xy::Drawable>();
+
+        //custom shaders expect regular vertices
+        const bool instanced = instancing && drawable.getShader() == nullptr;
+        if (sprite.m_instanced != instanced)
+        {
+            //GPU animation depends on instancing
+            sprite.m_instanced = instanced;
+            sprite.m_animatorHook.markDirty();
+        }
+
+        if (instanced && (sprite.m_dirty || sprite.m_texCoordsDirty || !drawable.isInstanced()))
+        {
+            Drawable::InstanceData data;
+            data.textureRect = sprite.m_textureRect;
+            data.colour = sprite.m_colour;
+            data.animation = sprite.m_gpuAnimation;
+            drawable.setInstanceData(data);
+            drawable.setTexture(sprite.getTexture());
+
+            sprite.m_dirty = false;
+            sprite.m_texCoordsDirty = false;
+        }
+        else if (!instanced && (sprite.m_dirty || drawable.isInstanced()))
         {
-            auto& drawable = entity.getComponent<xy::Drawable>();
+            drawable.clearInstanceData();
             //drawable.setPrimitiveType(sf::TriangleStrip);
             
             //update vert positions
@@ -85,6 +113,21 @@ void SpriteSystem::process(float)
             drawable.updateLocalBounds();
 
             sprite.m_dirty = false;
+            sprite.m_texCoordsDirty = false;
+        }
+        else if (!instanced && sprite.m_texCoordsDirty)
+        {
+            //animated to a frame of the same size, so positions,
+            //colours and bounds are unchanged
+            const auto subRect = sprite.m_textureRect;
+            auto& verts = drawable.getVertices();
+            verts[0].texCoords = { subRect.left, subRect.top };
+            verts[3].texCoords = { subRect.left + subRect.width, subRect.top };
+            verts[2].texCoords = { subRect.left + subRect.width, subRect.top + subRect.height };
+            verts[1].texCoords = { subRect.left, subRect.top + subRect.height };
+            drawable.markContentChanged();
+
+            sprite.m_texCoordsDirty = false;
         }
     }
 }
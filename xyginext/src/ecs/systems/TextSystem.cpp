@@ -29,8 +29,6 @@ source distribution.
 #include "xyginext/ecs/components/Drawable.hpp"
 #include "xyginext/ecs/components/Text.hpp"
 
-#include <SFML/Graphics/Font.hpp>
-
 using namespace xy;
 
 TextSystem::TextSystem(MessageBus& mb)
@@ -42,7 +40,7 @@ TextSystem::TextSystem(MessageBus& mb)
 
 void TextSystem::process(float)
 {
-    auto entities = getEntities();
+    const auto& entities = getEntities();
     for (auto entity : entities)
     {
         auto& drawable = entity.getComponent<Drawable>();
@@ -51,9 +49,6 @@ void TextSystem::process(float)
         if (text.m_dirty)
         {
             text.updateVertices(drawable);
-
-            drawable.setTexture(&text.getFont()->getTexture(text.getCharacterSize()));
-            drawable.setPrimitiveType(sf::PrimitiveType::Triangles);
         }
     }
 }
\ No newline at end of file
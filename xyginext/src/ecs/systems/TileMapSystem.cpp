@@ -0,0 +1,364 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include "xyginext/ecs/systems/TileMapSystem.hpp"
+#include "xyginext/ecs/components/Transform.hpp"
+#include "xyginext/ecs/components/Camera.hpp"
+#include "xyginext/ecs/Scene.hpp"
+#include "xyginext/core/App.hpp"
+#include "xyginext/core/Log.hpp"
+#include "xyginext/graphics/RenderStats.hpp"
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace xy;
+
+namespace
+{
+    //the red channel of each vertex holds the index of the tile's animation,
+    //or 255 if it isn't animated. Frames are stored per tileset as the offset
+    //to the frame in pixels, the time the frame ends and the animation length
+    const std::string VertexShader =
+        "#version 120\n"
+        "#define MAX_ANIMATIONS " + std::to_string(TileMap::MaxAnimations) + "\n"
+        "#define MAX_FRAMES " + std::to_string(TileMap::MaxAnimationFrames) + "\n"
+        R"(
+        uniform float u_time;
+        uniform vec4 u_frames[MAX_ANIMATIONS * MAX_FRAMES];
+
+        void main()
+        {
+            gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;
+
+            vec4 texCoord = gl_MultiTexCoord0;
+            int animation = int(gl_Color.r * 255.0 + 0.5);
+            if (animation < MAX_ANIMATIONS)
+            {
+                int first = animation * MAX_FRAMES;
+                float time = mod(u_time, u_frames[first].w);
+                for (int i = 0; i < MAX_FRAMES; ++i)
+                {
+                    if (time < u_frames[first + i].z)
+                    {
+                        texCoord.xy += u_frames[first + i].xy;
+                        break;
+                    }
+                }
+            }
+
+            gl_TexCoord[0] = gl_TextureMatrix[0] * texCoord;
+            gl_FrontColor = vec4(1.0, 1.0, 1.0, gl_Color.a);
+        })";
+
+    const std::string FragmentShader = R"(
+        #version 120
+
+        uniform sampler2D u_texture;
+
+        void main()
+        {
+            gl_FragColor = texture2D(u_texture, gl_TexCoord[0].xy) * gl_Color;
+        })";
+
+    std::uint64_t chunkKey(sf::Vector2u position)
+    {
+        return (std::uint64_t(position.y) << 32) | position.x;
+    }
+
+    struct ChunkRange final
+    {
+        sf::Vector2u start;
+        sf::Vector2u end; //exclusive
+
+        bool contains(sf::Vector2u position) const
+        {
+            return position.x >= start.x && position.x < end.x
+                && position.y >= start.y && position.y < end.y;
+        }
+    };
+}
+
+TileMapSystem::TileMapSystem(xy::MessageBus& mb)
+    : xy::System    (mb, typeid(TileMapSystem)),
+    m_shaderLoaded  (false),
+    m_shaderFailed  (false),
+    m_lastDrawCount (0)
+{
+    requireComponent<TileMap>();
+    requireComponent<Transform>();
+}
+
+//public
+void TileMapSystem::process(float dt)
+{
+    m_streamingAreas.clear();
+
+    const auto* scene = getScene();
+    auto addArea = [&](xy::Entity camera)
+    {
+        if (!camera.destroyed() && camera.hasComponent<Camera>())
+        {
+            const auto& view = camera.getComponent<Camera>().m_view;
+            m_streamingAreas.emplace_back(view.getCenter() - (view.getSize() / 2.f), view.getSize());
+        }
+    };
+
+    const auto& cameras = scene->getRenderCameras();
+    if (cameras.empty())
+    {
+        addArea(scene->getActiveCamera());
+    }
+    else
+    {
+        for (auto camera : cameras)
+        {
+            addArea(camera);
+        }
+    }
+
+    auto& drawItems = m_drawItems[App::getSnapshotWriteIndex()];
+    drawItems.clear();
+
+    auto& entities = getEntities();
+    for (auto entity : entities)
+    {
+        auto& tileMap = entity.getComponent<TileMap>();
+        tileMap.m_time += dt;
+
+        const auto& transform = entity.getComponent<Transform>().getWorldTransform();
+        streamChunks(tileMap, transform);
+
+        for (const auto& chunk : tileMap.m_chunks)
+        {
+            auto& item = drawItems.emplace_back();
+            item.chunk = chunk;
+            item.transform = transform;
+            item.time = tileMap.m_time;
+        }
+    }
+}
+
+//private
+void TileMapSystem::streamChunks(TileMap& tileMap, const sf::Transform& transform) const
+{
+    if ((tileMap.m_tiles.empty() && !tileMap.m_chunkLoader)
+        || tileMap.m_tileCount.x == 0 || tileMap.m_tileCount.y == 0)
+    {
+        return;
+    }
+
+    //replace any chunks which were modified with setTile()
+    for (auto position : tileMap.m_dirtyChunks)
+    {
+        auto chunk = std::find_if(tileMap.m_chunks.begin(), tileMap.m_chunks.end(),
+            [position](const std::shared_ptr<TileMap::Chunk>& c)
+            {
+                return c->position == position;
+            });
+
+        if (chunk != tileMap.m_chunks.end())
+        {
+            *chunk = tileMap.buildChunk(position);
+        }
+    }
+    tileMap.m_dirtyChunks.clear();
+
+    const sf::Vector2f chunkSize(tileMap.m_chunkSize.x * tileMap.m_tileSize.x, tileMap.m_chunkSize.y * tileMap.m_tileSize.y);
+    const sf::Vector2u chunkCount((tileMap.m_tileCount.x + tileMap.m_chunkSize.x - 1) / tileMap.m_chunkSize.x,
+        (tileMap.m_tileCount.y + tileMap.m_chunkSize.y - 1) / tileMap.m_chunkSize.y);
+
+    const auto inverse = transform.getInverse();
+    const sf::Vector2f border(tileMap.m_streamingBorder, tileMap.m_streamingBorder);
+
+    //required ranges, and the same expanded by a chunk to stop
+    //chunks on the border being repeatedly released and rebuilt
+    std::vector<ChunkRange> ranges;
+    std::vector<ChunkRange> keepRanges;
+    for (const auto& area : m_streamingAreas)
+    {
+        auto localArea = inverse.transformRect({ area.left - border.x, area.top - border.y,
+            area.width + (border.x * 2.f), area.height + (border.y * 2.f) });
+
+        auto toChunk = [&](float position, float size, std::uint32_t count)
+        {
+            return static_cast<std::uint32_t>(std::max(0.f, std::min(static_cast<float>(count), std::floor(position / size))));
+        };
+
+        ChunkRange range;
+        range.start = { toChunk(localArea.left, chunkSize.x, chunkCount.x), toChunk(localArea.top, chunkSize.y, chunkCount.y) };
+        range.end = { std::min(chunkCount.x, toChunk(localArea.left + localArea.width, chunkSize.x, chunkCount.x) + 1),
+            std::min(chunkCount.y, toChunk(localArea.top + localArea.height, chunkSize.y, chunkCount.y) + 1) };
+        ranges.push_back(range);
+
+        range.start.x = range.start.x > 0 ? range.start.x - 1 : 0;
+        range.start.y = range.start.y > 0 ? range.start.y - 1 : 0;
+        range.end.x = std::min(chunkCount.x, range.end.x + 1);
+        range.end.y = std::min(chunkCount.y, range.end.y + 1);
+        keepRanges.push_back(range);
+    }
+
+    //release chunks which are out of range
+    tileMap.m_chunks.erase(std::remove_if(tileMap.m_chunks.begin(), tileMap.m_chunks.end(),
+        [&keepRanges](const std::shared_ptr<TileMap::Chunk>& chunk)
+        {
+            return std::none_of(keepRanges.begin(), keepRanges.end(),
+                [&chunk](const ChunkRange& range)
+                {
+                    return range.contains(chunk->position);
+                });
+        }), tileMap.m_chunks.end());
+
+    //chunks are kept sorted by key so that loaded
+    //chunks can be found with a binary search
+    const auto loadedCount = tileMap.m_chunks.size();
+    auto isLoaded = [&tileMap, loadedCount](sf::Vector2u position)
+    {
+        auto end = tileMap.m_chunks.begin() + loadedCount;
+        auto result = std::lower_bound(tileMap.m_chunks.begin(), end, chunkKey(position),
+            [](const std::shared_ptr<TileMap::Chunk>& chunk, std::uint64_t key)
+            {
+                return chunkKey(chunk->position) < key;
+            });
+        return result != end && (*result)->position == position;
+    };
+
+    for (const auto& range : ranges)
+    {
+        for (auto y = range.start.y; y < range.end.y; ++y)
+        {
+            for (auto x = range.start.x; x < range.end.x; ++x)
+            {
+                sf::Vector2u position(x, y);
+                if (!isLoaded(position)
+                    && std::none_of(tileMap.m_chunks.begin() + loadedCount, tileMap.m_chunks.end(),
+                        [position](const std::shared_ptr<TileMap::Chunk>& chunk)
+                        {
+                            return chunk->position == position;
+                        }))
+                {
+                    tileMap.m_chunks.push_back(tileMap.buildChunk(position));
+                }
+            }
+        }
+    }
+
+    if (tileMap.m_chunks.size() != loadedCount)
+    {
+        std::sort(tileMap.m_chunks.begin(), tileMap.m_chunks.end(),
+            [](const std::shared_ptr<TileMap::Chunk>& a, const std::shared_ptr<TileMap::Chunk>& b)
+            {
+                return chunkKey(a->position) < chunkKey(b->position);
+            });
+    }
+}
+
+void TileMapSystem::draw(sf::RenderTarget& rt, sf::RenderStates states) const
+{
+    RenderStats::Scope scope("TileMapSystem");
+    m_lastDrawCount = 0;
+
+    //loaded on first draw so that it's created on the thread which renders
+    if (!m_shaderLoaded && !m_shaderFailed)
+    {
+        if (m_shader.loadFromMemory(VertexShader, FragmentShader))
+        {
+            m_shader.setUniform("u_texture", sf::Shader::CurrentTexture);
+            m_shaderLoaded = true;
+        }
+        else
+        {
+            Logger::log("Failed creating tile map shader, tiles will not be animated", Logger::Type::Error);
+            m_shaderFailed = true;
+        }
+    }
+
+    const auto& view = rt.getView();
+    const sf::FloatRect viewableArea(view.getCenter() - (view.getSize() / 2.f), view.getSize());
+
+    const auto baseTransform = states.transform;
+    if (m_shaderLoaded)
+    {
+        states.shader = &m_shader;
+    }
+
+    const TileMap::TilesetData* lastTileset = nullptr;
+    float lastTime = -1.f;
+
+    const auto& drawItems = m_drawItems[App::getSnapshotReadIndex()];
+    for (const auto& item : drawItems)
+    {
+        if (!item.transform.transformRect(item.chunk->bounds).intersects(viewableArea))
+        {
+            continue;
+        }
+
+        states.transform = baseTransform * item.transform;
+
+        for (const auto& geometry : item.chunk->geometry)
+        {
+            if (m_shaderLoaded)
+            {
+                if (geometry.tileset.get() != lastTileset)
+                {
+                    lastTileset = geometry.tileset.get();
+                    m_shader.setUniformArray("u_frames", lastTileset->frames.data(), lastTileset->frames.size());
+                }
+
+                if (item.time != lastTime)
+                {
+                    lastTime = item.time;
+                    m_shader.setUniform("u_time", lastTime * 1000.f);
+                }
+            }
+            states.texture = geometry.tileset->tileset.texture;
+
+            if (sf::VertexBuffer::isAvailable())
+            {
+                //chunks are immutable, so the buffer is only ever written once
+                if (!geometry.uploaded)
+                {
+                    geometry.buffer.setPrimitiveType(sf::Quads);
+                    geometry.buffer.setUsage(sf::VertexBuffer::Static);
+                    geometry.buffer.create(geometry.vertices.size());
+                    geometry.buffer.update(geometry.vertices.data());
+                    geometry.uploaded = true;
+                }
+                rt.draw(geometry.buffer, states);
+            }
+            else
+            {
+                rt.draw(geometry.vertices.data(), geometry.vertices.size(), sf::Quads, states);
+            }
+            RenderStats::addDrawCall(static_cast<std::uint32_t>(geometry.vertices.size()));
+            m_lastDrawCount++;
+        }
+    }
+}
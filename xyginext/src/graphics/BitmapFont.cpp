@@ -28,6 +28,8 @@ source distribution.
 #include "xyginext/graphics/BitmapFont.hpp"
 #include "xyginext/core/Assert.hpp"
 
+#include <SFML/Graphics/Image.hpp>
+
 using namespace xy;
 
 namespace
@@ -54,18 +56,42 @@ bool BitmapFont::loadTextureFromFile(const std::string& path)
         return false;
     }
 
-    m_textureSize = sf::Vector2f(m_texture.getSize());
-    m_charSize = { m_textureSize.x / CountX, m_textureSize.y / CountY };
+    updateGlyphs();
+    return true;
+}
+
+bool BitmapFont::loadTextureFromImage(const sf::Image& image)
+{
+    if (!m_texture.loadFromImage(image))
+    {
+        return false;
+    }
+
+    updateGlyphs();
     return true;
 }
 
-sf::FloatRect BitmapFont::getGlyph(char character) const
+const sf::FloatRect& BitmapFont::getGlyph(char character) const
 {
     XY_ASSERT(character > 31 && character < 127, "character out of range");
 
-    char c = character - 32;
-    int xIndex = c % CountX;
-    int yIndex = c / CountX;
+    if (character < 32 || character > 126)
+    {
+        return m_glyphs[0];
+    }
+    return m_glyphs[character - 32];
+}
+
+//private
+void BitmapFont::updateGlyphs()
+{
+    m_textureSize = sf::Vector2f(m_texture.getSize());
+    m_charSize = { m_textureSize.x / CountX, m_textureSize.y / CountY };
 
-    return { xIndex * m_charSize.x, yIndex * m_charSize.y, m_charSize.x, m_charSize.y };
-}
\ No newline at end of file
+    for (auto i = 0u; i < m_glyphs.size(); ++i)
+    {
+        int xIndex = i % CountX;
+        int yIndex = i / CountX;
+        m_glyphs[i] = { xIndex * m_charSize.x, yIndex * m_charSize.y, m_charSize.x, m_charSize.y };
+    }
+}
@@ -0,0 +1,133 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include "xyginext/graphics/DynamicResolution.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace xy;
+
+namespace
+{
+    //smoothing applied to frame time samples
+    constexpr float SampleWeight = 0.1f;
+
+    //frames to wait after changing the scale, so that the
+    //average reflects the new scale before changing again
+    constexpr std::uint32_t CooldownFrames = 30;
+
+    //stable frames to wait before probing a higher scale
+    constexpr std::uint32_t ProbeFrames = 180;
+
+    //the frame time must leave this band around the target
+    //before the scale is changed
+    constexpr float UpperThreshold = 1.1f;
+    constexpr float LowerThreshold = 0.85f;
+}
+
+DynamicResolution::DynamicResolution()
+    : DynamicResolution(Settings())
+{
+
+}
+
+DynamicResolution::DynamicResolution(const Settings& settings)
+    : m_scale           (1.f),
+    m_averageFrameTime  (0.f),
+    m_cooldown          (0),
+    m_stableFrames      (0)
+{
+    setSettings(settings);
+    reset();
+}
+
+//public
+void DynamicResolution::setSettings(const Settings& settings)
+{
+    m_settings = settings;
+    m_settings.minScale = std::max(0.1f, std::min(1.f, m_settings.minScale));
+    m_settings.maxScale = std::max(m_settings.minScale, std::min(1.f, m_settings.maxScale));
+    m_settings.targetFrameTime = std::max(0.001f, m_settings.targetFrameTime);
+    m_settings.step = std::max(0.01f, m_settings.step);
+
+    setScale(m_scale);
+}
+
+float DynamicResolution::update(float frameTime)
+{
+    m_averageFrameTime += (frameTime - m_averageFrameTime) * SampleWeight;
+
+    if (m_cooldown > 0)
+    {
+        m_cooldown--;
+        return m_scale;
+    }
+
+    //pixel cost is proportional to the area, but
+    //always move by at least one step
+    const auto ratio = m_averageFrameTime / m_settings.targetFrameTime;
+    if (ratio > UpperThreshold)
+    {
+        setScale(std::min(m_scale - m_settings.step, m_scale / std::sqrt(ratio)));
+        m_stableFrames = 0;
+    }
+    else if (ratio < LowerThreshold)
+    {
+        setScale(std::max(m_scale + m_settings.step, m_scale / std::sqrt(ratio)));
+        m_stableFrames = 0;
+    }
+    else if (++m_stableFrames > ProbeFrames)
+    {
+        setScale(m_scale + m_settings.step);
+        m_stableFrames = 0;
+    }
+    return m_scale;
+}
+
+void DynamicResolution::reset()
+{
+    m_averageFrameTime = m_settings.targetFrameTime;
+    m_cooldown = 0;
+    m_stableFrames = 0;
+    m_scale = m_settings.maxScale;
+}
+
+//private
+void DynamicResolution::setScale(float scale)
+{
+    //quantise the scale so that small fluctuations
+    //don't cause the buffer to be continually resized
+    scale = std::round(scale / m_settings.step) * m_settings.step;
+    scale = std::max(m_settings.minScale, std::min(m_settings.maxScale, scale));
+
+    if (scale != m_scale)
+    {
+        m_scale = scale;
+        m_cooldown = CooldownFrames;
+    }
+}
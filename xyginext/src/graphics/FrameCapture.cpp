@@ -0,0 +1,376 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include "xyginext/graphics/FrameCapture.hpp"
+#include "xyginext/core/Log.hpp"
+
+#include "../detail/GLCheck.hpp"
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+using namespace xy;
+
+namespace
+{
+    //frames waiting to be written before new frames are dropped
+    constexpr std::size_t MaxQueuedJobs = 8;
+
+    //frames to wait before mapping a buffer when fences are unavailable
+    constexpr std::uint32_t MinBufferAge = 2;
+
+    bool pixelBuffersAvailable()
+    {
+        return GLAD_GL_ARB_pixel_buffer_object && GLAD_GL_ARB_vertex_buffer_object;
+    }
+
+    //pixels are read bottom up
+    void flipRows(std::vector<std::uint8_t>& pixels, sf::Vector2u size)
+    {
+        const std::size_t stride = size.x * 4;
+        std::vector<std::uint8_t> row(stride);
+        for (auto y = 0u; y < size.y / 2; ++y)
+        {
+            auto* top = pixels.data() + (y * stride);
+            auto* bottom = pixels.data() + ((size.y - y - 1) * stride);
+            std::memcpy(row.data(), top, stride);
+            std::memcpy(top, bottom, stride);
+            std::memcpy(bottom, row.data(), stride);
+        }
+    }
+}
+
+FrameCapture::FrameCapture()
+    : m_nextSlot        (0),
+    m_recordingFormat   (Format::PNG),
+    m_recordingInterval (1),
+    m_frameCount        (0),
+    m_recordedCount     (0),
+    m_recording         (false),
+    m_droppedFrames     (0),
+    m_activeJobs        (0),
+    m_writerQuit        (false)
+{
+
+}
+
+FrameCapture::~FrameCapture()
+{
+    {
+        TransientContextLock lock;
+        resolve(true);
+
+        for (auto& slot : m_slots)
+        {
+            if (slot.buffer)
+            {
+                glCheck(glDeleteBuffersARB(1, &slot.buffer));
+            }
+        }
+    }
+
+    if (m_writerThread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_writerMutex);
+            m_writerQuit = true;
+        }
+        m_writerCondition.notify_all();
+        m_writerThread.join();
+    }
+}
+
+//public
+void FrameCapture::saveScreenshot(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(m_settingsMutex);
+    m_screenshotPath = path;
+}
+
+void FrameCapture::startRecording(const std::string& directory, Format format, std::uint32_t interval)
+{
+    std::lock_guard<std::mutex> lock(m_settingsMutex);
+    m_recordingDirectory = directory;
+    m_recordingFormat = format;
+    m_recordingInterval = std::max(1u, interval);
+    m_frameCount = 0;
+    m_recordedCount = 0;
+    m_droppedFrames = 0;
+    m_recording = true;
+
+    if (!pixelBuffersAvailable())
+    {
+        Logger::log("Pixel buffer objects are unavailable, recording will affect performance", Logger::Type::Warning);
+    }
+}
+
+void FrameCapture::stopRecording()
+{
+    m_recording = false;
+}
+
+void FrameCapture::capture(sf::RenderTarget& target)
+{
+    if (!target.setActive(true))
+    {
+        return;
+    }
+
+    resolve(false);
+
+    Job job;
+    job.size = target.getSize();
+    if (nextCapture(job))
+    {
+        readPixels(std::move(job));
+    }
+}
+
+void FrameCapture::flush()
+{
+    resolve(true);
+
+    std::unique_lock<std::mutex> lock(m_writerMutex);
+    m_writerCondition.wait(lock, [this]() { return m_jobs.empty() && m_activeJobs == 0; });
+}
+
+//private
+bool FrameCapture::nextCapture(Job& job)
+{
+    std::lock_guard<std::mutex> lock(m_settingsMutex);
+    if (!m_screenshotPath.empty())
+    {
+        job.path = m_screenshotPath;
+        job.format = Format::PNG;
+        m_screenshotPath.clear();
+        return true;
+    }
+
+    if (m_recording
+        && (m_frameCount++ % m_recordingInterval) == 0)
+    {
+        std::stringstream ss;
+        ss << m_recordingDirectory << "/frame_" << std::setw(6) << std::setfill('0') << m_recordedCount++;
+        if (m_recordingFormat == Format::PNG)
+        {
+            ss << ".png";
+        }
+        else
+        {
+            ss << "_" << job.size.x << "x" << job.size.y << ".rgba";
+        }
+        job.path = ss.str();
+        job.format = m_recordingFormat;
+        return true;
+    }
+    return false;
+}
+
+void FrameCapture::readPixels(Job&& job)
+{
+    const std::size_t byteCount = job.size.x * job.size.y * 4;
+    if (byteCount == 0)
+    {
+        return;
+    }
+
+    if (!pixelBuffersAvailable())
+    {
+        job.pixels.resize(byteCount);
+        glCheck(glReadPixels(0, 0, job.size.x, job.size.y, GL_RGBA, GL_UNSIGNED_BYTE, job.pixels.data()));
+        submit(std::move(job));
+        return;
+    }
+
+    //if the oldest buffer still hasn't been read the ring is full
+    auto& slot = m_slots[m_nextSlot];
+    if (slot.pending)
+    {
+        m_droppedFrames++;
+        return;
+    }
+    m_nextSlot = (m_nextSlot + 1) % SlotCount;
+
+    if (slot.buffer == 0)
+    {
+        glCheck(glGenBuffersARB(1, &slot.buffer));
+    }
+    glCheck(glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, slot.buffer));
+    if (slot.bufferSize != byteCount)
+    {
+        glCheck(glBufferDataARB(GL_PIXEL_PACK_BUFFER_ARB, byteCount, nullptr, GL_STREAM_READ_ARB));
+        slot.bufferSize = byteCount;
+    }
+
+    //with a pack buffer bound this returns immediately
+    //and the copy is performed asynchronously
+    glCheck(glReadPixels(0, 0, job.size.x, job.size.y, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+    glCheck(glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, 0));
+
+    if (GLAD_GL_ARB_sync)
+    {
+        slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    slot.age = 0;
+    slot.pending = true;
+    slot.job = std::move(job);
+}
+
+void FrameCapture::resolve(bool wait)
+{
+    for (auto& slot : m_slots)
+    {
+        slot.age++;
+    }
+
+    //slots are used in turn, so the next slot is the oldest
+    for (auto i = 0u; i < SlotCount; ++i)
+    {
+        auto& slot = m_slots[(m_nextSlot + i) % SlotCount];
+        if (!slot.pending)
+        {
+            continue;
+        }
+
+        bool ready = wait;
+        if (slot.fence)
+        {
+            auto fence = static_cast<GLsync>(slot.fence);
+            auto result = glClientWaitSync(fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? GL_TIMEOUT_IGNORED : 0);
+            ready = (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED || wait);
+        }
+        else if (!ready)
+        {
+            ready = slot.age > MinBufferAge;
+        }
+
+        //later captures won't be ready either
+        if (!ready)
+        {
+            break;
+        }
+
+        if (slot.fence)
+        {
+            glCheck(glDeleteSync(static_cast<GLsync>(slot.fence)));
+            slot.fence = nullptr;
+        }
+
+        glCheck(glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, slot.buffer));
+        const auto* data = static_cast<const std::uint8_t*>(glMapBufferARB(GL_PIXEL_PACK_BUFFER_ARB, GL_READ_ONLY_ARB));
+        if (data)
+        {
+            slot.job.pixels.assign(data, data + slot.bufferSize);
+            glCheck(glUnmapBufferARB(GL_PIXEL_PACK_BUFFER_ARB));
+        }
+        glCheck(glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, 0));
+
+        slot.pending = false;
+        if (data)
+        {
+            submit(std::move(slot.job));
+        }
+        slot.job = {};
+    }
+}
+
+void FrameCapture::submit(Job&& job)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        if (m_jobs.size() >= MaxQueuedJobs)
+        {
+            m_droppedFrames++;
+            return;
+        }
+        m_jobs.push_back(std::move(job));
+    }
+
+    if (!m_writerThread.joinable())
+    {
+        m_writerThread = std::thread(&FrameCapture::writerLoop, this);
+    }
+    m_writerCondition.notify_all();
+}
+
+void FrameCapture::writerLoop()
+{
+    while (true)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_writerMutex);
+            m_writerCondition.wait(lock, [this]() { return !m_jobs.empty() || m_writerQuit; });
+
+            //remaining jobs are written before quitting
+            if (m_jobs.empty())
+            {
+                break;
+            }
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            m_activeJobs++;
+        }
+
+        flipRows(job.pixels, job.size);
+
+        if (job.format == Format::PNG)
+        {
+            sf::Image image;
+            image.create(job.size.x, job.size.y, job.pixels.data());
+            if (!image.saveToFile(job.path))
+            {
+                Logger::log("Failed to save " + job.path, Logger::Type::Error, Logger::Output::File);
+            }
+        }
+        else
+        {
+            std::ofstream file(job.path, std::ios::binary);
+            if (file.is_open() && file.good())
+            {
+                file.write(reinterpret_cast<const char*>(job.pixels.data()), job.pixels.size());
+            }
+            else
+            {
+                Logger::log("Failed to write " + job.path, Logger::Type::Error, Logger::Output::File);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_writerMutex);
+            m_activeJobs--;
+        }
+        m_writerCondition.notify_all();
+    }
+}
@@ -0,0 +1,253 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include "xyginext/graphics/RenderHarness.hpp"
+#include "xyginext/graphics/RenderStats.hpp"
+#include "xyginext/ecs/Scene.hpp"
+#include "xyginext/core/MessageBus.hpp"
+#include "xyginext/core/Log.hpp"
+
+#include "../detail/DistanceField.hpp"
+#include "../detail/GLCheck.hpp"
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Clock.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace xy;
+
+RenderHarness::RenderHarness(sf::Vector2u size)
+    : m_valid       (false),
+    m_updateGolden  (false),
+    m_timestep      (1.f / 60.f)
+{
+    if (m_target.create(size.x, size.y, sf::ContextSettings(24))
+        && m_target.setActive(true))
+    {
+        //usually loaded by the App
+        m_valid = gladLoadGL() != 0;
+    }
+
+    if (!m_valid)
+    {
+        Logger::log("Failed creating render harness target", Logger::Type::Error, Logger::Output::All);
+    }
+}
+
+RenderHarness::~RenderHarness()
+{
+    //release shared text resources while there is still a context,
+    //as the App would when it quits
+    Detail::DistanceFieldCache::get().clear();
+}
+
+//public
+void RenderHarness::addGoldenImage(const Golden& golden)
+{
+    m_goldenImages.push_back(golden);
+}
+
+void RenderHarness::addGoldenImage(std::size_t frame, const std::string& path)
+{
+    Golden golden;
+    golden.frame = frame;
+    golden.path = path;
+    addGoldenImage(golden);
+}
+
+RenderHarness::Result RenderHarness::run(Scene& scene, MessageBus& messageBus, std::size_t frameCount,
+    const std::function<void(std::size_t, Scene&)>& script)
+{
+    Result result;
+    if (!m_valid)
+    {
+        result.passed = false;
+        return result;
+    }
+
+    //pass times are summed by name each frame, then averaged
+    std::size_t gpuFrameCount = 0;
+    float gpuTotal = 0.f;
+    RenderStats::setFrameCallback([&](const RenderStats::Frame& frame)
+        {
+            if (frame.gpuTime < 0.f)
+            {
+                return;
+            }
+            gpuFrameCount++;
+            gpuTotal += frame.gpuTime;
+
+            for (const auto& pass : frame.passes)
+            {
+                if (pass.gpuTime < 0.f)
+                {
+                    continue;
+                }
+
+                auto passTime = std::find_if(result.passTimes.begin(), result.passTimes.end(),
+                    [&pass](const PassTime& p)
+                    {
+                        return p.name == pass.name;
+                    });
+                if (passTime == result.passTimes.end())
+                {
+                    passTime = result.passTimes.insert(result.passTimes.end(), { pass.name, 0.f });
+                }
+                passTime->gpuTime += pass.gpuTime;
+            }
+        });
+
+    const bool passTiming = RenderStats::getPassTimingEnabled();
+    RenderStats::setPassTimingEnabled(true);
+
+    float cpuTotal = 0.f;
+    sf::Clock clock;
+    for (auto i = 0u; i < frameCount; ++i)
+    {
+        if (script)
+        {
+            script(i, scene);
+        }
+
+        while (!messageBus.empty())
+        {
+            scene.forwardMessage(messageBus.poll());
+        }
+        scene.update(m_timestep);
+
+        clock.restart();
+        m_target.setActive(true);
+        RenderStats::beginFrame();
+
+        m_target.clear(sf::Color::Black);
+        m_target.draw(scene);
+
+        RenderStats::endFrame();
+        m_target.display();
+
+        //so that the CPU time includes the time taken to draw the frame
+        glCheck(glFinish());
+        cpuTotal += clock.getElapsedTime().asSeconds() * 1000.f;
+
+        auto golden = std::find_if(m_goldenImages.begin(), m_goldenImages.end(),
+            [i](const Golden& g)
+            {
+                return g.frame == i;
+            });
+        if (golden != m_goldenImages.end()
+            && !checkGolden(*golden))
+        {
+            result.failedFrames.push_back(i);
+            result.passed = false;
+        }
+    }
+
+    m_target.setActive(true);
+    RenderStats::flush();
+    RenderStats::setFrameCallback({});
+    RenderStats::setPassTimingEnabled(passTiming);
+
+    result.frameCount = frameCount;
+    if (frameCount > 0)
+    {
+        result.cpuFrameTime = cpuTotal / static_cast<float>(frameCount);
+    }
+
+    if (gpuFrameCount > 0)
+    {
+        result.gpuFrameTime = gpuTotal / static_cast<float>(gpuFrameCount);
+        for (auto& pass : result.passTimes)
+        {
+            pass.gpuTime /= static_cast<float>(gpuFrameCount);
+        }
+    }
+
+    return result;
+}
+
+float RenderHarness::compareImages(const sf::Image& a, const sf::Image& b, std::uint8_t threshold)
+{
+    if (a.getSize() != b.getSize()
+        || a.getSize().x == 0 || a.getSize().y == 0)
+    {
+        return 1.f;
+    }
+
+    const auto* pixelsA = a.getPixelsPtr();
+    const auto* pixelsB = b.getPixelsPtr();
+    const std::size_t pixelCount = a.getSize().x * a.getSize().y;
+
+    std::size_t differentCount = 0;
+    for (auto i = 0u; i < pixelCount; ++i)
+    {
+        for (auto j = 0u; j < 4u; ++j)
+        {
+            auto idx = (i * 4) + j;
+            if (std::abs(static_cast<std::int32_t>(pixelsA[idx]) - static_cast<std::int32_t>(pixelsB[idx])) > threshold)
+            {
+                differentCount++;
+                break;
+            }
+        }
+    }
+
+    return static_cast<float>(differentCount) / static_cast<float>(pixelCount);
+}
+
+//private
+bool RenderHarness::checkGolden(const Golden& golden)
+{
+    auto output = m_target.getTexture().copyToImage();
+
+    if (m_updateGolden)
+    {
+        if (!output.saveToFile(golden.path))
+        {
+            Logger::log("Failed writing golden image " + golden.path, Logger::Type::Error);
+            return false;
+        }
+        return true;
+    }
+
+    sf::Image expected;
+    if (!expected.loadFromFile(golden.path))
+    {
+        Logger::log("Failed loading golden image " + golden.path, Logger::Type::Error);
+        return false;
+    }
+
+    auto difference = compareImages(output, expected, golden.threshold);
+    if (difference > golden.maxDifference)
+    {
+        Logger::log("Frame " + std::to_string(golden.frame) + " differs from " + golden.path
+            + " by " + std::to_string(difference * 100.f) + "%", Logger::Type::Warning);
+        return false;
+    }
+    return true;
+}
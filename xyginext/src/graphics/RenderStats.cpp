@@ -0,0 +1,350 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include "xyginext/graphics/RenderStats.hpp"
+
+#include "../detail/GLCheck.hpp"
+#include "../detail/GLStateCache.hpp"
+
+#include <SFML/Window/Context.hpp>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+
+using namespace xy;
+
+namespace
+{
+    //number of frames recorded before the
+    //results of the oldest are read back
+    constexpr std::size_t FrameLatency = 4;
+
+    struct PendingPass final
+    {
+        const char* name = nullptr;
+        std::uint32_t depth = 0;
+        std::int32_t beginQuery = -1;
+        std::int32_t endQuery = -1;
+        std::uint32_t drawCalls = 0;
+        std::uint32_t vertexCount = 0;
+    };
+
+    struct PendingFrame final
+    {
+        std::vector<GLuint> queries;
+        std::size_t queryCount = 0;
+        std::vector<PendingPass> passes;
+        std::int32_t beginQuery = -1;
+        std::int32_t endQuery = -1;
+
+        std::uint32_t drawCalls = 0;
+        std::uint32_t vertexCount = 0;
+        std::uint32_t stateChanges = 0;
+        std::uint32_t skippedStateChanges = 0;
+
+        std::uint64_t contextID = 0;
+        bool pending = false;
+    };
+
+    std::array<PendingFrame, FrameLatency> frames;
+    std::size_t currentFrame = 0;
+    bool inFrame = false;
+
+    //indices of the currently open passes
+    std::vector<std::size_t> openPasses;
+
+    std::atomic<bool> passTiming = false;
+    std::atomic<bool> timerAvailable = false;
+    std::atomic<float> lastFrameTime = -1.f;
+
+    std::mutex resultMutex;
+    RenderStats::Frame lastFrame;
+    std::function<void(const RenderStats::Frame&)> frameCallback;
+
+    //records a timestamp and returns the index of its query, or -1
+    //if timers are unavailable. Queries aren't shared between contexts
+    //so anything drawn with a different context active isn't timed
+    std::int32_t writeTimestamp(PendingFrame& frame)
+    {
+        if (!timerAvailable
+            || sf::Context::getActiveContextId() != frame.contextID)
+        {
+            return -1;
+        }
+
+        if (frame.queryCount == frame.queries.size())
+        {
+            GLuint query = 0;
+            glCheck(glGenQueriesARB(1, &query));
+            frame.queries.push_back(query);
+        }
+
+        auto index = frame.queryCount++;
+        glCheck(glQueryCounter(frame.queries[index], GL_TIMESTAMP));
+        return static_cast<std::int32_t>(index);
+    }
+
+    //query names only exist in the context which created them, so any
+    //created in another context are left to be freed along with it
+    void deleteQueries(PendingFrame& frame)
+    {
+        if (!frame.queries.empty()
+            && sf::Context::getActiveContextId() == frame.contextID)
+        {
+            glCheck(glDeleteQueriesARB(static_cast<GLsizei>(frame.queries.size()), frame.queries.data()));
+        }
+        frame.queries.clear();
+        frame.queryCount = 0;
+    }
+
+    float getElapsed(const std::vector<GLuint64>& timestamps, std::int32_t begin, std::int32_t end)
+    {
+        if (begin < 0 || end < 0)
+        {
+            return -1.f;
+        }
+        return static_cast<float>(static_cast<double>(timestamps[end] - timestamps[begin]) / 1000000.0);
+    }
+
+    void resolve(PendingFrame& frame, bool wait = false)
+    {
+        if (!frame.pending)
+        {
+            return;
+        }
+        frame.pending = false;
+
+        //queries complete in order, so if the last is available they all are
+        std::vector<GLuint64> timestamps;
+        if (frame.queryCount > 0
+            && sf::Context::getActiveContextId() == frame.contextID)
+        {
+            GLint available = wait ? 1 : 0;
+            if (!wait)
+            {
+                glCheck(glGetQueryObjectivARB(frame.queries[frame.queryCount - 1], GL_QUERY_RESULT_AVAILABLE_ARB, &available));
+            }
+
+            if (available)
+            {
+                timestamps.resize(frame.queryCount);
+                for (auto i = 0u; i < frame.queryCount; ++i)
+                {
+                    glCheck(glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT_ARB, &timestamps[i]));
+                }
+            }
+        }
+
+        if (timestamps.empty())
+        {
+            //results are dropped rather than waited for
+            frame.beginQuery = frame.endQuery = -1;
+            for (auto& pass : frame.passes)
+            {
+                pass.beginQuery = pass.endQuery = -1;
+            }
+        }
+
+        RenderStats::Frame result;
+        result.gpuTime = getElapsed(timestamps, frame.beginQuery, frame.endQuery);
+        result.drawCalls = frame.drawCalls;
+        result.vertexCount = frame.vertexCount;
+        result.stateChanges = frame.stateChanges;
+        result.skippedStateChanges = frame.skippedStateChanges;
+
+        result.passes.resize(frame.passes.size());
+        for (auto i = 0u; i < frame.passes.size(); ++i)
+        {
+            const auto& src = frame.passes[i];
+            auto& dst = result.passes[i];
+            dst.name = src.name;
+            dst.depth = src.depth;
+            dst.gpuTime = getElapsed(timestamps, src.beginQuery, src.endQuery);
+            dst.drawCalls = src.drawCalls;
+            dst.vertexCount = src.vertexCount;
+        }
+
+        if (result.gpuTime >= 0.f)
+        {
+            lastFrameTime = result.gpuTime / 1000.f;
+        }
+
+        if (frameCallback)
+        {
+            frameCallback(result);
+        }
+
+        std::lock_guard<std::mutex> lock(resultMutex);
+        lastFrame = std::move(result);
+    }
+}
+
+RenderStats::Scope::Scope(const char* name)
+    : m_active(inFrame && passTiming)
+{
+    if (m_active)
+    {
+        auto& frame = frames[currentFrame];
+        openPasses.push_back(frame.passes.size());
+
+        auto& pass = frame.passes.emplace_back();
+        pass.name = name;
+        pass.depth = static_cast<std::uint32_t>(openPasses.size() - 1);
+        pass.beginQuery = writeTimestamp(frame);
+    }
+}
+
+RenderStats::Scope::~Scope()
+{
+    //the frame may have ended while the scope was open
+    if (m_active && inFrame && !openPasses.empty())
+    {
+        auto& frame = frames[currentFrame];
+        frame.passes[openPasses.back()].endQuery = writeTimestamp(frame);
+        openPasses.pop_back();
+    }
+}
+
+//public
+void RenderStats::setPassTimingEnabled(bool enabled)
+{
+    passTiming = enabled;
+}
+
+bool RenderStats::getPassTimingEnabled()
+{
+    return passTiming;
+}
+
+bool RenderStats::isTimerAvailable()
+{
+    return timerAvailable;
+}
+
+RenderStats::Frame RenderStats::getLastFrame()
+{
+    std::lock_guard<std::mutex> lock(resultMutex);
+    return lastFrame;
+}
+
+float RenderStats::getGPUFrameTime()
+{
+    return lastFrameTime;
+}
+
+void RenderStats::addDrawCall(std::uint32_t vertexCount)
+{
+    if (!inFrame)
+    {
+        return;
+    }
+
+    auto& frame = frames[currentFrame];
+    frame.drawCalls++;
+    frame.vertexCount += vertexCount;
+
+    //counts are inclusive of nested passes
+    for (auto i : openPasses)
+    {
+        frame.passes[i].drawCalls++;
+        frame.passes[i].vertexCount += vertexCount;
+    }
+}
+
+//private
+void RenderStats::beginFrame()
+{
+    timerAvailable = GLAD_GL_ARB_timer_query && GLAD_GL_ARB_occlusion_query;
+
+    //the oldest frame is reused, so read back its results first
+    currentFrame = (currentFrame + 1) % FrameLatency;
+    auto& frame = frames[currentFrame];
+    resolve(frame);
+
+    //the frame's queries can't be reused by a different context
+    const auto contextID = sf::Context::getActiveContextId();
+    if (frame.contextID != contextID)
+    {
+        deleteQueries(frame);
+        frame.contextID = contextID;
+    }
+
+    frame.queryCount = 0;
+    frame.passes.clear();
+    frame.drawCalls = 0;
+    frame.vertexCount = 0;
+    frame.pending = true;
+
+    openPasses.clear();
+    inFrame = true;
+
+    frame.beginQuery = writeTimestamp(frame);
+}
+
+void RenderStats::flush()
+{
+    //oldest first
+    for (auto i = 1u; i <= FrameLatency; ++i)
+    {
+        resolve(frames[(currentFrame + i) % FrameLatency], true);
+    }
+}
+
+void RenderStats::shutdown()
+{
+    flush();
+    for (auto& frame : frames)
+    {
+        deleteQueries(frame);
+    }
+    inFrame = false;
+}
+
+void RenderStats::setFrameCallback(const std::function<void(const Frame&)>& callback)
+{
+    frameCallback = callback;
+}
+
+void RenderStats::endFrame()
+{
+    auto& frame = frames[currentFrame];
+
+    //close any passes left open
+    while (!openPasses.empty())
+    {
+        frame.passes[openPasses.back()].endQuery = writeTimestamp(frame);
+        openPasses.pop_back();
+    }
+    frame.endQuery = writeTimestamp(frame);
+
+    const auto& glState = Detail::GLStateCache::get();
+    frame.stateChanges = glState.getIssuedCount();
+    frame.skippedStateChanges = glState.getSkippedCount();
+
+    inFrame = false;
+}
@@ -72,8 +72,8 @@ bool SpriteSheet::saveToFile(const std::string &path)
         sprObj->addProperty("bounds").setValue(sprite.getTextureRect());
         sprObj->addProperty("colour").setValue(sprite.getColour());
         
-        auto& anims = sprite.getAnimations();
-        for (auto i(0u); i < sprite.getAnimations().size(); i++)
+        const auto& anims = sprite.getAnimations();
+        for (auto i(0u); i < anims.size(); i++)
         {
             auto animObj = sprObj->addObject("animation", m_animations[name][i]);
             animObj->addProperty("framerate").setValue(anims[i].framerate);
@@ -226,13 +226,15 @@ bool SpriteSheet::loadFromFile(const std::string& path, std::function<sf::Textur
                 spriteComponent.setColour(p->getValue<sf::Color>());
             }
 
+            //built once here and shared by every sprite returned from getSprite()
+            std::vector<Sprite::Animation> animations;
             const auto& spriteObjs = spr.getObjects();
             for (const auto& sprOb : spriteObjs)
             {
                 if (sprOb.getName() == "animation"
-                    && spriteComponent.m_animations.size() < Sprite::MaxAnimations)
+                    && animations.size() < Sprite::MaxAnimations)
                 {
-                    auto& anim = spriteComponent.m_animations.emplace_back();
+                    auto& anim = animations.emplace_back();
 
                     const auto& properties = sprOb.getProperties();
                     for (const auto& p : properties)
@@ -264,6 +266,7 @@ bool SpriteSheet::loadFromFile(const std::string& path, std::function<sf::Textur
                 }
             }
 
+            spriteComponent.setAnimations(std::move(animations));
             m_sprites.insert(std::make_pair(spriteName, spriteComponent));
             count++;
         }
@@ -0,0 +1,532 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include "xyginext/graphics/TextureAtlas.hpp"
+#include "xyginext/graphics/SpriteSheet.hpp"
+#include "xyginext/ecs/components/Sprite.hpp"
+#include "xyginext/core/Log.hpp"
+
+#include "../detail/GLCheck.hpp"
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Window/GlResource.hpp>
+
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "../imgui/imstb_rectpack.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace xy;
+
+namespace
+{
+    //gap left between packed images to prevent bleeding when filtering
+    constexpr std::int32_t Padding = 1;
+
+    //rows of a page cleared per upload when framebuffers are unavailable
+    constexpr std::uint32_t ClearStripHeight = 64;
+
+    auto makeKey(const sf::Texture* texture, sf::IntRect rect)
+    {
+        return std::make_tuple(texture, rect.left, rect.top, rect.width, rect.height);
+    }
+}
+
+struct TextureAtlas::Page final : public sf::GlResource
+{
+    sf::Texture texture;
+    stbrp_context context;
+    std::vector<stbrp_node> nodes;
+    std::uint32_t generation = 0;
+    std::size_t liveCount = 0;
+    std::uint64_t lastUsed = 0;
+
+    explicit Page(std::uint32_t size)
+        : nodes(size)
+    {
+        texture.create(size, size);
+        reset();
+    }
+
+    void reset()
+    {
+        stbrp_init_target(&context, static_cast<int>(nodes.size()), static_cast<int>(nodes.size()), nodes.data(), static_cast<int>(nodes.size()));
+        generation++;
+        liveCount = 0;
+        clear();
+    }
+
+    //new textures are uninitialised and released images are left
+    //behind, either of which would bleed into the padding of new
+    //images when the page is smoothed
+    void clear()
+    {
+        TransientContextLock lock;
+
+        if (GLAD_GL_ARB_framebuffer_object)
+        {
+            //framebuffers aren't shared between contexts, so one
+            //is created in whichever context is active
+            GLint previous = 0;
+            glCheck(glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous));
+
+            GLuint framebuffer = 0;
+            glCheck(glGenFramebuffers(1, &framebuffer));
+            glCheck(glBindFramebuffer(GL_FRAMEBUFFER, framebuffer));
+            glCheck(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture.getNativeHandle(), 0));
+
+            const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+            if (complete)
+            {
+                glCheck(glClearColor(0.f, 0.f, 0.f, 0.f));
+                glCheck(glClear(GL_COLOR_BUFFER_BIT));
+            }
+
+            glCheck(glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previous)));
+            glCheck(glDeleteFramebuffers(1, &framebuffer));
+
+            if (complete)
+            {
+                return;
+            }
+        }
+
+        //else upload a strip at a time rather than a page sized image
+        const auto size = texture.getSize();
+        const auto stripHeight = std::min(size.y, ClearStripHeight);
+        const std::vector<sf::Uint8> strip(size.x * stripHeight * 4, 0);
+        for (auto y = 0u; y < size.y; y += stripHeight)
+        {
+            texture.update(strip.data(), size.x, std::min(stripHeight, size.y - y), 0, y);
+        }
+    }
+};
+
+TextureAtlas::TextureAtlas(std::uint32_t pageSize, std::size_t maxPages)
+    : m_pageSize(std::min(pageSize, sf::Texture::getMaximumSize())),
+    m_maxPages  (std::max(std::size_t(1), maxPages)),
+    m_useCounter(0),
+    m_smooth    (false)
+{
+
+}
+
+TextureAtlas::~TextureAtlas() = default;
+
+//public
+TextureAtlas::Region TextureAtlas::addImage(const std::string& name, const sf::Image& image, sf::IntRect subRect)
+{
+    if (auto result = m_entries.find(name); result != m_entries.end())
+    {
+        return toRegion(result->second);
+    }
+
+    Region region;
+    pack(name, image, subRect, region);
+    return region;
+}
+
+TextureAtlas::Region TextureAtlas::addTexture(const std::string& name, const sf::Texture& texture)
+{
+    if (auto result = m_entries.find(name); result != m_entries.end())
+    {
+        return toRegion(result->second);
+    }
+
+    Region region;
+    if (pack(name, texture.copyToImage(), {}, region))
+    {
+        sf::IntRect rect(0, 0, texture.getSize().x, texture.getSize().y);
+        m_frames[makeKey(&texture, rect)] = name;
+    }
+    return region;
+}
+
+bool TextureAtlas::addSpriteSheet(const SpriteSheet& sheet)
+{
+    const auto& sprites = sheet.getSprites();
+    if (sprites.empty())
+    {
+        return false;
+    }
+
+    //the frames using each texture are packed as a single region, so
+    //that a sheet is never split across pages, and is evicted as a whole
+    std::map<const sf::Texture*, sf::IntRect> bounds;
+    const auto addBounds = [&bounds](const sf::Texture* texture, sf::IntRect frame)
+    {
+        if (auto result = bounds.find(texture); result != bounds.end())
+        {
+            auto& rect = result->second;
+            auto right = std::max(rect.left + rect.width, frame.left + frame.width);
+            auto bottom = std::max(rect.top + rect.height, frame.top + frame.height);
+            rect.left = std::min(rect.left, frame.left);
+            rect.top = std::min(rect.top, frame.top);
+            rect.width = right - rect.left;
+            rect.height = bottom - rect.top;
+        }
+        else
+        {
+            bounds.emplace(texture, frame);
+        }
+    };
+
+    for (const auto& [name, sprite] : sprites)
+    {
+        auto* texture = sprite.getTexture();
+        if (!texture)
+        {
+            continue;
+        }
+
+        addBounds(texture, sf::IntRect(sprite.getTextureRect()));
+        for (const auto& anim : sprite.getAnimations())
+        {
+            for (auto frame : anim.frames)
+            {
+                addBounds(texture, sf::IntRect(frame));
+            }
+        }
+    }
+
+    bool success = !bounds.empty();
+    for (const auto& [texture, rect] : bounds)
+    {
+        if (addFrame(texture, rect).empty())
+        {
+            success = false;
+        }
+    }
+
+    return success;
+}
+
+TextureAtlas::Region TextureAtlas::addGlyphPage(const std::string& name, const sf::Font& font, std::uint32_t charSize, const sf::String& characters)
+{
+    release(name);
+
+    //make sure the glyphs are rasterised before the page is read back
+    for (auto c : characters)
+    {
+        font.getGlyph(c, charSize, false);
+    }
+
+    const auto& texture = font.getTexture(charSize);
+    Region region;
+    pack(name, texture.copyToImage(), {}, region);
+    return region;
+}
+
+TextureAtlas::Region TextureAtlas::getRegion(const std::string& name)
+{
+    if (auto result = m_entries.find(name); result != m_entries.end())
+    {
+        return toRegion(result->second);
+    }
+    return {};
+}
+
+bool TextureAtlas::isValid(const Region& region) const
+{
+    return region.texture != nullptr
+        && region.page < m_pages.size()
+        && m_pages[region.page]->generation == region.generation;
+}
+
+bool TextureAtlas::remap(Sprite& sprite)
+{
+    auto* texture = sprite.getTexture();
+    if (!texture)
+    {
+        return false;
+    }
+
+    //looks for a packed area of the texture, such as the whole
+    //texture or the frames of a sprite sheet, containing the rect
+    constexpr auto Min = std::numeric_limits<std::int32_t>::min();
+    const auto first = m_frames.lower_bound(makeKey(texture, { Min, Min, 0, 0 }));
+    const auto findRect = [&](sf::FloatRect rect, sf::FloatRect& dst, std::size_t& page)
+    {
+        sf::IntRect frame(rect);
+        for (auto it = first; it != m_frames.end() && std::get<0>(it->first) == texture; ++it)
+        {
+            const auto& [tex, left, top, width, height] = it->first;
+            if (frame.left >= left && frame.top >= top
+                && frame.left + frame.width <= left + width
+                && frame.top + frame.height <= top + height)
+            {
+                const auto& entry = m_entries.at(it->second);
+                dst = rect;
+                dst.left += static_cast<float>(entry.rect.left - left);
+                dst.top += static_cast<float>(entry.rect.top - top);
+                page = entry.page;
+                return true;
+            }
+        }
+        return false;
+    };
+
+    //all frames must live on the same page else the
+    //texture would need swapping during animation
+    std::size_t page = 0;
+    sf::FloatRect textureRect;
+    if (!findRect(sprite.getTextureRect(), textureRect, page))
+    {
+        return false;
+    }
+
+    std::vector<Sprite::Animation> animations = sprite.getAnimations();
+    for (auto& anim : animations)
+    {
+        for (auto& frame : anim.frames)
+        {
+            std::size_t framePage = 0;
+            if (!findRect(frame, frame, framePage)
+                || framePage != page)
+            {
+                return false;
+            }
+        }
+    }
+
+    m_pages[page]->lastUsed = ++m_useCounter;
+    sprite.setTexture(m_pages[page]->texture, false);
+    sprite.setTextureRect(textureRect);
+    sprite.setAnimations(std::move(animations));
+
+    return true;
+}
+
+void TextureAtlas::releaseTexture(const sf::Texture& texture)
+{
+    //collect the names first as releasing them modifies the frames
+    std::vector<std::string> names;
+    constexpr auto Min = std::numeric_limits<std::int32_t>::min();
+    for (auto it = m_frames.lower_bound(makeKey(&texture, { Min, Min, 0, 0 }));
+        it != m_frames.end() && std::get<0>(it->first) == &texture; ++it)
+    {
+        names.push_back(it->second);
+    }
+
+    for (const auto& name : names)
+    {
+        release(name);
+    }
+}
+
+void TextureAtlas::release(const std::string& name)
+{
+    if (auto result = m_entries.find(name); result != m_entries.end())
+    {
+        auto pageIndex = result->second.page;
+        m_entries.erase(result);
+
+        for (auto it = m_frames.begin(); it != m_frames.end();)
+        {
+            if (it->second == name)
+            {
+                it = m_frames.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        auto& page = m_pages[pageIndex];
+        if (page->liveCount > 0
+            && --page->liveCount == 0)
+        {
+            page->reset();
+        }
+    }
+}
+
+const sf::Texture* TextureAtlas::getPageTexture(std::size_t page) const
+{
+    return page < m_pages.size() ? &m_pages[page]->texture : nullptr;
+}
+
+void TextureAtlas::setSmooth(bool smooth)
+{
+    m_smooth = smooth;
+    for (auto& page : m_pages)
+    {
+        page->texture.setSmooth(smooth);
+    }
+}
+
+//private
+bool TextureAtlas::pack(const std::string& name, const sf::Image& image, sf::IntRect subRect, Region& dst)
+{
+    if (subRect.width == 0 || subRect.height == 0)
+    {
+        subRect = { 0, 0, static_cast<std::int32_t>(image.getSize().x), static_cast<std::int32_t>(image.getSize().y) };
+    }
+
+    if (subRect.width + Padding > static_cast<std::int32_t>(m_pageSize)
+        || subRect.height + Padding > static_cast<std::int32_t>(m_pageSize))
+    {
+        Logger::log(name + ": image is larger than atlas page size", Logger::Type::Error);
+        return false;
+    }
+
+    stbrp_rect rect;
+    rect.id = 0;
+    rect.w = subRect.width + Padding;
+    rect.h = subRect.height + Padding;
+
+    const auto tryPack = [&](std::size_t i)
+    {
+        rect.was_packed = 0;
+        stbrp_pack_rects(&m_pages[i]->context, &rect, 1);
+        return rect.was_packed != 0;
+    };
+
+    std::size_t pageIndex = m_pages.size();
+    for (auto i = 0u; i < m_pages.size(); ++i)
+    {
+        if (tryPack(i))
+        {
+            pageIndex = i;
+            break;
+        }
+    }
+
+    if (pageIndex == m_pages.size())
+    {
+        if (m_pages.size() < m_maxPages)
+        {
+            m_pages.emplace_back(std::make_unique<Page>(m_pageSize));
+            m_pages.back()->texture.setSmooth(m_smooth);
+        }
+        else
+        {
+            //reuse the least recently used page
+            auto result = std::min_element(m_pages.begin(), m_pages.end(),
+                [](const std::unique_ptr<Page>& a, const std::unique_ptr<Page>& b)
+                {
+                    return a->lastUsed < b->lastUsed;
+                });
+            pageIndex = std::distance(m_pages.begin(), result);
+            evict(pageIndex);
+        }
+
+        if (!tryPack(pageIndex))
+        {
+            Logger::log(name + ": failed to pack image into atlas", Logger::Type::Error);
+            return false;
+        }
+    }
+
+    sf::Image subImage;
+    subImage.create(subRect.width, subRect.height, sf::Color::Transparent);
+    subImage.copy(image, 0, 0, subRect);
+
+    auto& page = m_pages[pageIndex];
+    page->texture.update(subImage, rect.x, rect.y);
+    page->liveCount++;
+    page->lastUsed = ++m_useCounter;
+
+    Entry entry;
+    entry.page = pageIndex;
+    entry.generation = page->generation;
+    entry.rect = { rect.x, rect.y, subRect.width, subRect.height };
+    m_entries[name] = entry;
+
+    dst = toRegion(entry);
+    return true;
+}
+
+void TextureAtlas::evict(std::size_t pageIndex)
+{
+    for (auto it = m_entries.begin(); it != m_entries.end();)
+    {
+        if (it->second.page == pageIndex)
+        {
+            const auto& name = it->first;
+            for (auto frame = m_frames.begin(); frame != m_frames.end();)
+            {
+                if (frame->second == name)
+                {
+                    frame = m_frames.erase(frame);
+                }
+                else
+                {
+                    ++frame;
+                }
+            }
+            it = m_entries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    m_pages[pageIndex]->reset();
+}
+
+TextureAtlas::Region TextureAtlas::toRegion(const Entry& entry)
+{
+    Region region;
+    auto& page = m_pages[entry.page];
+    if (page->generation == entry.generation)
+    {
+        page->lastUsed = ++m_useCounter;
+
+        region.texture = &page->texture;
+        region.textureRect = sf::FloatRect(entry.rect);
+        region.page = entry.page;
+        region.generation = entry.generation;
+    }
+    return region;
+}
+
+std::string TextureAtlas::addFrame(const sf::Texture* texture, sf::IntRect rect)
+{
+    auto key = makeKey(texture, rect);
+    if (auto result = m_frames.find(key); result != m_frames.end())
+    {
+        return result->second;
+    }
+
+    auto name = "__frame_" + std::to_string(reinterpret_cast<std::uintptr_t>(texture))
+        + "_" + std::to_string(rect.left) + "_" + std::to_string(rect.top)
+        + "_" + std::to_string(rect.width) + "_" + std::to_string(rect.height);
+
+    Region region;
+    if (!pack(name, texture->copyToImage(), rect, region))
+    {
+        return {};
+    }
+    m_frames[key] = name;
+    return name;
+}
@@ -38,6 +38,17 @@ namespace Default
         "    gl_TexCoord[0] = gl_TextureMatrix[0] * gl_MultiTexCoord0;\n" \
         "    gl_FrontColor = gl_Color;\n" \
         "}";
+
+    //full screen quad drawn as a triangle strip with no vertex attributes
+    static const std::string vertexCore =
+        "#version 330 core\n" \
+        "out vec2 v_texCoord;\n" \
+        "void main()\n" \
+        "{\n" \
+        "    vec2 position = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));\n" \
+        "    v_texCoord = position;\n" \
+        "    gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);\n" \
+        "}";
 }
 
 #endif //XY_SHADER_DEFAULT_HPP_
\ No newline at end of file
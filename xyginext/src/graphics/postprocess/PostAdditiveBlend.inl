@@ -39,6 +39,18 @@ namespace PostAdditiveBlend
         "{\n" \
         "    gl_FragColor = texture2D(u_sourceTexture, gl_TexCoord[0].xy) + texture2D(u_bloomTexture, gl_TexCoord[0].xy);\n" \
         "}";
+
+    static const std::string fragmentCore =
+        "#version 330 core\n" \
+        "uniform sampler2D u_sourceTexture;\n" \
+        "uniform sampler2D u_bloomTexture;\n" \
+        "in vec2 v_texCoord;\n" \
+        "out vec4 o_colour;\n" \
+
+        "void main()\n" \
+        "{\n" \
+        "    o_colour = texture(u_sourceTexture, v_texCoord) + texture(u_bloomTexture, v_texCoord);\n" \
+        "}";
 }
 
 #endif //XY_SHADER_POSTADDITIVE_HPP_
@@ -26,6 +26,9 @@ source distribution.
 *********************************************************************/
 
 #include "xyginext/graphics/postprocess/Bloom.hpp"
+#include "xyginext/core/App.hpp"
+
+#include <SFML/Graphics/RenderTexture.hpp>
 
 namespace
 {
@@ -49,50 +52,61 @@ using namespace xy;
 
 PostBloom::PostBloom()
 {
-    m_shaderResource.preload(Shader::AdditiveBlend, Default::vertex, PostAdditiveBlend::fragment);
-    m_shaderResource.preload(Shader::BrightnessExtract, Default::vertex, PostBrightness::fragment);
-    m_shaderResource.preload(Shader::DownSample, Default::vertex, PostDownSample::fragment);
-    m_shaderResource.preload(Shader::GaussianBlur, Default::vertex, PostGaussianBlur::fragment);
+    if (App::getRenderBackend() == App::RenderBackend::Core)
+    {
+        m_shaderResource.preload(Shader::AdditiveBlend, Default::vertexCore, PostAdditiveBlend::fragmentCore);
+        m_shaderResource.preload(Shader::BrightnessExtract, Default::vertexCore, PostBrightness::fragmentCore);
+        m_shaderResource.preload(Shader::DownSample, Default::vertexCore, PostDownSample::fragmentCore);
+        m_shaderResource.preload(Shader::GaussianBlur, Default::vertexCore, PostGaussianBlur::fragmentCore);
+        setCoreProfile(true);
+    }
+    else
+    {
+        m_shaderResource.preload(Shader::AdditiveBlend, Default::vertex, PostAdditiveBlend::fragment);
+        m_shaderResource.preload(Shader::BrightnessExtract, Default::vertex, PostBrightness::fragment);
+        m_shaderResource.preload(Shader::DownSample, Default::vertex, PostDownSample::fragment);
+        m_shaderResource.preload(Shader::GaussianBlur, Default::vertex, PostGaussianBlur::fragment);
+    }
 }
 
 //public
 void PostBloom::apply(const sf::RenderTexture& src, sf::RenderTarget& dest)
 {
-    initTextures(src.getSize());
+    const auto size = src.getSize();
 
-    filterBright(src, m_brightnessTexture);
+    auto& brightnessTexture = acquireTarget(size);
+    filterBright(src, brightnessTexture);
 
-    downSample(m_brightnessTexture, m_firstPassTextures[0]);
+    auto firstPassTextures = acquireTargets(size / 2u);
+    downSample(brightnessTexture, *firstPassTextures[0]);
+    releaseTarget(brightnessTexture);
 
-    blurMultipass(m_firstPassTextures);
+    blurMultipass(firstPassTextures);
 
-    downSample(m_firstPassTextures[0], m_secondPassTextures[0]);
+    auto secondPassTextures = acquireTargets(size / 4u);
+    downSample(*firstPassTextures[0], *secondPassTextures[0]);
 
-    blurMultipass(m_secondPassTextures);
+    blurMultipass(secondPassTextures);
 
-    add(m_firstPassTextures[0], m_secondPassTextures[0], m_firstPassTextures[1]);
-    m_firstPassTextures[1].display();
+    add(*firstPassTextures[0], *secondPassTextures[0], *firstPassTextures[1]);
+    firstPassTextures[1]->display();
+    releaseTargets(secondPassTextures);
 
-    add(src, m_firstPassTextures[1], dest);
+    add(src, *firstPassTextures[1], dest);
+    releaseTargets(firstPassTextures);
 }
 
 //private
-void PostBloom::initTextures(const sf::Vector2u& size)
+PostBloom::RenderTextureArray PostBloom::acquireTargets(sf::Vector2u size)
+{
+    return { &acquireTarget(size), &acquireTarget(size) };
+}
+
+void PostBloom::releaseTargets(const RenderTextureArray& textures)
 {
-    if (m_brightnessTexture.getSize() != size)
+    for (const auto* texture : textures)
     {
-        m_brightnessTexture.create(size.x, size.y);
-        m_brightnessTexture.setSmooth(true);
-
-        m_firstPassTextures[0].create(size.x / 2u, size.y / 2u);
-        m_firstPassTextures[0].setSmooth(true);
-        m_firstPassTextures[1].create(size.x / 2u, size.y / 2u);
-        m_firstPassTextures[1].setSmooth(true);
-
-        m_secondPassTextures[0].create(size.x / 4u, size.y / 4u);
-        m_secondPassTextures[0].setSmooth(true);
-        m_secondPassTextures[1].create(size.x / 4u, size.y / 4u);
-        m_secondPassTextures[1].setSmooth(true);
+        releaseTarget(*texture);
     }
 }
 
@@ -107,11 +121,11 @@ void PostBloom::filterBright(const sf::RenderTexture& src, sf::RenderTexture& ds
 
 void PostBloom::blurMultipass(RenderTextureArray& textures)
 {
-    auto textureSize = textures[0].getSize();
+    auto textureSize = textures[0]->getSize();
     for (auto i = 0u; i < 2; ++i)
     {
-        blur(textures[0], textures[1], { 0.f, 1.f / static_cast<float>(textureSize.y) });
-        blur(textures[1], textures[0], { 1.f / static_cast<float>(textureSize.x), 0.f });
+        blur(*textures[0], *textures[1], { 0.f, 1.f / static_cast<float>(textureSize.y) });
+        blur(*textures[1], *textures[0], { 1.f / static_cast<float>(textureSize.x), 0.f });
     }
 }
 
@@ -27,6 +27,7 @@ source distribution.
 
 #include "xyginext/graphics/postprocess/Blur.hpp"
 #include "xyginext/core/Assert.hpp"
+#include "xyginext/core/App.hpp"
 
 #include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Graphics/Sprite.hpp>
@@ -46,6 +47,20 @@ namespace
             gl_FragColor = texture2D(u_srcTexture, gl_TexCoord[0].xy);
         })";
 
+    const std::string fragShaderCore =
+        R"(
+        #version 330 core
+
+        uniform sampler2D u_srcTexture;
+
+        in vec2 v_texCoord;
+        out vec4 o_colour;
+
+        void main()
+        {
+            o_colour = texture(u_srcTexture, v_texCoord);
+        })";
+
 #include "DefaultVertex.inl"
 #include "PostGaussianBlur.inl"
 #include "PostDownSample.inl"
@@ -56,43 +71,65 @@ PostBlur::PostBlur()
     m_enabled   (false),
     m_fadeSpeed (5.f)
 {
-    m_blurShader.loadFromMemory(Default::vertex, PostGaussianBlur::fragment);
-    m_downsampleShader.loadFromMemory(Default::vertex, PostDownSample::fragment);
-    m_outShader.loadFromMemory(Default::vertex, fragShader);
-
-    initTextures(sf::Vector2u(DefaultSceneSize));
-}
-
-//public
-void PostBlur::apply(const sf::RenderTexture& src, sf::RenderTarget& dst)
-{
-    //fade in / out
-    if (m_enabled)
+    if (App::getRenderBackend() == App::RenderBackend::Core)
     {
-        m_amount = std::min(1.f, m_amount + (m_clock.restart().asSeconds() * m_fadeSpeed));
+        m_blurShader.loadFromMemory(Default::vertexCore, PostGaussianBlur::fragmentCore);
+        m_downsampleShader.loadFromMemory(Default::vertexCore, PostDownSample::fragmentCore);
+        m_outShader.loadFromMemory(Default::vertexCore, fragShaderCore);
+        setCoreProfile(true);
     }
     else
     {
-        m_amount = std::max(0.f, m_amount - (m_clock.restart().asSeconds() * m_fadeSpeed));
+        m_blurShader.loadFromMemory(Default::vertex, PostGaussianBlur::fragment);
+        m_downsampleShader.loadFromMemory(Default::vertex, PostDownSample::fragment);
+        m_outShader.loadFromMemory(Default::vertex, fragShader);
     }
+}
 
-
-    //and draw....
+//public
+void PostBlur::apply(const sf::RenderTexture& src, sf::RenderTarget& dst)
+{
     if (m_amount == 0)
     {
         m_outShader.setUniform("u_srcTexture", src.getTexture());
         applyShader(m_outShader, dst);
+        return;
+    }
+
+    //blur is performed at a fixed resolution so that
+    //the amount is the same regardless of the window size
+    const auto size = sf::Vector2u(DefaultSceneSize) / 2u;
+
+    auto firstPassTextures = acquireTargets(size);
+    downSample(src, *firstPassTextures[0]);
+    blurMultipass(firstPassTextures);
+
+    auto secondPassTextures = acquireTargets(size / 2u);
+    downSample(*firstPassTextures[0], *secondPassTextures[0]);
+    releaseTargets(firstPassTextures);
+
+    blurMultipass(secondPassTextures);
+    m_outShader.setUniform("u_srcTexture", secondPassTextures[0]->getTexture());
+    applyShader(m_outShader, dst);
+    releaseTargets(secondPassTextures);
+}
+
+void PostBlur::update(float dt)
+{
+    //fade in / out
+    if (m_enabled)
+    {
+        m_amount = std::min(1.f, m_amount + (dt * m_fadeSpeed));
     }
     else
     {
-        downSample(src, m_firstPassTextures[0]);
-        blurMultipass(m_firstPassTextures);
-        downSample(m_firstPassTextures[0], m_secondPassTextures[0]);
-        blurMultipass(m_secondPassTextures);
-        m_outShader.setUniform("u_srcTexture", m_secondPassTextures[0].getTexture());
-
+        m_amount = std::max(0.f, m_amount - (dt * m_fadeSpeed));
     }
-    applyShader(m_outShader, dst);
+}
+
+bool PostBlur::isBypassed() const
+{
+    return !m_enabled && m_amount == 0;
 }
 
 void PostBlur::setEnabled(bool enabled)
@@ -107,32 +144,26 @@ void PostBlur::setFadeSpeed(float speed)
 }
 
 //private
-void PostBlur::initTextures(sf::Vector2u size)
+PostBlur::TexturePair PostBlur::acquireTargets(sf::Vector2u size)
 {
-    size /= 2u;
-    if (m_firstPassTextures[0].getSize() != size)
-    {
-        m_firstPassTextures[0].create(size.x, size.y);
-        m_firstPassTextures[0].setSmooth(true);
-
-        m_firstPassTextures[1].create(size.x, size.y);
-        m_firstPassTextures[1].setSmooth(true);
-
-        m_secondPassTextures[0].create(size.x / 2, size.y / 2);
-        m_secondPassTextures[0].setSmooth(true);
+    return { &acquireTarget(size), &acquireTarget(size) };
+}
 
-        m_secondPassTextures[1].create(size.x / 2, size.y / 2);
-        m_secondPassTextures[1].setSmooth(true);
+void PostBlur::releaseTargets(const TexturePair& textures)
+{
+    for (const auto* texture : textures)
+    {
+        releaseTarget(*texture);
     }
 }
 
 void PostBlur::blurMultipass(TexturePair& textures)
 {
-    auto textureSize = textures[0].getSize();
+    auto textureSize = textures[0]->getSize();
     for (auto i = 0u; i < 2; ++i)
     {
-        blur(textures[0], textures[1], { 0.f, 1.f / static_cast<float>(textureSize.y) });
-        blur(textures[1], textures[0], { 1.f / static_cast<float>(textureSize.x), 0.f });
+        blur(*textures[0], *textures[1], { 0.f, 1.f / static_cast<float>(textureSize.y) });
+        blur(*textures[1], *textures[0], { 1.f / static_cast<float>(textureSize.x), 0.f });
     }
 }
 
@@ -43,6 +43,22 @@ namespace PostBrightness
         "    sourceColour *= clamp(luminance - threshold, 0.0 , 1.0) * factor;\n" \
         "    gl_FragColor = sourceColour;\n" \
         "}\n";
+
+    static const std::string fragmentCore =
+        "#version 330 core\n" \
+        "uniform sampler2D u_sourceTexture;\n" \
+        "const float threshold = 0.35;\n" \
+        "const float factor = 4.0;\n" \
+        "in vec2 v_texCoord;\n" \
+        "out vec4 o_colour;\n" \
+
+        "void main()\n" \
+        "{\n" \
+        "    vec4 sourceColour = texture(u_sourceTexture, v_texCoord);\n" \
+        "    float luminance = sourceColour.r * 0.2126 + sourceColour.g * 0.7152 + sourceColour.b * 0.0722;\n" \
+        "    sourceColour *= clamp(luminance - threshold, 0.0 , 1.0) * factor;\n" \
+        "    o_colour = sourceColour;\n" \
+        "}\n";
 }
 
 #endif //XY_SHADER_POSTBRIGHTNESS_HPP_
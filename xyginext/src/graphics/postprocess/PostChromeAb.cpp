@@ -63,7 +63,10 @@ PostChromeAb::PostChromeAb(bool distort)
 //public
 void PostChromeAb::apply(const sf::RenderTexture& src, sf::RenderTarget& dst)
 {
-    float windowRatio = static_cast<float>(dst.getSize().y) / static_cast<float>(src.getSize().y);
+    //relative to the output size when used by a Scene so that
+    //the scanlines don't change if the scene buffer is scaled
+    auto outputHeight = getBufferSize().y > 0 ? getBufferSize().y : static_cast<std::int32_t>(src.getSize().y);
+    float windowRatio = static_cast<float>(dst.getSize().y) / static_cast<float>(outputHeight);
 
     m_shader.setUniform("u_sourceTexture", src.getTexture());
     m_shader.setUniform("u_time", accumulatedTime * (10.f * windowRatio));
@@ -51,6 +51,29 @@ namespace PostDownSample
         "    colour += texture2D(u_sourceTexture, texCoords + vec2(-1.0, 1.0) * pixelSize);\n" \
         "    gl_FragColor = colour / 9.0;\n" \
         "}";
+
+    static const std::string fragmentCore =
+        "#version 330 core\n" \
+        "uniform sampler2D u_sourceTexture;\n" \
+        "uniform vec2 u_sourceSize;\n" \
+        "in vec2 v_texCoord;\n" \
+        "out vec4 o_colour;\n" \
+
+        "void main()\n" \
+        "{\n" \
+        "    vec2 pixelSize = 1.0 / u_sourceSize;\n" \
+        "    vec2 texCoords = v_texCoord;\n" \
+        "    vec4 colour = texture(u_sourceTexture, texCoords);\n" \
+        "    colour += texture(u_sourceTexture, texCoords + vec2(1.0, 0.0) * pixelSize);\n" \
+        "    colour += texture(u_sourceTexture, texCoords + vec2(-1.0, 0.0) * pixelSize);\n" \
+        "    colour += texture(u_sourceTexture, texCoords + vec2(0.0, 1.0) * pixelSize);\n" \
+        "    colour += texture(u_sourceTexture, texCoords + vec2(0.0, -1.0) * pixelSize);\n" \
+        "    colour += texture(u_sourceTexture, texCoords + vec2(1.0, 1.0) * pixelSize);\n" \
+        "    colour += texture(u_sourceTexture, texCoords + vec2(-1.0, -1.0) * pixelSize);\n" \
+        "    colour += texture(u_sourceTexture, texCoords + vec2(1.0, -1.0) * pixelSize);\n" \
+        "    colour += texture(u_sourceTexture, texCoords + vec2(-1.0, 1.0) * pixelSize);\n" \
+        "    o_colour = colour / 9.0;\n" \
+        "}";
 }
 
 #endif //XY_SHADER_POSTDOWNSAMPLE_HPP_
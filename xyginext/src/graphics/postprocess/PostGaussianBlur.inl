@@ -50,6 +50,29 @@ namespace PostGaussianBlur
         "    colour += texture2D(u_sourceTexture, texCoords + 4.0 * u_offset) * 0.0162162162;\n" \
         "    gl_FragColor = colour;\n" \
         "}";
+
+    static const std::string fragmentCore =
+        "#version 330 core\n" \
+        "uniform sampler2D u_sourceTexture;\n" \
+        "uniform vec2 u_offset;\n" \
+        "in vec2 v_texCoord;\n" \
+        "out vec4 o_colour;\n" \
+
+        "void main()\n" \
+        "{\n " \
+        "    vec2 texCoords = v_texCoord;\n" \
+        "    vec4 colour = vec4(0.0);\n" \
+        "    colour += texture(u_sourceTexture, texCoords - 4.0 * u_offset) * 0.0162162162;\n" \
+        "    colour += texture(u_sourceTexture, texCoords - 3.0 * u_offset) * 0.0540540541;\n" \
+        "    colour += texture(u_sourceTexture, texCoords - 2.0 * u_offset) * 0.1216216216;\n" \
+        "    colour += texture(u_sourceTexture, texCoords - u_offset) * 0.1945945946;\n" \
+        "    colour += texture(u_sourceTexture, texCoords) * 0.2270270270;\n" \
+        "    colour += texture(u_sourceTexture, texCoords + u_offset) * 0.1945945946;\n" \
+        "    colour += texture(u_sourceTexture, texCoords + 2.0 * u_offset) * 0.1216216216;\n" \
+        "    colour += texture(u_sourceTexture, texCoords + 3.0 * u_offset) * 0.0540540541;\n" \
+        "    colour += texture(u_sourceTexture, texCoords + 4.0 * u_offset) * 0.0162162162;\n" \
+        "    o_colour = colour;\n" \
+        "}";
 }
 
 #endif //XY_SHADER__HPP_
@@ -28,6 +28,8 @@ source distribution.
 #include "xyginext/graphics/postprocess/OldSchool.hpp"
 #include "xyginext/core/Log.hpp"
 
+#include <SFML/Graphics/RenderTexture.hpp>
+
 using namespace xy;
 
 namespace
@@ -54,18 +56,17 @@ PostOldSchool::PostOldSchool()
     {
         xy::Logger::log("Failed creating shader for Old School Post Process", xy::Logger::Type::Error, xy::Logger::Output::All);
     }
-
-    sf::Vector2u size(xy::DefaultSceneSize / divisor);
-    m_buffer.create(size.x, size.y);
-    m_passThroughShader.setUniform("u_texture", m_buffer.getTexture());
 }
 
 void PostOldSchool::apply(const sf::RenderTexture& src, sf::RenderTarget& dst)
 {
     m_fxShader.setUniform("u_sourceTexture", src.getTexture());
-    
-    applyShader(m_fxShader, m_buffer);
-    m_buffer.display();
 
+    auto& buffer = acquireTarget(sf::Vector2u(xy::DefaultSceneSize / divisor), false);
+    applyShader(m_fxShader, buffer);
+    buffer.display();
+
+    m_passThroughShader.setUniform("u_texture", buffer.getTexture());
     applyShader(m_passThroughShader, dst);
+    releaseTarget(buffer);
 }
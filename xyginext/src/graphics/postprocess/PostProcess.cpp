@@ -26,11 +26,18 @@ source distribution.
 *********************************************************************/
 
 #include "xyginext/graphics/postprocess/PostProcess.hpp"
+#include "xyginext/graphics/postprocess/RenderTargetPool.hpp"
+#include "xyginext/graphics/RenderStats.hpp"
+
+#include "../../detail/CoreProfile.hpp"
+#include "../../detail/GLStateCache.hpp"
 
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Graphics/Shader.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 
+#include <algorithm>
 #include <vector>
 
 using namespace xy;
@@ -50,9 +57,60 @@ namespace
     }
 }
 
+PostProcess::PostProcess()
+    : m_coreProfile     (false),
+    m_resolutionScale   (1.f),
+    m_targetPool        (nullptr)
+{
+
+}
+
+PostProcess::~PostProcess() = default;
+
+//public
+void PostProcess::setResolutionScale(float scale)
+{
+    m_resolutionScale = std::max(0.1f, std::min(1.f, scale));
+}
+
 //protected
+sf::RenderTexture& PostProcess::acquireTarget(sf::Vector2u size, bool smooth)
+{
+    if (!m_targetPool)
+    {
+        if (!m_ownTargetPool)
+        {
+            m_ownTargetPool = std::make_unique<RenderTargetPool>();
+        }
+        m_targetPool = m_ownTargetPool.get();
+    }
+
+    size.x = static_cast<std::uint32_t>(static_cast<float>(size.x) * m_resolutionScale);
+    size.y = static_cast<std::uint32_t>(static_cast<float>(size.y) * m_resolutionScale);
+
+    //the target may have last been used by another effect, and
+    //the full screen quads are alpha blended with its contents
+    auto& target = m_targetPool->acquire(size, smooth);
+    target.clear(sf::Color::Transparent);
+    return target;
+}
+
+void PostProcess::releaseTarget(const sf::RenderTexture& target)
+{
+    if (m_targetPool)
+    {
+        m_targetPool->release(target);
+    }
+}
+
 void PostProcess::applyShader(const sf::Shader& shader, sf::RenderTarget& dest)
 {
+    if (m_coreProfile)
+    {
+        applyCoreShader(shader, dest);
+        return;
+    }
+
     auto size = dest.getSize();
     if (lastSize != size)
     {
@@ -67,6 +125,46 @@ void PostProcess::applyShader(const sf::Shader& shader, sf::RenderTarget& dest)
     //states.blendMode = sf::BlendNone;
 
     dest.draw(vertexArray.data(), vertexArray.size(), sf::Quads, states);
+    RenderStats::addDrawCall(static_cast<std::uint32_t>(vertexArray.size()));
+}
+
+//private
+void PostProcess::applyCoreShader(const sf::Shader& shader, sf::RenderTarget& dest)
+{
+    if (!dest.setActive(true))
+    {
+        return;
+    }
+
+    if (!m_vertexArray)
+    {
+        m_vertexArray = std::make_unique<Detail::VertexArray>();
+    }
+
+    auto& stateCache = Detail::GLStateCache::get();
+    stateCache.invalidate();
+    stateCache.setEnabled(GL_DEPTH_TEST, false);
+    stateCache.setEnabled(GL_CULL_FACE, false);
+    stateCache.setEnabled(GL_SCISSOR_TEST, false);
+    stateCache.setEnabled(GL_BLEND, true);
+
+    //matches the default states used by the legacy path
+    stateCache.setBlendMode(sf::BlendAlpha);
+
+    auto size = dest.getSize();
+    glCheck(glViewport(0, 0, static_cast<GLsizei>(size.x), static_cast<GLsizei>(size.y)));
+
+    //binding with SFML also binds any textures set as uniforms
+    stateCache.bindShader(&shader);
+
+    //the quad is generated from gl_VertexID so there are no attributes to set up
+    m_vertexArray->bind([]() {});
+    glCheck(glDrawArrays(GL_TRIANGLE_STRIP, 0, 4));
+    RenderStats::addDrawCall(4);
+    Detail::VertexArray::unbind();
+
+    stateCache.bindShader(nullptr);
+    dest.resetGLStates();
 }
 
 void PostProcess::resizeBuffer(std::int32_t w, std::int32_t h)
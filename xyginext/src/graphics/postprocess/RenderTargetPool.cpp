@@ -0,0 +1,126 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2021
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include "xyginext/graphics/postprocess/RenderTargetPool.hpp"
+#include "xyginext/core/Log.hpp"
+
+#include <SFML/Graphics/RenderTexture.hpp>
+
+#include <algorithm>
+
+using namespace xy;
+
+namespace
+{
+    //long enough that toggling an effect doesn't cause
+    //its buffers to be recreated every time
+    constexpr std::uint32_t MaxUnusedFrames = 120;
+}
+
+RenderTargetPool::~RenderTargetPool() = default;
+
+//public
+sf::RenderTexture& RenderTargetPool::acquire(sf::Vector2u size, bool smooth)
+{
+    size.x = std::max(1u, size.x);
+    size.y = std::max(1u, size.y);
+
+    auto result = std::find_if(m_targets.begin(), m_targets.end(),
+        [size, smooth](const Target& t)
+        {
+            return !t.inUse && t.size == size && t.smooth == smooth;
+        });
+
+    if (result == m_targets.end())
+    {
+        auto& target = m_targets.emplace_back();
+        target.texture = std::make_unique<sf::RenderTexture>();
+        if (!target.texture->create(size.x, size.y))
+        {
+            Logger::log("Failed creating pooled render target", Logger::Type::Error);
+        }
+        target.texture->setSmooth(smooth);
+        target.size = size;
+        target.smooth = smooth;
+
+        result = std::prev(m_targets.end());
+    }
+
+    result->inUse = true;
+    result->unusedFrames = 0;
+    return *result->texture;
+}
+
+void RenderTargetPool::release(const sf::RenderTexture& texture)
+{
+    auto result = std::find_if(m_targets.begin(), m_targets.end(),
+        [&texture](const Target& t)
+        {
+            return t.texture.get() == &texture;
+        });
+
+    if (result != m_targets.end())
+    {
+        result->inUse = false;
+    }
+}
+
+void RenderTargetPool::endFrame()
+{
+    for (auto& target : m_targets)
+    {
+        if (!target.inUse)
+        {
+            target.unusedFrames++;
+        }
+    }
+
+    m_targets.erase(std::remove_if(m_targets.begin(), m_targets.end(),
+        [](const Target& t)
+        {
+            return t.unusedFrames > MaxUnusedFrames;
+        }), m_targets.end());
+}
+
+void RenderTargetPool::clear()
+{
+    m_targets.erase(std::remove_if(m_targets.begin(), m_targets.end(),
+        [](const Target& t)
+        {
+            return !t.inUse;
+        }), m_targets.end());
+}
+
+std::size_t RenderTargetPool::getMemoryUsage() const
+{
+    std::size_t total = 0;
+    for (const auto& target : m_targets)
+    {
+        total += target.size.x * target.size.y * 4;
+    }
+    return total;
+}
@@ -391,6 +391,12 @@ void Render(sf::RenderTarget& target)
     RenderDrawLists(ImGui::GetDrawData());
 }
 
+void RenderDrawData(sf::RenderTarget& target)
+{
+    target.resetGLStates();
+    RenderDrawLists(ImGui::GetDrawData());
+}
+
 void Shutdown()
 {
     ImGui::GetIO().Fonts->TexID = NULL;
@@ -28,6 +28,7 @@ source distribution.
 //creates a default font in memory to return when requested font unavailable//
 #include "xyginext/resources/Resource.hpp"
 #include "xyginext/resources/SystemFont.hpp"
+#include "xyginext/ecs/components/Text.hpp"
 
 using namespace xy;
 
@@ -57,6 +58,15 @@ FontResource::FontResource()
     }
 }
 
+FontResource::~FontResource()
+{
+    //so that new fonts at the same addresses aren't given the cached glyphs
+    for (const auto& [path, font] : getResources())
+    {
+        Text::releaseFont(*font);
+    }
+}
+
 std::unique_ptr<sf::Font> FontResource::errorHandle()
 {
 	return std::make_unique<sf::Font>(m_font);
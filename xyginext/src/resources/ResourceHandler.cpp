@@ -32,6 +32,7 @@ source distribution.
 #include "xyginext/resources/ResourceHandler.hpp"
 #include "xyginext/resources/SystemFont.hpp"
 #include "xyginext/graphics/BitmapFont.hpp"
+#include "xyginext/ecs/components/Text.hpp"
 
 #include <cstring>
 
@@ -143,3 +144,15 @@ ResourceHandler::ResourceHandler()
     getLoader<sf::SoundBuffer>() = soundLoader;
     getLoader<xy::BitmapFont>() = bmfLoader;
 }
+
+ResourceHandler::~ResourceHandler()
+{
+    //so that new fonts at the same addresses aren't given the cached glyphs
+    for (auto& resource : m_resources)
+    {
+        if (auto* font = std::any_cast<sf::Font>(&resource); font != nullptr)
+        {
+            Text::releaseFont(*font);
+        }
+    }
+}